@@ -46,7 +46,7 @@ GIGA_error addition_benchmark(GIGA_data_type GT, int nb_runs, uint8_t a_shift =
     GIGA_allocate_t a_params;
     a_params.memory_zone_id = 0;
     a_params.offset = offset;
-    offset += tensor_size_in_bytes(&a);
+    offset += align_address(tensor_size_in_bytes(&a), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&a, &a_params)) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor a" << std::endl;
@@ -65,7 +65,7 @@ GIGA_error addition_benchmark(GIGA_data_type GT, int nb_runs, uint8_t a_shift =
     GIGA_allocate_t b_params;
     b_params.memory_zone_id = 0;
     b_params.offset = offset;
-    offset += tensor_size_in_bytes(&b);
+    offset += align_address(tensor_size_in_bytes(&b), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&b, &b_params) ) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor b" << std::endl;
@@ -83,7 +83,7 @@ GIGA_error addition_benchmark(GIGA_data_type GT, int nb_runs, uint8_t a_shift =
     GIGA_allocate_t out_params;
     out_params.memory_zone_id = 0;
     out_params.offset = offset;
-    offset += tensor_size_in_bytes(&out);
+    offset += align_address(tensor_size_in_bytes(&out), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&out, &out_params) ) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor out" << std::endl;
@@ -8,7 +8,7 @@
 #include <cstring>
 
 
-GIGA_error conv2d_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type k_GT, int nb_runs, uint8_t in_shift = 0, uint8_t ker_shift = 0, uint8_t out_shift = 0)
+GIGA_error conv2d_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type k_GT, int nb_runs, uint8_t in_shift = 0, uint8_t ker_shift = 0, uint8_t out_shift = 0, uint32_t upsampling = 1, uint32_t stride = 1, bool b_separable = false)
 {
     ScopedMessage on_error_message(std::string("Error on ")
                                    + "Conv2d, in " + giga_data_type_str(i_GT)
@@ -16,14 +16,20 @@ GIGA_error conv2d_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_
                                    + ", params " + giga_data_type_str(k_GT)
                                    + ", in_shift " + std::to_string(int(in_shift))
                                    + ", ker_shift " + std::to_string(int(ker_shift))
-                                   + ", out_shift " + std::to_string(int(out_shift)));
+                                   + ", out_shift " + std::to_string(int(out_shift))
+                                   + ", upsampling " + std::to_string(upsampling)
+                                   + ", stride " + std::to_string(stride)
+                                   + (b_separable ? ", separable kernels" : ""));
 
     std::cout << "Conv2d, in " << giga_data_type_str(i_GT)
               << ", out " << giga_data_type_str(o_GT)
               << ", params " << giga_data_type_str(k_GT)
               << ", in_shift " << int(in_shift)
               << ", ker_shift " << int(ker_shift)
-              << ", out_shift " << int(out_shift) << " : " << std::flush;
+              << ", out_shift " << int(out_shift)
+              << ", upsampling " << upsampling
+              << ", stride " << stride
+              << (b_separable ? ", separable kernels" : "") << " : " << std::flush;
 
     GIGA_error err;
     uint32_t device_id = giga_get_default_device_id(&err);
@@ -50,8 +56,9 @@ GIGA_error conv2d_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_
     in.nb_dims = 4;
     in.dims[0] = 1;
     in.dims[1] = 2;
-    in.dims[2] = 1024;
-    in.dims[3] = 1024;
+    // The output is always 1024x1024
+    in.dims[2] = 1024 * stride / upsampling;
+    in.dims[3] = 1024 * stride / upsampling;
     in.device_id = device_id;
     in.type = i_GT;
     in.fp_shift = in_shift;
@@ -59,7 +66,7 @@ GIGA_error conv2d_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_
     GIGA_allocate_t in_params;
     in_params.memory_zone_id = 0;
     in_params.offset = offset;
-    offset += tensor_size_in_bytes(&in);
+    offset += align_address(tensor_size_in_bytes(&in), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&in, &in_params);
     if(err != GIGA_Success)
     {
@@ -71,6 +78,8 @@ GIGA_error conv2d_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_
 
     /*output tensor*/
     GIGA_tensor_t out = in;
+    out.dims[2] = 1024;
+    out.dims[3] = 1024;
     out.device_id = device_id;
     out.type = o_GT;
     out.data = NULL;
@@ -79,7 +88,7 @@ GIGA_error conv2d_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_
     GIGA_allocate_t out_params;
     out_params.memory_zone_id = 0;
     out_params.offset = offset;
-    offset += tensor_size_in_bytes(&out);
+    offset += align_address(tensor_size_in_bytes(&out), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&out, &out_params);
     if(err != GIGA_Success)
     {
@@ -102,7 +111,7 @@ GIGA_error conv2d_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_
     GIGA_allocate_t kernel_params;
     kernel_params.memory_zone_id = 0;
     kernel_params.offset = offset;
-    offset += tensor_size_in_bytes(&kernel);
+    offset += align_address(tensor_size_in_bytes(&kernel), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&kernel, &kernel_params);
     if(err != GIGA_Success)
     {
@@ -110,7 +119,17 @@ GIGA_error conv2d_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_
         return err;
     }
 
-    fill_contiguous_tensor_with_random_data(kernel, -1.f, 1.f);
+    if(b_separable)
+    {
+        // Sobel filters along x and y, the kind of rank 1 kernels used by classical image processing
+        const float sobel[2 * 2 * 3 * 3] = {-1.f, 0.f, 1.f, -2.f, 0.f, 2.f, -1.f, 0.f, 1.f,
+                                            0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                            0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                            -1.f, -2.f, -1.f, 0.f, 0.f, 0.f, 1.f, 2.f, 1.f};
+        fill_4d_tensor(sobel, kernel);
+    }
+    else
+        fill_contiguous_tensor_with_random_data(kernel, -1.f, 1.f);
 
     /* bias */
     GIGA_tensor_t bias;
@@ -124,7 +143,7 @@ GIGA_error conv2d_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_
     GIGA_allocate_t bias_params;
     bias_params.memory_zone_id = 0;
     bias_params.offset = offset;
-    offset += tensor_size_in_bytes(&bias);
+    offset += align_address(tensor_size_in_bytes(&bias), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&bias, &bias_params);
     if(err != GIGA_Success)
     {
@@ -142,8 +161,9 @@ GIGA_error conv2d_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_
     conv_params.padding[1][1] = 1;
     conv_params.dilation[0] = 1;
     conv_params.dilation[1] = 1;
-    conv_params.stride[0] = 1;
-    conv_params.stride[1] = 1;
+    conv_params.upsampling = upsampling;
+    conv_params.stride[0] = stride;
+    conv_params.stride[1] = stride;
     conv_params.bias = &bias;
     conv_params.b_ReLU = false;
 
@@ -244,6 +264,28 @@ int main()
             EARLY_ABORT();
         if((error = conv2d_benchmark(GIGA_UFixed16, GIGA_SFixed8, GIGA_SFixed16, nb_runs, 4, 4, 4)) != GIGA_Success)
             EARLY_ABORT();
+
+        // Convolution of a x2 nearest neighbour upsampled input
+        if((error = conv2d_benchmark(GIGA_Float32, GIGA_Float32, GIGA_Float32, nb_runs, 0, 0, 0, 2)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = conv2d_benchmark(GIGA_SFixed8, GIGA_SFixed8, GIGA_SFixed8, nb_runs, 4, 4, 4, 2)) != GIGA_Success)
+            EARLY_ABORT();
+
+        // Stride 2 convolution of a 2048x2048 input
+        if((error = conv2d_benchmark(GIGA_Float32, GIGA_Float32, GIGA_Float32, nb_runs, 0, 0, 0, 1, 2)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = conv2d_benchmark(GIGA_Float16, GIGA_Float16, GIGA_Float16, nb_runs, 0, 0, 0, 1, 2)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = conv2d_benchmark(GIGA_SFixed8, GIGA_SFixed8, GIGA_SFixed8, nb_runs, 4, 4, 4, 1, 2)) != GIGA_Success)
+            EARLY_ABORT();
+
+        // Separable (rank 1) kernels
+        if((error = conv2d_benchmark(GIGA_Float32, GIGA_Float32, GIGA_Float32, nb_runs, 0, 0, 0, 1, 1, true)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = conv2d_benchmark(GIGA_Float16, GIGA_Float16, GIGA_Float16, nb_runs, 0, 0, 0, 1, 1, true)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = conv2d_benchmark(GIGA_SFixed8, GIGA_SFixed8, GIGA_SFixed8, nb_runs, 4, 4, 4, 1, 1, true)) != GIGA_Success)
+            EARLY_ABORT();
     }
     catch(const std::exception &e)
     {
@@ -0,0 +1,177 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \date 17/01/2025
+ */
+#include <giga/giga.h>
+#include "../tests/utils.h"
+
+#include <cstring>
+
+
+GIGA_error conv2d_transpose_benchmark(GIGA_data_type GT, int nb_runs, uint32_t kernel_size, uint8_t in_shift = 0, uint8_t ker_shift = 0, uint8_t out_shift = 0)
+{
+    ScopedMessage on_error_message(std::string("Error on ")
+                                   + "Conv2d transpose, " + giga_data_type_str(GT)
+                                   + ", kernel " + std::to_string(kernel_size)
+                                   + ", in_shift " + std::to_string(int(in_shift))
+                                   + ", ker_shift " + std::to_string(int(ker_shift))
+                                   + ", out_shift " + std::to_string(int(out_shift)));
+
+    std::cout << "Conv2d transpose, " << giga_data_type_str(GT)
+              << ", kernel " << kernel_size
+              << ", in_shift " << int(in_shift)
+              << ", ker_shift " << int(ker_shift)
+              << ", out_shift " << int(out_shift) << " : " << std::flush;
+
+    GIGA_error err;
+    uint32_t device_id = giga_get_default_device_id(&err);
+
+    if(err != GIGA_Success)
+    {
+        std::cerr << "Error getting default device id" << std::endl;
+        return err;
+    }
+
+    err = giga_initialize_device(device_id);
+    if(err != GIGA_Success)
+    {
+        std::cerr << "Error initializing device" << std::endl;
+        return err;
+    }
+
+    // The output is always 1024x1024: the full output (2 * 512 - 2 + kernel_size) is cropped by the padding
+    const int32_t padding_begin = (kernel_size - 1) / 2;
+    const int32_t padding_end = kernel_size - 2 - padding_begin;
+
+    // in, kernel, bias, out
+    const std::vector<uint32_t> dims[4] = {{1, 2, 512, 512}, {2, 2, kernel_size, kernel_size}, {2}, {1, 2, 1024, 1024}};
+    const uint8_t shifts[4] = {in_shift, ker_shift, ker_shift, out_shift};
+    GIGA_tensor_t tensors[4];
+    size_t offset = 0;
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = dims[i].size();
+        for(uint32_t d = 0; d < tensor.nb_dims; ++d)
+            tensor.dims[d] = dims[i][d];
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = shifts[i];
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((err = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return err;
+        }
+    }
+    GIGA_tensor_t &in = tensors[0];
+    GIGA_tensor_t &kernel = tensors[1];
+    GIGA_tensor_t &bias = tensors[2];
+    GIGA_tensor_t &out = tensors[3];
+
+    fill_contiguous_tensor_with_random_data(in, 0, 1);
+    fill_contiguous_tensor_with_random_data(kernel, -1.f, 1.f);
+    fill_contiguous_tensor_with_random_data(bias, 0.f, 1.f);
+
+    GIGA_conv2d_transpose_t conv_params;
+    conv_params.kernel = &kernel;
+    conv_params.padding[0][0] = padding_begin;
+    conv_params.padding[0][1] = padding_end;
+    conv_params.padding[1][0] = padding_begin;
+    conv_params.padding[1][1] = padding_end;
+    conv_params.stride[0] = 2;
+    conv_params.stride[1] = 2;
+    conv_params.bias = &bias;
+    conv_params.b_ReLU = false;
+
+    /*Transposed convolution*/
+    const size_t start = usec_timer();
+    for(int it = 0 ; it < nb_runs ; ++it)
+    {
+        err = giga_conv2d_transpose(&conv_params, &in, &out);
+        if(err != GIGA_Success)
+        {
+            if (err == GIGA_Unimplemented_Type)
+            {
+                std::cout << "Type not implemented" << std::endl;
+                on_error_message.clear();
+                return GIGA_Success;
+            }
+            if (err == GIGA_Not_Implemented)
+            {
+                std::cout << "Function not implemented" << std::endl;
+                on_error_message.clear();
+                return GIGA_Success;
+            }
+            std::cerr << "Error performing giga_conv2d_transpose" << std::endl;
+            return err;
+        }
+    }
+    if ((err = giga_flush(device_id)) != GIGA_Success)
+    {
+        std::cerr << "Error flushing device" << std::endl;
+        return err;
+    }
+    if ((err = giga_wait_for_completion()) != GIGA_Success)
+    {
+        std::cerr << "Error waiting for completion" << std::endl;
+        return err;
+    }
+    const size_t end = usec_timer();
+    std::cout << (end - start) / nb_runs << "µs per call" << std::endl;
+
+    //Clean up
+    for(GIGA_tensor_t &t : tensors)
+    {
+        if((err = giga_release_tensor(&t)) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return err;
+        }
+    }
+
+    on_error_message.clear();
+
+    return GIGA_Success;
+}
+
+int main()
+{
+    GIGA_error error = GIGA_Success;
+
+    const int nb_runs = 10;
+
+#define EARLY_ABORT() throw std::runtime_error("Error")
+
+    try
+    {
+        for(uint32_t kernel_size : {2, 3, 4})
+        {
+            if((error = conv2d_transpose_benchmark(GIGA_Float32, nb_runs, kernel_size)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = conv2d_transpose_benchmark(GIGA_Float16, nb_runs, kernel_size)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = conv2d_transpose_benchmark(GIGA_SFixed8, nb_runs, kernel_size, 4, 4, 4)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = conv2d_transpose_benchmark(GIGA_SFixed16, nb_runs, kernel_size, 4, 4, 4)) != GIGA_Success)
+                EARLY_ABORT();
+        }
+    }
+    catch(const std::exception &e)
+    {
+        if (error != GIGA_Success)
+            std::cerr << "Error: " << giga_str_error(error) << std::endl;
+        else
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            error = GIGA_Unknown_Error;
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,159 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \date 17/01/2025
+ */
+#include <giga/giga.h>
+#include "../tests/utils.h"
+
+GIGA_error copy_benchmark(GIGA_data_type GT, const int nb_runs, bool b_from_tensor)
+{
+    const uint32_t C = 12;
+    const uint32_t H = 1024;
+    const uint32_t W = 1024;
+
+    ScopedMessage on_error_message(std::string("Error on ")
+                                   + "Copy " + (b_from_tensor ? "from " : "to ") + giga_data_type_str(GT));
+    std::cout << "Copy " << W << "x" << H << "x" << C << (b_from_tensor ? " from " : " Float32 to ") << giga_data_type_str(GT)
+              << (b_from_tensor ? " to Float32" : "") << " : " << std::flush;
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error getting default device id" << std::endl;
+        return error;
+    }
+
+    error = giga_initialize_device(device_id);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error initializing device" << std::endl;
+        return error;
+    }
+
+    GIGA_tensor_t tensor;
+    tensor.nb_dims = 3;
+    tensor.dims[0] = C;
+    tensor.dims[1] = H;
+    tensor.dims[2] = W;
+    tensor.device_id = device_id;
+    tensor.type = GT;
+    tensor.data = NULL;
+    tensor.fp_shift = GT == GIGA_SFixed8 ? 5 : (GT == GIGA_SFixed16 ? 10 : 0);
+
+    GIGA_allocate_t tensor_params;
+    tensor_params.memory_zone_id = 0;
+    tensor_params.offset = 0;
+    error = giga_allocate_tensor(&tensor, &tensor_params);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor" << std::endl;
+        return error;
+    }
+
+    std::vector<float> data(size_t(C) * H * W);
+    for(size_t i = 0; i < data.size(); ++i)
+        data[i] = float(int(i * 37 % 255) - 127) / 32.f;
+    if((error = giga_copy_to_tensor(data.data(), GIGA_Float32, 0, &tensor)) != GIGA_Success)
+    {
+        std::cerr << "Error performing giga_copy_to_tensor" << std::endl;
+        return error;
+    }
+
+    const size_t start = usec_timer();
+    for(int it = 0 ; it < nb_runs ; ++it)
+    {
+        if(b_from_tensor)
+            error = giga_copy_from_tensor(data.data(), GIGA_Float32, 0, &tensor);
+        else
+            error = giga_copy_to_tensor(data.data(), GIGA_Float32, 0, &tensor);
+        if(error != GIGA_Success)
+        {
+            if (error == GIGA_Unimplemented_Type)
+            {
+                std::cout << "Type not implemented" << std::endl;
+                on_error_message.clear();
+                return GIGA_Success;
+            }
+            std::cerr << "Error performing " << (b_from_tensor ? "giga_copy_from_tensor" : "giga_copy_to_tensor") << std::endl;
+            return error;
+        }
+    }
+    if ((error = giga_flush(device_id)) != GIGA_Success)
+    {
+        std::cerr << "Error flushing device" << std::endl;
+        return error;
+    }
+    if ((error = giga_wait_for_completion()) != GIGA_Success)
+    {
+        std::cerr << "Error waiting for completion" << std::endl;
+        return error;
+    }
+    const size_t end = usec_timer();
+    std::cout << double(end - start) / nb_runs << "µs per call" << std::endl;
+
+    error = giga_release_tensor(&tensor);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error releasing tensor" << std::endl;
+        return error;
+    }
+
+    on_error_message.clear();
+
+    return GIGA_Success;
+}
+
+//Host side conversions of a frame of the same size, as done when pre or post processing Float16 tensors
+void host_conversion_benchmark(const int nb_runs)
+{
+    const size_t size = size_t(12) * 1024 * 1024;
+    std::vector<float> data(size);
+    std::vector<half> halves(size);
+    for(size_t i = 0; i < size; ++i)
+        data[i] = float(int(i * 37 % 255) - 127) / 32.f;
+
+    size_t start = usec_timer();
+    for(int it = 0 ; it < nb_runs ; ++it)
+        giga_half_from_float_n(halves.data(), data.data(), size);
+    std::cout << "Host giga_half_from_float_n : " << double(usec_timer() - start) / nb_runs << "µs per call" << std::endl;
+
+    start = usec_timer();
+    for(int it = 0 ; it < nb_runs ; ++it)
+        giga_float_from_half_n(data.data(), halves.data(), size);
+    std::cout << "Host giga_float_from_half_n : " << double(usec_timer() - start) / nb_runs << "µs per call" << std::endl;
+}
+
+int main()
+{
+    GIGA_error error = GIGA_Success;
+
+    const int nb_runs = 10;
+
+#define EARLY_ABORT() throw std::runtime_error("Error")
+
+    try
+    {
+        for(GIGA_data_type GT : {GIGA_Float16, GIGA_SFixed16, GIGA_SFixed8})
+        {
+            if((error = copy_benchmark(GT, nb_runs, false)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = copy_benchmark(GT, nb_runs, true)) != GIGA_Success)
+                EARLY_ABORT();
+        }
+        host_conversion_benchmark(nb_runs);
+    }
+    catch(const std::exception &e)
+    {
+        if (error != GIGA_Success)
+            std::cerr << "Error: " << giga_str_error(error) << std::endl;
+        else
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            error = GIGA_Unknown_Error;
+        }
+    }
+
+    return error;
+}
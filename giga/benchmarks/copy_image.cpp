@@ -0,0 +1,151 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \date 17/01/2025
+ */
+#include <giga/giga.h>
+#include "../tests/utils.h"
+
+GIGA_error copy_image_benchmark(GIGA_data_type GT, const int nb_runs, bool b_plain_copy = false)
+{
+    const uint32_t C = 3;
+    const uint32_t H = 1080;
+    const uint32_t W = 1920;
+
+    ScopedMessage on_error_message(std::string("Error on ")
+                                   + "Copy image " + giga_data_type_str(GT) + (b_plain_copy ? " plain copy" : ""));
+    std::cout << "Copy image " << W << "x" << H << "x" << C << " to " << giga_data_type_str(GT)
+              << (b_plain_copy ? ", plain copy of converted data" : ", normalized") << " : " << std::flush;
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error getting default device id" << std::endl;
+        return error;
+    }
+
+    error = giga_initialize_device(device_id);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error initializing device" << std::endl;
+        return error;
+    }
+
+    GIGA_tensor_t tensor;
+    tensor.nb_dims = 4;
+    tensor.dims[0] = 1;
+    tensor.dims[1] = C;
+    tensor.dims[2] = H;
+    tensor.dims[3] = W;
+    tensor.device_id = device_id;
+    tensor.type = GT;
+    tensor.data = NULL;
+    tensor.fp_shift = GT == GIGA_SFixed8 ? 5 : 0;
+
+    GIGA_allocate_t tensor_params;
+    tensor_params.memory_zone_id = 0;
+    tensor_params.offset = 0;
+    error = giga_allocate_tensor(&tensor, &tensor_params);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor" << std::endl;
+        return error;
+    }
+
+    std::vector<uint8_t> image_data(H * W * C);
+    for(size_t i = 0; i < image_data.size(); ++i)
+        image_data[i] = uint8_t(i * 37);
+    // A plain copy moves data already converted to the tensor type on the host
+    std::vector<uint8_t> converted_data(tensor_size_in_bytes(&tensor));
+
+    const float mean[C] = {123.675f, 116.28f, 103.53f};
+    const float std[C] = {58.395f, 57.12f, 57.375f};
+
+    GIGA_image_t image;
+    image.type = GIGA_UFixed8;
+    image.row_stride = 0;
+    image.mean = mean;
+    image.std = std;
+
+    const size_t start = usec_timer();
+    for(int it = 0 ; it < nb_runs ; ++it)
+    {
+        if(b_plain_copy)
+            error = giga_copy_to_tensor(converted_data.data(), GT, tensor.fp_shift, &tensor);
+        else
+            error = giga_copy_image_to_tensor(image_data.data(), &image, &tensor);
+        if(error != GIGA_Success)
+        {
+            if (error == GIGA_Unimplemented_Type)
+            {
+                std::cout << "Type not implemented" << std::endl;
+                on_error_message.clear();
+                return GIGA_Success;
+            }
+            if (error == GIGA_Not_Implemented)
+            {
+                std::cout << "Function not implemented" << std::endl;
+                on_error_message.clear();
+                return GIGA_Success;
+            }
+            std::cerr << "Error performing " << (b_plain_copy ? "giga_copy_to_tensor" : "giga_copy_image_to_tensor") << std::endl;
+            return error;
+        }
+    }
+    if ((error = giga_flush(device_id)) != GIGA_Success)
+    {
+        std::cerr << "Error flushing device" << std::endl;
+        return error;
+    }
+    if ((error = giga_wait_for_completion()) != GIGA_Success)
+    {
+        std::cerr << "Error waiting for completion" << std::endl;
+        return error;
+    }
+    const size_t end = usec_timer();
+    std::cout << double(end - start) / nb_runs << "µs per call" << std::endl;
+
+    error = giga_release_tensor(&tensor);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error releasing tensor" << std::endl;
+        return error;
+    }
+
+    on_error_message.clear();
+
+    return GIGA_Success;
+}
+
+int main()
+{
+    GIGA_error error = GIGA_Success;
+
+    const int nb_runs = 10;
+
+#define EARLY_ABORT() throw std::runtime_error("Error")
+
+    try
+    {
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_SFixed8})
+        {
+            if((error = copy_image_benchmark(GT, nb_runs)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = copy_image_benchmark(GT, nb_runs, true)) != GIGA_Success)
+                EARLY_ABORT();
+        }
+    }
+    catch(const std::exception &e)
+    {
+        if (error != GIGA_Success)
+            std::cerr << "Error: " << giga_str_error(error) << std::endl;
+        else
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            error = GIGA_Unknown_Error;
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,166 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \date 17/01/2025
+ */
+#include <giga/giga.h>
+#include "../tests/utils.h"
+
+static const char *pyramid_filter_str(GIGA_pyramid_filter filter)
+{
+    switch(filter)
+    {
+    case GIGA_Pyramid_Box:      return "box";
+    case GIGA_Pyramid_Gaussian: return "gaussian";
+    }
+    return "unknown";
+}
+
+GIGA_error pyramid_benchmark(GIGA_data_type GT, GIGA_pyramid_filter filter, const int nb_runs, bool b_level_by_level = false)
+{
+    const uint32_t nb_levels = 5;
+
+    ScopedMessage on_error_message(std::string("Error on ")
+                                   + "Pyramid " + giga_data_type_str(GT) + " " + pyramid_filter_str(filter)
+                                   + (b_level_by_level ? " level by level" : ""));
+    std::cout << "Pyramid " << giga_data_type_str(GT) << " " << pyramid_filter_str(filter) << ", " << nb_levels << " levels"
+              << (b_level_by_level ? ", level by level" : ", one pass") << " : " << std::flush;
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error getting default device id" << std::endl;
+        return error;
+    }
+
+    error = giga_initialize_device(device_id);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error initializing device" << std::endl;
+        return error;
+    }
+
+    size_t offset = 0;
+
+    // Input and levels
+    GIGA_tensor_t tensors[nb_levels + 1];
+    for(uint32_t i = 0; i <= nb_levels; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = 4;
+        tensor.dims[0] = 1;
+        tensor.dims[1] = 3;
+        tensor.dims[2] = i == 0 ? 2048 : (tensors[i - 1].dims[2] + 1) / 2;
+        tensor.dims[3] = i == 0 ? 2048 : (tensors[i - 1].dims[3] + 1) / 2;
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = 0;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        error = giga_allocate_tensor(&tensor, &tensor_params);
+        if(error != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return error;
+        }
+    }
+
+    fill_contiguous_tensor_with_random_data(tensors[0], 0.f, 100.f);
+
+    GIGA_pyramid_t pyramid_params;
+    pyramid_params.filter = filter;
+    pyramid_params.nb_levels = b_level_by_level ? 1 : nb_levels;
+
+    const size_t start = usec_timer();
+    for(int it = 0 ; it < nb_runs ; ++it)
+    {
+        // Level by level, each level reads back the previous one from memory
+        for(uint32_t level = 0; level < (b_level_by_level ? nb_levels : 1); ++level)
+        {
+            error = giga_pyramid(&pyramid_params, &tensors[level], &tensors[level + 1]);
+            if(error != GIGA_Success)
+            {
+                if (error == GIGA_Unimplemented_Type)
+                {
+                    std::cout << "Type not implemented" << std::endl;
+                    on_error_message.clear();
+                    return GIGA_Success;
+                }
+                if (error == GIGA_Not_Implemented)
+                {
+                    std::cout << "Function not implemented" << std::endl;
+                    on_error_message.clear();
+                    return GIGA_Success;
+                }
+                std::cerr << "Error performing giga_pyramid" << std::endl;
+                return error;
+            }
+        }
+    }
+    if ((error = giga_flush(device_id)) != GIGA_Success)
+    {
+        std::cerr << "Error flushing device" << std::endl;
+        return error;
+    }
+    if ((error = giga_wait_for_completion()) != GIGA_Success)
+    {
+        std::cerr << "Error waiting for completion" << std::endl;
+        return error;
+    }
+    const size_t end = usec_timer();
+    std::cout << double(end - start) / nb_runs << "µs per call" << std::endl;
+
+    for(GIGA_tensor_t &tensor : tensors)
+    {
+        error = giga_release_tensor(&tensor);
+        if(error != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return error;
+        }
+    }
+
+    on_error_message.clear();
+
+    return GIGA_Success;
+}
+
+int main()
+{
+    GIGA_error error = GIGA_Success;
+
+    const int nb_runs = 10;
+
+#define EARLY_ABORT() throw std::runtime_error("Error")
+
+    try
+    {
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_UFixed8})
+        {
+            for(GIGA_pyramid_filter filter : {GIGA_Pyramid_Box, GIGA_Pyramid_Gaussian})
+            {
+                if((error = pyramid_benchmark(GT, filter, nb_runs)) != GIGA_Success)
+                    EARLY_ABORT();
+                if((error = pyramid_benchmark(GT, filter, nb_runs, true)) != GIGA_Success)
+                    EARLY_ABORT();
+            }
+        }
+    }
+    catch(const std::exception &e)
+    {
+        if (error != GIGA_Success)
+            std::cerr << "Error: " << giga_str_error(error) << std::endl;
+        else
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            error = GIGA_Unknown_Error;
+        }
+    }
+
+    return error;
+}
@@ -6,13 +6,17 @@
 
 #include "../tests/utils.h"
 
-GIGA_error softmax_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, int nb_runs, uint8_t in_shift = 0, uint8_t out_shift = 0)
+GIGA_error softmax_benchmark(const std::vector<uint32_t> &dims, GIGA_data_type i_GT, GIGA_data_type o_GT, int nb_runs, uint8_t in_shift = 0, uint8_t out_shift = 0)
 {
+    std::string shape;
+    for(const uint32_t dim : dims)
+        shape += (shape.empty() ? "" : "x") + std::to_string(dim);
+
     ScopedMessage on_error_message(std::string("Error on ")
-                                   + "Softmax, in " + giga_data_type_str(i_GT)
+                                   + "Softmax " + shape + ", in " + giga_data_type_str(i_GT)
                                    + ", out " + giga_data_type_str(o_GT));
 
-    std::cout << "Softmax, in " << giga_data_type_str(i_GT)
+    std::cout << "Softmax " << shape << ", in " << giga_data_type_str(i_GT)
               << ", out " << giga_data_type_str(o_GT) << " : " << std::flush;
 
     GIGA_error error;
@@ -34,18 +38,18 @@ GIGA_error softmax_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, int nb_ru
     size_t offset = 0;
 
     GIGA_tensor_t tensor;
-    tensor.nb_dims = 2;
-    tensor.dims[0] = 1;
-    tensor.dims[1] = 1024;
+    tensor.nb_dims = dims.size();
+    for(uint32_t i = 0 ; i < dims.size() ; ++i)
+        tensor.dims[i] = dims[i];
     tensor.device_id = device_id;
     tensor.data = NULL;
     tensor.type = i_GT;
-    tensor.fp_shift = 0;
+    tensor.fp_shift = in_shift;
 
     GIGA_allocate_t tensor_params;
     tensor_params.memory_zone_id = 0;
     tensor_params.offset = offset;
-    offset += tensor_size_in_bytes(&tensor);
+    offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
     error = giga_allocate_tensor(&tensor, &tensor_params);
     if(error != GIGA_Success)
     {
@@ -59,12 +63,12 @@ GIGA_error softmax_benchmark(GIGA_data_type i_GT, GIGA_data_type o_GT, int nb_ru
     softmaxed.device_id = device_id;
     softmaxed.data = NULL;
     softmaxed.type = o_GT;
-    softmaxed.fp_shift = 0;
+    softmaxed.fp_shift = out_shift;
 
     GIGA_allocate_t softmaxed_params;
     softmaxed_params.memory_zone_id = 0;
     softmaxed_params.offset = offset;
-    offset += tensor_size_in_bytes(&softmaxed);
+    offset += align_address(tensor_size_in_bytes(&softmaxed), TENSOR_ALIGNMENT);
     error = giga_allocate_tensor(&softmaxed, &softmaxed_params);
     if(error != GIGA_Success)
     {
@@ -137,17 +141,29 @@ int main()
 
     try
     {
-        if((error = softmax_benchmark(GIGA_Float32, GIGA_Float32, nb_runs)) != GIGA_Success)
+        if((error = softmax_benchmark({1, 1024}, GIGA_Float32, GIGA_Float32, nb_runs)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = softmax_benchmark({1, 1024}, GIGA_Float16, GIGA_Float16, nb_runs)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = softmax_benchmark({1, 1024}, GIGA_SFixed8, GIGA_SFixed8, nb_runs, 4, 4)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = softmax_benchmark({1, 1024}, GIGA_SFixed16, GIGA_SFixed16, nb_runs, 4, 4)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = softmax_benchmark({1, 1024}, GIGA_UFixed8, GIGA_UFixed8, nb_runs, 4, 4)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = softmax_benchmark({1, 1024}, GIGA_UFixed16, GIGA_UFixed16, nb_runs, 4, 4)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = softmax_benchmark({1, 21, 256, 256}, GIGA_Float32, GIGA_Float32, nb_runs / 100)) != GIGA_Success)
             EARLY_ABORT();
-        if((error = softmax_benchmark(GIGA_Float16, GIGA_Float16, nb_runs)) != GIGA_Success)
+        if((error = softmax_benchmark({1, 21, 256, 256}, GIGA_Float16, GIGA_Float16, nb_runs / 100)) != GIGA_Success)
             EARLY_ABORT();
-        if((error = softmax_benchmark(GIGA_SFixed8, GIGA_SFixed8, nb_runs, 4, 4)) != GIGA_Success)
+        if((error = softmax_benchmark({1, 21, 256, 256}, GIGA_SFixed8, GIGA_SFixed8, nb_runs / 100, 4, 4)) != GIGA_Success)
             EARLY_ABORT();
-        if((error = softmax_benchmark(GIGA_SFixed16, GIGA_SFixed16, nb_runs, 4, 4)) != GIGA_Success)
+        if((error = softmax_benchmark({1, 21, 256, 256}, GIGA_SFixed16, GIGA_SFixed16, nb_runs / 100, 4, 4)) != GIGA_Success)
             EARLY_ABORT();
-        if((error = softmax_benchmark(GIGA_UFixed8, GIGA_UFixed8, nb_runs, 4, 4)) != GIGA_Success)
+        if((error = softmax_benchmark({1, 21, 256, 256}, GIGA_UFixed8, GIGA_UFixed8, nb_runs / 100, 4, 4)) != GIGA_Success)
             EARLY_ABORT();
-        if((error = softmax_benchmark(GIGA_UFixed16, GIGA_UFixed16, nb_runs, 4, 4)) != GIGA_Success)
+        if((error = softmax_benchmark({1, 21, 256, 256}, GIGA_UFixed16, GIGA_UFixed16, nb_runs / 100, 4, 4)) != GIGA_Success)
             EARLY_ABORT();
     }
     catch(const std::exception &e)
@@ -5,11 +5,23 @@
 #include <giga/giga.h>
 #include "../tests/utils.h"
 
-GIGA_error upsample_benchmark(GIGA_data_type GT, const int nb_runs)
+static const char *upsample_mode_str(GIGA_upsample_mode mode)
+{
+    switch(mode)
+    {
+    case GIGA_Upsample_Nearest:                 return "nearest";
+    case GIGA_Upsample_Bilinear:                return "bilinear";
+    case GIGA_Upsample_Bilinear_Align_Corners:  return "bilinear align corners";
+    }
+    return "unknown";
+}
+
+GIGA_error upsample_benchmark(GIGA_data_type GT, GIGA_upsample_mode mode, uint32_t factor, const int nb_runs, bool b_add = false)
 {
     ScopedMessage on_error_message(std::string("Error on ")
-                                   + "Upsample " + giga_data_type_str(GT));
-    std::cout << "Upsample " << giga_data_type_str(GT) << " : " << std::flush;
+                                   + "Upsample " + giga_data_type_str(GT) + " " + upsample_mode_str(mode) + " x" + std::to_string(factor)
+                                   + (b_add ? " add" : ""));
+    std::cout << "Upsample " << giga_data_type_str(GT) << " " << upsample_mode_str(mode) << " x" << factor << (b_add ? " add" : "") << " : " << std::flush;
 
     GIGA_error error;
     uint32_t device_id = giga_get_default_device_id(&error);
@@ -33,8 +45,9 @@ GIGA_error upsample_benchmark(GIGA_data_type GT, const int nb_runs)
     tensor.nb_dims = 4;
     tensor.dims[0] = 1;
     tensor.dims[1] = 8;
-    tensor.dims[2] = 512;
-    tensor.dims[3] = 512;
+    // The output is always 1024x1024
+    tensor.dims[2] = 1024 / factor;
+    tensor.dims[3] = 1024 / factor;
     tensor.device_id = device_id;
     tensor.type = GT;
     tensor.fp_shift = 0;
@@ -42,7 +55,7 @@ GIGA_error upsample_benchmark(GIGA_data_type GT, const int nb_runs)
     GIGA_allocate_t tensor_params;
     tensor_params.memory_zone_id = 0;
     tensor_params.offset = offset;
-    offset += tensor_size_in_bytes(&tensor);
+    offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
     error = giga_allocate_tensor(&tensor, &tensor_params);
     if(error != GIGA_Success)
     {
@@ -53,8 +66,8 @@ GIGA_error upsample_benchmark(GIGA_data_type GT, const int nb_runs)
     fill_contiguous_tensor_with_random_data(tensor, -1.f, 1.f);
 
     GIGA_tensor_t upsampled = tensor;
-    upsampled.dims[2] *= 2;
-    upsampled.dims[3] *= 2;
+    upsampled.dims[2] *= factor;
+    upsampled.dims[3] *= factor;
     upsampled.device_id = device_id;
     upsampled.type = GT;
     upsampled.fp_shift = 0;
@@ -62,7 +75,7 @@ GIGA_error upsample_benchmark(GIGA_data_type GT, const int nb_runs)
     GIGA_allocate_t upsampled_params;
     upsampled_params.memory_zone_id = 0;
     upsampled_params.offset = offset;
-    offset += tensor_size_in_bytes(&upsampled);
+    offset += align_address(tensor_size_in_bytes(&upsampled), TENSOR_ALIGNMENT);
 
     error = giga_allocate_tensor(&upsampled, &upsampled_params);
     if(error != GIGA_Success)
@@ -72,7 +85,10 @@ GIGA_error upsample_benchmark(GIGA_data_type GT, const int nb_runs)
     }
 
     GIGA_upsample_t upsample_params;
-    upsample_params.factor = 2;
+    upsample_params.factor = factor;
+    upsample_params.mode = mode;
+    // In place accumulation into the output, as in a FPN top-down pathway
+    upsample_params.addend = b_add ? &upsampled : NULL;
 
     const size_t start = usec_timer();
     for(int it = 0 ; it < nb_runs ; ++it)
@@ -138,18 +154,17 @@ int main()
 
     try
     {
-        if((error = upsample_benchmark(GIGA_Float32, nb_runs)) != GIGA_Success)
-            EARLY_ABORT();
-        if((error = upsample_benchmark(GIGA_Float16, nb_runs)) != GIGA_Success)
-            EARLY_ABORT();
-        if((error = upsample_benchmark(GIGA_SFixed8, nb_runs)) != GIGA_Success)
-            EARLY_ABORT();
-        if((error = upsample_benchmark(GIGA_SFixed16, nb_runs)) != GIGA_Success)
-            EARLY_ABORT();
-        if((error = upsample_benchmark(GIGA_UFixed8, nb_runs)) != GIGA_Success)
-            EARLY_ABORT();
-        if((error = upsample_benchmark(GIGA_UFixed16, nb_runs)) != GIGA_Success)
-            EARLY_ABORT();
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_SFixed8, GIGA_SFixed16, GIGA_UFixed8, GIGA_UFixed16})
+        {
+            if((error = upsample_benchmark(GT, GIGA_Upsample_Nearest, 2, nb_runs)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = upsample_benchmark(GT, GIGA_Upsample_Nearest, 4, nb_runs)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = upsample_benchmark(GT, GIGA_Upsample_Bilinear, 2, nb_runs)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = upsample_benchmark(GT, GIGA_Upsample_Nearest, 2, nb_runs, true)) != GIGA_Success)
+                EARLY_ABORT();
+        }
     }
     catch(const std::exception &e)
     {
@@ -39,6 +39,6 @@
  * - replace unsupported activation functions with a supported equivalent (ie. replace LeakyReLU with ReLU)
  *
  * The generated code embed both structure (as C code) and weights (as constant arrays). The network is converted layer by layer to GIGA. Some layers
- * may be implemented with more than one GIGA function. For instance linear upsampling is implemented using nearest neighbor upsampling followed by a
- * depth-wise convolution with an averaging filter. Some operations may be implemented implicitly such as tensor concatenation which makes them free.
+ * may be implemented with more than one GIGA function. For instance batch normalization is implemented using one
+ * convolution per channel on views. Some operations may be implemented implicitly such as tensor concatenation which makes them free.
  */
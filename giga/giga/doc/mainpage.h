@@ -46,10 +46,16 @@
  * - Kernel size : 3x3 only.
  * - Stride : 1 or 2.
  * - Padding : 0, 1 or 2 with zeros. Assymetric padding is possible.
+ * - Upsampling : none or x2 nearest neighbour applied to the input (stride 1 only). The upsampled tensor is never materialized.
  *
  * By changing parameters, it's possible to mimic other kernel sizes. For example, a 2x2 kernel with 1 padding can be done with a 3x3 kernel filled with zeros on
  * the last row and column as well as changing the left and bottom padding to 2. A ReLU activation function can be applied at the end of the convolution.
  *
+ * \subsubsection conv2d_transpose 2d Transposed Convolution
+ *
+ * 2d transposed convolution (also known as deconvolution) is supported with a stride of 2 and kernel sizes from 2x2 to 4x4. The padding crops the full output, from 0 to
+ * the kernel size - 1 on each side, which covers the output padding of frameworks. A ReLU activation function can be applied at the end of the transposed convolution.
+ *
  * \subsubsection dense Dense layers
  *
  * Dense layers (also known as linear layers) are supported. The input and output tensors must be one or two dimensional with two dimensional tensors having the
@@ -61,18 +67,43 @@
  *
  * \subsubsection upsample Upsampling
  *
- * Nearest Neighbour upsampling is supported. Only upsampling by a factor of 2 is supported.
+ * Nearest Neighbour and bilinear upsampling are supported for any integer factor. Bilinear upsampling comes with half pixel centers (align_corners=False) or with aligned corners (align_corners=True).
+ * The upsampled values can be added directly to another tensor (the top-down pathway of feature pyramid networks), with the same fixed point alignment and saturation as addition, which avoids writing and reading back the upsampled tensor.
+ *
+ * \subsubsection pool2d Pooling
+ *
+ * 2d average and max pooling are supported with kernel sizes 1, 2 or 3, a stride of 1 or 2 and padding smaller than the kernel size. Averages can either count padded pixels as zeros
+ * or only count the input pixels of each window.
+ * Global average and max pooling reduce the whole H and W dimensions of each channel, which keeps classification heads on the device and only reads back one value per channel.
+ *
+ * \subsubsection pyramid Image pyramid
+ *
+ * Image pyramids are built in one call: each level is the previous one filtered by a 2x2 box or a 5x5 Gaussian ([1 4 6 4 1] / 16) and decimated by 2, with replicated
+ * borders. The levels can be views into a single buffer, which feeds multi-scale detectors without copying the input for each scale.
+ *
+ * \subsubsection space_to_depth Space to depth and depth to space
+ *
+ * Space to depth moves the b×b blocks of the H and W dimensions to the channel dimension and depth to space (pixel shuffle) does the opposite, which covers the stems
+ * of detection networks and the sub-pixel upsampling of super-resolution decoders. Depth channels can be ordered channel major (PyTorch pixel_shuffle) or block major
+ * (TensorFlow / ONNX DCR mode). Values are only moved, the input and output tensors must have the same type and fixed point shift.
  *
  * \subsubsection softmax Softmax
  *
  * Softmaxing is supported in two cases. One related to image classification is a 1d softmax. The other case is related to segmentation and is a 2d softmax along the
  * channels dimension.
  *
+ * \subsubsection argmax Argmax
+ *
+ * Argmax along the same dimension as softmax is supported. It writes the index of the maximum channel into a UFixed8 or UFixed16 label map and can optionally output
+ * the maximum softmax probability. This is the preferred way to post-process segmentation outputs since it avoids computing and reading back the full softmax tensor.
+ *
  * \subsubsection reshape Reshaping
  *
- * \subsubsection add Addition
+ * \subsubsection add Addition and multiplication
  *
- * Two tensors can be added as long as they have exactly the same number of dimensions and the same shape.
+ * Two tensors can be added or multiplied elementwise. NumPy style broadcasting is supported: dimensions are aligned on the right and each input dimension must be
+ * either equal to the output one or 1. This covers per channel scale and offset (C×1×1 operands) as well as per pixel maps (1×H×W operands) without materializing
+ * full tensors.
  *
  * \subsubsection other Other operations
  *
@@ -80,10 +111,6 @@
  *
  *  - **Batch Normalization** is a very common operation in convolutional neural networks. It can be implemented in the GIGA API using a combination of convolutions and views.
  *
- *  - **2d Average Pooling** can be implemented using convolution (possibly with a smaller kernel trick) and views.
- *
- *  - **Bilinear Upsampling** can be very closely approximated using nearest neighbours upsampling and a 2d Convolution with an appropriate kernel.
- *
  *
  * \subsection memory Memory management
  *
@@ -95,8 +122,16 @@
  * Tensors can share memory when the user deems it appropriate in order to save on memory imprint. Views implicitely also declare tensors sharing the same memory as other tensors.
  * It is strongly encouraged to create the memory layout of all tensors before starting processing. The implementation of a Neural Network will therefore often be dependent on the
  * backend implementation when it comes to allocation.
+ * When the layout cannot be planned in advance (tensor sizes changing at runtime for instance), the offset of a tensor can be set to GIGA_AUTO_OFFSET to let the
+ * backend choose it, the memory being reused once the tensor is released.
  *
  * Memory with always be owned by the API backend. In order to access the tensors' memory to write and read from it, the API provides a mapping feature.
+ * The only exception are tensors imported with giga_import_tensor, which wrap a buffer of the user (camera DMA buffer, decoder output, shared memory) without
+ * copying it. The user keeps the ownership of such a buffer, which must outlive the tensor.
+ *
+ * Camera frames can be written directly into an input tensor with giga_copy_image_to_tensor: interleaved HWC images with 8 bits or 16 bits samples (and optionally
+ * padded rows) are transposed to the tensor layout and normalized per channel ((x - mean) / std) in a single pass, rounding and saturating to the tensor type and fixed
+ * point shift. This avoids the host side conversion and the extra copy of the converted data.
  *
  * \subsection async Asynchronous processing
  *
@@ -7,13 +7,18 @@
 #define GIGA_FLOAT16_H_e76aa9209c0fc37cb75514cdaa50beff
 
 #include <stdint.h>
+#include <stddef.h>
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
 #ifdef __cplusplus
 #include <type_traits>
 #endif
 
 /*! \brief This class implements a half precision floatting point type
  *
- * This is used for storage only! Only conversions to and from float are supported (in C++)!
+ * This is used for storage only! Only conversions to and from float are supported (implicit in C++, with \link giga_half_from_float \endlink and
+ * \link giga_float_from_half \endlink in C)!
  */
 typedef struct half
 {
@@ -31,40 +36,97 @@ typedef struct half
     uint16_t data;
 } half;
 
-#ifdef __cplusplus
-half::half(const float &v)
+/*! \brief Converts a float to a half precision value
+ *
+ * Rounds to the nearest even value, values too small for normal half precision values become denormals (or signed zeros) and values too large
+ * become infinities. NaNs become quiet NaNs keeping the upper bits of their payload, as with F16C instructions.
+ */
+static inline half giga_half_from_float(float v)
 {
     union
     {
         float f;
         uint32_t i;
-    } u;
+    } u, denormal;
     u.f = v;
 
-    int32_t e = int32_t((u.i >> 23) & 0xFFU);
-    if (e == 0)     // 0 or denorm
-    {
-        data = 0;
-        return;
-    }
-    e -= 127;
-    if (e < -14)        // Flush to 0
-    {
-        data = 0;
-        return;
-    }
-    else if (e > 15)    // Flush to infinity
-        e = 31;
-    else
-        e += 15;
-    // Sign
-    data = (u.i >> 16) & 0x8000U;
-    if (e != 31)
+    const uint32_t sign = (u.i >> 16) & 0x8000U;
+    const uint32_t abs_bits = u.i & 0x7FFFFFFFU;
+    u.i = abs_bits;
+
+    // The result of each range is computed and selected without branches so that loops of conversions vectorize
+    // 2^16 and above: infinity or quiet NaN
+    const uint32_t special = abs_bits > 0x7F800000U ? 0x7E00U | ((abs_bits >> 13) & 0x3FFU) : 0x7C00U;
+    // Below 2^-14: denormal or 0, adding 0.5 (whose ulp is the smallest denormal half) aligns and rounds the mantissa
+    denormal.f = u.f + 0.5f;
+    const uint32_t small = denormal.i - 0x3F000000U;
+    // Normal: rebias the exponent and round the mantissa to nearest even, a carry may reach infinity
+    const uint32_t normal = (abs_bits - (112U << 23) + 0xFFFU + ((abs_bits >> 13) & 1U)) >> 13;
+
+    half h;
+    h.data = (uint16_t)(sign | (abs_bits >= 0x47800000U ? special : (abs_bits < 0x38800000U ? small : normal)));
+    return h;
+}
+
+/*! \brief Converts a half precision value to a float, exactly (denormals included)
+ *
+ * NaNs become quiet NaNs keeping their payload, as with F16C instructions.
+ */
+static inline float giga_float_from_half(half h)
+{
+    union
     {
-        const uint32_t m = (u.i  >> 13) & 0x3FFU;     // Keep only 10bits
-        data |= m;
-    }
-    data |= (uint32_t(e) << 10);
+        float f;
+        uint32_t i;
+    } u, denormal, magic;
+    magic.i = 113U << 23;               // 2^-14
+
+    const uint32_t bits = (uint32_t)(h.data & 0x7FFFU) << 13;
+    const uint32_t exponent = bits & (0x7C00U << 13);
+    // Normal, infinity or NaN: rebias the exponent
+    const uint32_t normal = bits + ((uint32_t)(127 - 15) << 23);
+    const uint32_t special = (normal + ((uint32_t)(128 - 16) << 23)) | ((h.data & 0x3FFU) ? 0x400000U : 0U);
+    // Denormal or 0: the mantissa is scaled by the float subtraction
+    denormal.i = normal + (1U << 23);
+    denormal.f -= magic.f;
+
+    u.i = (exponent == (0x7C00U << 13) ? special : (exponent == 0 ? denormal.i : normal)) | ((uint32_t)(h.data & 0x8000U) << 16);
+    return u.f;
+}
+
+/*! \brief Converts n floats to half precision values, with the rounding of \link giga_half_from_float \endlink
+ *
+ * Blocks of 8 values are converted with F16C instructions when they are enabled at compile time, with the same results.
+ */
+static inline void giga_half_from_float_n(half *dst, const float *src, size_t n)
+{
+    size_t i = 0;
+#ifdef __F16C__
+    for(; i + 8 <= n ; i += 8)
+        _mm_storeu_si128((__m128i*)(dst + i), _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+    for(; i < n ; ++i)
+        dst[i] = giga_half_from_float(src[i]);
+}
+
+/*! \brief Converts n half precision values to floats
+ *
+ * Blocks of 8 values are converted with F16C instructions when they are enabled at compile time, with the same results.
+ */
+static inline void giga_float_from_half_n(float *dst, const half *src, size_t n)
+{
+    size_t i = 0;
+#ifdef __F16C__
+    for(; i + 8 <= n ; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(src + i))));
+#endif
+    for(; i < n ; ++i)
+        dst[i] = giga_float_from_half(src[i]);
+}
+
+#ifdef __cplusplus
+half::half(const float &v) : data(giga_half_from_float(v).data)
+{
 }
 
 half &half::operator=(const half &v)
@@ -75,31 +137,7 @@ half &half::operator=(const half &v)
 
 half::operator float() const
 {
-    if (data == 0)
-        return 0.f;
-
-    union
-    {
-        float f;
-        uint32_t i;
-    } u;
-    const uint32_t v = data;
-    // Sign
-    u.i = (v & 0x8000U) << 16;
-    uint32_t e = ((v >> 10) & 0x1FU) + uint32_t(127 - 15);
-    if (e == 31 + (127 - 15))   // Infinity
-    {
-        e = 0xFF;
-        u.i |= e << 23;
-    }
-    else
-    {
-        u.i |= e << 23;
-        const uint32_t m = v & 0x3FFU;
-        u.i |= m << 13;
-    }
-
-    return u.f;
+    return giga_float_from_half(*this);
 }
 
 template<typename T, std::enable_if_t<std::is_integral<T>::value>>
@@ -28,15 +28,24 @@ extern "C"
     STUB(GIGA_error, giga_list_devices, uint32_t *device_ids, uint32_t *nb_devices);
     STUB(GIGA_error, giga_initialize_device, uint32_t device_id);
     STUB(GIGA_error, giga_allocate_tensor_, GIGA_tensor_t *tensor, const GIGA_allocate_t *params, const char *file, int line);
+    STUB(GIGA_error, giga_import_tensor_, GIGA_tensor_t *tensor, void *user_ptr, const char *file, int line);
     STUB(GIGA_error, giga_map_tensor_, GIGA_tensor_t *tensor, void **ptr, GIGA_memory_flag flags, const char *file, int line);
     STUB(GIGA_error, giga_unmap_tensor_, GIGA_tensor_t *tensor, void *ptr, GIGA_memory_flag flags, const char *file, int line);
     STUB(GIGA_error, giga_release_tensor_, GIGA_tensor_t *tensor, const char *file, int line);
     STUB(GIGA_error, giga_conv2d_, const GIGA_conv2d_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+    STUB(GIGA_error, giga_conv2d_transpose_, const GIGA_conv2d_transpose_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
     STUB(GIGA_error, giga_dense_, const GIGA_dense_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
     STUB(GIGA_error, giga_reshape_, const GIGA_reshape_t * params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
     STUB(GIGA_error, giga_softmax_, const GIGA_softmax_t * params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+    STUB(GIGA_error, giga_argmax_, const GIGA_argmax_t * params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
     STUB(GIGA_error, giga_add_, const GIGA_add_t * params, const GIGA_tensor_t *a, const GIGA_tensor_t *b, GIGA_tensor_t *out, const char *file, int line);
+    STUB(GIGA_error, giga_mul_, const GIGA_mul_t * params, const GIGA_tensor_t *a, const GIGA_tensor_t *b, GIGA_tensor_t *out, const char *file, int line);
     STUB(GIGA_error, giga_upsample_, const GIGA_upsample_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+    STUB(GIGA_error, giga_pool2d_, const GIGA_pool2d_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+    STUB(GIGA_error, giga_global_pool_, const GIGA_global_pool_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+    STUB(GIGA_error, giga_pyramid_, const GIGA_pyramid_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+    STUB(GIGA_error, giga_space_to_depth_, const GIGA_space_to_depth_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+    STUB(GIGA_error, giga_depth_to_space_, const GIGA_depth_to_space_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
     STUB(GIGA_error, giga_view_, const GIGA_view_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
     STUB(GIGA_error, giga_callback_, uint32_t device_id, void (*callback)(void *user_ptr), void *user_ptr, const char *file, int line);
     STUB(GIGA_error, giga_wait_for_completion);
@@ -44,4 +53,5 @@ extern "C"
     STUB(GIGA_error, giga_register_error_callback, void (*callback)(void *user_ptr, GIGA_error err, const char *file, int line), void *user_ptr);
     STUB(GIGA_error, giga_copy_to_tensor_, const void *user_ptr, GIGA_data_type source_type, uint32_t fp_shift, GIGA_tensor_t *tensor, const char *file, int line);
     STUB(GIGA_error, giga_copy_from_tensor_, void *user_ptr, GIGA_data_type target_type, uint32_t fp_shift, const GIGA_tensor_t *tensor, const char *file, int line);
+    STUB(GIGA_error, giga_copy_image_to_tensor_, const void *user_ptr, const GIGA_image_t *image, GIGA_tensor_t *tensor, const char *file, int line);
 }
@@ -175,12 +175,18 @@ GIGA_API typedef enum GIGA_memory_flag
     GIGA_Memory_Sync    = 0x1,
 } GIGA_memory_flag;
 
+/*! \brief Offset of \link GIGA_allocate_t \endlink letting the backend choose where the tensor is allocated in its memory zone
+ *
+ * The backend reuses the memory of such tensors once they and all their views are released, which suits workloads whose tensor sizes change at runtime.
+ */
+#define GIGA_AUTO_OFFSET 0xFFFFFFFF
+
 /*! \brief Parameters from allocating a new \link GIGA_tensor_t \endlink
  */
 GIGA_API typedef struct GIGA_allocate_t
 {
     uint32_t memory_zone_id;    //!< The id of the memory zone in which the tensor must be allocated
-    uint32_t offset;            //!< The offset from the start of the memory zone
+    uint32_t offset;            //!< The offset from the start of the memory zone, or \link GIGA_AUTO_OFFSET \endlink to let the backend choose it
 } GIGA_allocate_t;
 
 /*! \brief Allocates a new \link GIGA_tensor_t \endlink
@@ -195,6 +201,20 @@ GIGA_API typedef struct GIGA_allocate_t
 #define giga_allocate_tensor(tensor, params) giga_allocate_tensor_(tensor,params,__FILE__,__LINE__)
 GIGA_API GIGA_error giga_allocate_tensor_(GIGA_tensor_t *tensor, const GIGA_allocate_t *params, const char *file, int line);
 
+/*! \brief Imports a buffer owned by the user as a \link GIGA_tensor_t \endlink without copying it
+ *
+ * This function wraps an existing buffer (camera DMA buffer, decoder output, shared memory, ...) as a tensor described by the tensor parameter.
+ * The number of dimensions, the device id, the data type and the dimensions must be specified. The strides describe the layout of the buffer: when they
+ * are all set to 0, they are filled by the API as for \link giga_allocate_tensor_ \endlink. Each backend specifies the alignment and the layouts it accepts.
+ * The buffer is still owned by the user: it must outlive the tensor and is never freed by the API, releasing the tensor only forgets it.
+ * \param tensor A pointer to the tensor to be imported
+ * \param[in] user_ptr A pointer to the first element of the tensor in the user buffer
+ *
+ * \return Error
+ */
+#define giga_import_tensor(tensor, user_ptr) giga_import_tensor_(tensor,user_ptr,__FILE__,__LINE__)
+GIGA_API GIGA_error giga_import_tensor_(GIGA_tensor_t *tensor, void *user_ptr, const char *file, int line);
+
 /*! \brief Maps a tensor for writing or reading its data.
  *
  * This function asks for a pointer to the actual data of the tensor in order to write it or read it. Depending on the flags, the API knows if the memory has changed.
@@ -226,6 +246,7 @@ GIGA_API GIGA_error giga_unmap_tensor_(GIGA_tensor_t *tensor, void *ptr, GIGA_me
 /*! \brief Releases the memory of a tensor.
  *
  * This function indicates to the API that the memory used by the tensor will no longer be used by the API client.
+ * Views of the tensor stay valid: the memory of a tensor allocated at \link GIGA_AUTO_OFFSET \endlink is only reused once its views are released too.
  *
  * \param tensor A pointer to the tensor to released.
  *
@@ -243,6 +264,7 @@ GIGA_API typedef struct GIGA_conv2d_t
     int32_t padding[2][2];          //!< The padding on each side of the tensor in the H, W dimensions (0, 1 or 2)
     uint32_t stride[2];             //!< The convolution stride in dimensions H, W (1 or 2)
     uint32_t dilation[2];           //!< The dilation in H, W (only 1 is allowed)
+    uint32_t upsampling;            //!< Nearest neighbour upsampling factor applied to the input before the convolution (0 or 1 for none, 2 with a stride of 1)
     bool b_ReLU;                    //!< If true, a ReLU is applied to the output of the convolution
     const GIGA_tensor_t *kernel;    //!< A pointer to a tensor acting as the kernel. Should be of dimensions (Co, Ci, H=3, W=3).
     const GIGA_tensor_t *bias;      //!< A pointer to a tensor acting as the bias. Should be of dimensions (Co) or (1, Co). If NULL no bias is applied
@@ -256,6 +278,9 @@ GIGA_API typedef struct GIGA_conv2d_t
  * The value of the batch dimension must be the same between the input and the output.
  * The tensors must be stored in the same device.
  *
+ * With an upsampling factor of 2, the convolution is applied to the nearest neighbour upsampling of the input (see \link giga_upsample_ \endlink) without
+ * materializing it: padding and output dimensions are those of a convolution of the upsampled tensor.
+ *
  * Tensor format is NCHW (Batch, Channel, Height, Width)
  *
  * \param[in] params A pointer to the 2-D convolution parameters
@@ -267,6 +292,39 @@ GIGA_API typedef struct GIGA_conv2d_t
 #define giga_conv2d(params,in,out) giga_conv2d_(params,in,out,__FILE__,__LINE__)
 GIGA_API GIGA_error giga_conv2d_(const GIGA_conv2d_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
 
+/*! \brief Parameters for the 2-d transposed convolution (deconvolution) of two \link GIGA_tensor_t \endlink.
+ */
+GIGA_API typedef struct GIGA_conv2d_transpose_t
+{
+    int32_t padding[2][2];          //!< The padding removed from each side of the full output in the H, W dimensions (from 0 to the kernel size - 1)
+    uint32_t stride[2];             //!< The transposed convolution stride in dimensions H, W (only 2 is allowed)
+    bool b_ReLU;                    //!< If true, a ReLU is applied to the output of the transposed convolution
+    const GIGA_tensor_t *kernel;    //!< A pointer to a tensor acting as the kernel. Should be of dimensions (Ci, Co, H, W) with H and W from 2 to 4.
+    const GIGA_tensor_t *bias;      //!< A pointer to a tensor acting as the bias. Should be of dimensions (Co) or (1, Co). If NULL no bias is applied
+} GIGA_conv2d_transpose_t;
+
+/*! \brief Performs the 2-d transposed convolution of two \link GIGA_tensor_t \endlink.
+ *
+ * This function performs the transposed convolution (also known as deconvolution) of the tensor using the parameters: each input pixel scatters its values
+ * weighted by the kernel into the output, input pixels being stride pixels apart. The full output of dimensions (H - 1) * stride + kernel size is then cropped
+ * by the padding, i.e. out H = (in H - 1) * stride[0] + kernel H - padding[0][0] - padding[0][1] (and the same for W). The kernel layout is the one of the
+ * convolution it transposes: its first dimension matches the input channels and its second one the output channels.
+ * The other constraints on the tensors are the same as for \link giga_conv2d_ \endlink.
+ *
+ * This is the learned upsampling of decoders: compared to an upsampling followed by a convolution, each output pixel only gathers the kernel taps of its
+ * phase, which avoids multiplying the zeros (or copies) of the upsampled tensor.
+ *
+ * Tensor format is NCHW (Batch, Channel, Height, Width)
+ *
+ * \param[in] params A pointer to the 2-D transposed convolution parameters
+ * \param[in] in The input tensor
+ * \param[out] out The output tensor
+ *
+ * \return Error
+ */
+#define giga_conv2d_transpose(params,in,out) giga_conv2d_transpose_(params,in,out,__FILE__,__LINE__)
+GIGA_API GIGA_error giga_conv2d_transpose_(const GIGA_conv2d_transpose_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+
 /*! \brief Parameters for a dense layer of type A*X + B
  */
 GIGA_API typedef struct GIGA_dense_t
@@ -343,6 +401,34 @@ GIGA_API typedef struct GIGA_softmax_t
 #define giga_softmax(params,in,out) giga_softmax_(params,in,out,__FILE__,__LINE__)
 GIGA_API GIGA_error giga_softmax_(const GIGA_softmax_t * params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line); //Along the first non-batch dimension
 
+/*! \brief Parameters for the argmax operation.
+ */
+GIGA_API typedef struct GIGA_argmax_t
+{
+    GIGA_tensor_t *probability; //!< If not NULL, receives the softmax probability of the selected class. Must have the same type as the input and the same dimensions as the output.
+} GIGA_argmax_t;
+
+/*! \brief Computes the index of the maximum value along the channel dimension of a \link GIGA_tensor_t \endlink
+ *
+ * This function finds the index of the maximum value along the same dimension as \link giga_softmax \endlink and writes it into a label map.
+ * It is meant for segmentation and classification outputs, where the class index (and optionally its confidence) is all that is needed:
+ * it avoids computing and reading back the full softmax tensor.
+ * If the tensor only has one dimensions it's applied along that dimension.
+ * If the tensor has two dimensions, the first one is considered to be the batch dimension and argmax is applied along the second dimension.
+ * If the tensor has 3 or 4 dimensions, argmax is applied along the second one considered the channel dimension.
+ * The output tensor must have the same number of dimensions as the input, the same dimensions except for the channel dimension which must be 1,
+ * and be of type \link GIGA_UFixed8 \endlink or \link GIGA_UFixed16 \endlink. In case of ties, the lowest index is returned.
+ * If params->probability is not NULL, the maximum softmax probability is also written to it (its fp_shift is honored for fixed point types).
+ *
+ * \param[in] params A pointer to the argmax parameters
+ * \param[in] in The input tensor
+ * \param[out] out The output label tensor
+ *
+ * \return Error
+ */
+#define giga_argmax(params,in,out) giga_argmax_(params,in,out,__FILE__,__LINE__)
+GIGA_API GIGA_error giga_argmax_(const GIGA_argmax_t * params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+
 /*! \brief Parameters for the addition operation of two \link GIGA_tensor_t \endlink.
  */
 GIGA_API typedef struct GIGA_add_t
@@ -352,7 +438,10 @@ GIGA_API typedef struct GIGA_add_t
 
 /*! \brief Performs the addition operation on two \link GIGA_tensor_t \endlink
  *
- * This function performs the addition operation on two tensors. The number of dimensions and their values of the input and output tensors must be equal.
+ * This function performs the addition operation on two tensors. The input tensors are broadcast to the output shape following the NumPy rules:
+ * dimensions are aligned on the right, each input dimension must either be equal to the output one or be 1 (missing leading dimensions count as 1),
+ * and the output must have the number of dimensions and the shape of the largest input. For instance a (C, 1, 1) tensor can be added to a (N, C, H, W)
+ * tensor to add a per channel offset.
  *
  * \param[in] params A pointer to the addition parameters
  * \param[in] a,b The input tensors
@@ -363,17 +452,53 @@ GIGA_API typedef struct GIGA_add_t
 #define giga_add(params,a,b,out) giga_add_(params,a,b,out,__FILE__,__LINE__)
 GIGA_API GIGA_error giga_add_(const GIGA_add_t * params, const GIGA_tensor_t *a, const GIGA_tensor_t *b, GIGA_tensor_t *out, const char *file, int line);
 
-/*! \brief Parameters for the nearest neighbour upsampling operation of a \link GIGA_tensor_t \endlink.
+/*! \brief Parameters for the multiplication operation of two \link GIGA_tensor_t \endlink.
+ */
+GIGA_API typedef struct GIGA_mul_t
+{
+    uint8_t __empty__;
+} GIGA_mul_t;
+
+/*! \brief Performs the elementwise multiplication of two \link GIGA_tensor_t \endlink
+ *
+ * This function performs the elementwise multiplication of two tensors, with the same broadcasting rules as \link giga_add \endlink.
+ * Typical uses are per channel scaling (with a (C, 1, 1) operand) and spatial attention maps (with a (1, H, W) operand).
+ * In fixed point, the product of a and b has a fp_shift of a->fp_shift + b->fp_shift and is converted to the fp_shift of the output.
+ *
+ * \param[in] params A pointer to the multiplication parameters
+ * \param[in] a,b The input tensors
+ * \param[out] out The output tensor
+ *
+ * \return Error
+ */
+#define giga_mul(params,a,b,out) giga_mul_(params,a,b,out,__FILE__,__LINE__)
+GIGA_API GIGA_error giga_mul_(const GIGA_mul_t * params, const GIGA_tensor_t *a, const GIGA_tensor_t *b, GIGA_tensor_t *out, const char *file, int line);
+
+/*! \brief Interpolation modes of the upsampling operation.
+ */
+GIGA_API typedef enum GIGA_upsample_mode
+{
+    GIGA_Upsample_Nearest                   = 0x0, //!< Nearest neighbour
+    GIGA_Upsample_Bilinear                  = 0x1, //!< Bilinear with half pixel centers (align_corners=False)
+    GIGA_Upsample_Bilinear_Align_Corners    = 0x2, //!< Bilinear with the corner pixels of the input and output aligned (align_corners=True)
+} GIGA_upsample_mode;
+
+/*! \brief Parameters for the upsampling operation of a \link GIGA_tensor_t \endlink.
  */
 GIGA_API typedef struct GIGA_upsample_t
 {
-    uint32_t factor; //!< The upsampling factor. Must be equal to 2.
+    uint32_t factor;            //!< The integer upsampling factor, applied to both H and W dimensions.
+    GIGA_upsample_mode mode;    //!< The interpolation mode.
+    const GIGA_tensor_t *addend;//!< A pointer to a tensor added to the upsampled values. Should have the dimensions of the output, it may be the output itself. If NULL nothing is added
 } GIGA_upsample_t;
 
-/*! \brief Performs the nearest neighbour upsampling of a \link GIGA_tensor_t \endlink.
+/*! \brief Performs the upsampling of a \link GIGA_tensor_t \endlink.
  *
- * This function performs the nearest neighbour upsampling of a tensor. The upsampling is always by a factor of two. The input and output tensors must the same number of dimensions.
- * The channel and batch dimension must be the same. The H and W dimensions of the output tensor must be twice those of the input tensors.
+ * This function performs the nearest neighbour or bilinear upsampling of a tensor by an integer factor. The input and output tensors must the same number of dimensions.
+ * The channel and batch dimension must be the same. The H and W dimensions of the output tensor must be those of the input tensors multiplied by the factor.
+ * Bilinear interpolation clamps to the border of the input tensor. For fixed point types, interpolated values are rounded to the nearest representable value.
+ * When an addend is given, the upsampled values are added to it as with \link giga_add_ \endlink (fp_shift alignment and saturation) without writing the upsampled
+ * tensor first. This is the top-down pathway of feature pyramid networks.
  *
  * \param[in] params A pointer to the upsampling parameters
  * \param[in] in The input tensor
@@ -384,6 +509,151 @@ GIGA_API typedef struct GIGA_upsample_t
 #define giga_upsample(params,in,out) giga_upsample_(params,in,out,__FILE__,__LINE__)
 GIGA_API GIGA_error giga_upsample_(const GIGA_upsample_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
 
+/*! \brief Reduction modes of the pooling operation.
+ */
+GIGA_API typedef enum GIGA_pool_mode
+{
+    GIGA_Pool_Average   = 0x0, //!< Average of the window
+    GIGA_Pool_Max       = 0x1, //!< Maximum of the window
+} GIGA_pool_mode;
+
+/*! \brief Parameters for the 2d pooling operation of a \link GIGA_tensor_t \endlink.
+ */
+GIGA_API typedef struct GIGA_pool2d_t
+{
+    GIGA_pool_mode mode;        //!< The reduction applied to each window.
+    uint32_t kernel_size[2];    //!< The size of the window along H and W. Should be 1, 2 or 3.
+    uint32_t stride[2];         //!< The strides along H and W. Should be 1 or 2.
+    int32_t padding[2][2];      //!< The padding along H and W at beginning and end. Should be positive and smaller than the kernel size.
+    bool b_exclude_padding;     //!< If true, averages only count the input pixels of the window, otherwise padded pixels count as zeros. Ignored for max pooling.
+} GIGA_pool2d_t;
+
+/*! \brief Performs the 2d average or max pooling of a \link GIGA_tensor_t \endlink.
+ *
+ * This function reduces each kernel_size window of the H and W dimensions of the input tensor to its average or maximum. The input and output tensors must have
+ * the same type and the same number of dimensions. The channel and batch dimension must be the same. The H and W dimensions of the output tensor must be
+ * (H + padding[0][0] + padding[0][1] - kernel_size[0]) / stride[0] + 1 and (W + padding[1][0] + padding[1][1] - kernel_size[1]) / stride[1] + 1.
+ * Padded pixels never win the maximum. For fixed point types, the result is written with the fp_shift of the output tensor and averages are rounded to the
+ * nearest representable value.
+ *
+ * \param[in] params A pointer to the pooling parameters
+ * \param[in] in The input tensor
+ * \param[out] out The output tensor
+ *
+ * \return Error
+ */
+#define giga_pool2d(params,in,out) giga_pool2d_(params,in,out,__FILE__,__LINE__)
+GIGA_API GIGA_error giga_pool2d_(const GIGA_pool2d_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+
+/*! \brief Parameters for the global pooling operation of a \link GIGA_tensor_t \endlink.
+ */
+GIGA_API typedef struct GIGA_global_pool_t
+{
+    GIGA_pool_mode mode;        //!< The reduction applied to each channel.
+} GIGA_global_pool_t;
+
+/*! \brief Performs the global average or max pooling of a \link GIGA_tensor_t \endlink.
+ *
+ * This function reduces the whole H and W dimensions of each channel of the input tensor to its average or maximum, as found at the end of classification
+ * backbones. The input and output tensors must have the same type. The output tensor must either have the same number of dimensions as the input with H and W
+ * equal to 1, or drop the H and W dimensions (for instance (N, C) for a (N, C, H, W) input) so that it can directly feed a dense layer.
+ * For fixed point types, the result is written with the fp_shift of the output tensor and averages are rounded to the nearest representable value.
+ *
+ * \param[in] params A pointer to the global pooling parameters
+ * \param[in] in The input tensor
+ * \param[out] out The output tensor
+ *
+ * \return Error
+ */
+#define giga_global_pool(params,in,out) giga_global_pool_(params,in,out,__FILE__,__LINE__)
+GIGA_API GIGA_error giga_global_pool_(const GIGA_global_pool_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+
+/*! \brief Filter applied before each x2 decimation of \link giga_pyramid_ \endlink.
+ */
+GIGA_API typedef enum GIGA_pyramid_filter
+{
+    GIGA_Pyramid_Box        = 0x0, //!< 2x2 average
+    GIGA_Pyramid_Gaussian   = 0x1, //!< 5x5 binomial filter, [1 4 6 4 1] / 16 along H and W
+} GIGA_pyramid_filter;
+
+/*! \brief Parameters for the image pyramid operation of a \link GIGA_tensor_t \endlink.
+ */
+GIGA_API typedef struct GIGA_pyramid_t
+{
+    GIGA_pyramid_filter filter; //!< The filter applied before each x2 decimation.
+    uint32_t nb_levels;         //!< The number of output tensors, i.e. of downsampled levels.
+} GIGA_pyramid_t;
+
+/*! \brief Builds all the levels of an image pyramid from a \link GIGA_tensor_t \endlink in one pass.
+ *
+ * The level i (out[i]) is the level i - 1 (the input for the first level) filtered and decimated by 2 along H and W. Its H and W dimensions are
+ * (H + 1) / 2 and (W + 1) / 2 of the previous level, border pixels are replicated. The input and output tensors must have the same type and number
+ * of dimensions, the batch and channel dimensions being left untouched. Fixed point values are rounded to the nearest value of the representation
+ * of each level, as if each level was computed from the previous output tensor. Output tensors can be views, e.g. into a single buffer.
+ *
+ * \param[in] params A pointer to the pyramid parameters
+ * \param[in] in The input tensor
+ * \param[out] out An array of params->nb_levels output tensors
+ *
+ * \return Error
+ */
+#define giga_pyramid(params,in,out) giga_pyramid_(params,in,out,__FILE__,__LINE__)
+GIGA_API GIGA_error giga_pyramid_(const GIGA_pyramid_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+
+/*! \brief Order of the channels of the depth tensor of \link giga_space_to_depth_ \endlink and \link giga_depth_to_space_ \endlink.
+ */
+GIGA_API typedef enum GIGA_depth_order
+{
+    GIGA_Depth_Channel_Major    = 0x0, //!< Depth channel c * block_size^2 + i * block_size + j (CRD, PyTorch pixel_shuffle)
+    GIGA_Depth_Block_Major      = 0x1, //!< Depth channel (i * block_size + j) * C + c (DCR, TensorFlow)
+} GIGA_depth_order;
+
+/*! \brief Parameters for the space to depth operation of a \link GIGA_tensor_t \endlink.
+ */
+GIGA_API typedef struct GIGA_space_to_depth_t
+{
+    uint32_t block_size;        //!< The size of the square blocks moved to the channel dimension.
+    GIGA_depth_order order;     //!< The order of the output channels.
+} GIGA_space_to_depth_t;
+
+/*! \brief Moves square blocks of the H and W dimensions of a \link GIGA_tensor_t \endlink to the channel dimension.
+ *
+ * The pixel (i, j) of the block (h, w) of the channel c of the input is written to the pixel (h, w) of the output channel given by params->order.
+ * The input and output tensors must have the same type and fp_shift and 3 or 4 dimensions. The output tensor has block_size^2 times more channels,
+ * and H and W divided by block_size. The input H and W must be multiples of block_size. This is the inverse of \link giga_depth_to_space_ \endlink.
+ *
+ * \param[in] params A pointer to the space to depth parameters
+ * \param[in] in The input tensor
+ * \param[out] out The output tensor
+ *
+ * \return Error
+ */
+#define giga_space_to_depth(params,in,out) giga_space_to_depth_(params,in,out,__FILE__,__LINE__)
+GIGA_API GIGA_error giga_space_to_depth_(const GIGA_space_to_depth_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+
+/*! \brief Parameters for the depth to space operation of a \link GIGA_tensor_t \endlink.
+ */
+GIGA_API typedef struct GIGA_depth_to_space_t
+{
+    uint32_t block_size;        //!< The size of the square blocks built from the channel dimension.
+    GIGA_depth_order order;     //!< The order of the input channels.
+} GIGA_depth_to_space_t;
+
+/*! \brief Moves groups of channels of a \link GIGA_tensor_t \endlink to square blocks of the H and W dimensions (pixel shuffle).
+ *
+ * The pixel (h, w) of the input channel given by params->order is written to the pixel (i, j) of the block (h, w) of the output channel c.
+ * The input and output tensors must have the same type and fp_shift and 3 or 4 dimensions. The input tensor has block_size^2 times more channels,
+ * and the output H and W are the input ones multiplied by block_size. This is the sub-pixel upsampling of super-resolution decoders.
+ *
+ * \param[in] params A pointer to the depth to space parameters
+ * \param[in] in The input tensor
+ * \param[out] out The output tensor
+ *
+ * \return Error
+ */
+#define giga_depth_to_space(params,in,out) giga_depth_to_space_(params,in,out,__FILE__,__LINE__)
+GIGA_API GIGA_error giga_depth_to_space_(const GIGA_depth_to_space_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line);
+
 /*! \brief Parameters for the creation of a view of a \link GIGA_tensor_t \endlink.
  */
 GIGA_API typedef struct GIGA_view_t
@@ -506,6 +776,36 @@ GIGA_API GIGA_error giga_copy_to_tensor_(const void *user_ptr, GIGA_data_type so
 #define giga_copy_from_tensor(user_ptr, target_type, fp_shift, tensor) giga_copy_from_tensor_(user_ptr, target_type, fp_shift, tensor, __FILE__, __LINE__)
 GIGA_API GIGA_error giga_copy_from_tensor_(void *user_ptr, GIGA_data_type target_type, uint32_t fp_shift, const GIGA_tensor_t *tensor, const char *file, int line);
 
+/*! \brief Description of interleaved images for \link giga_copy_image_to_tensor_ \endlink.
+ */
+GIGA_API typedef struct GIGA_image_t
+{
+    GIGA_data_type type;    //!< Type of the samples, GIGA_UFixed8 or GIGA_UFixed16 (e.g. 10 or 12 bits samples stored in 16 bits words).
+    uint32_t row_stride;    //!< Distance in bytes between the first samples of two consecutive rows, 0 for rows with no padding.
+    const float *mean;      //!< Per channel value subtracted from the samples, in sample units. NULL for 0.
+    const float *std;       //!< Per channel value dividing the centered samples, in sample units. NULL for 1.
+} GIGA_image_t;
+
+/*!
+ * \brief Copy interleaved images to a tensor
+ * This function is synchronous so you can safely discard the images after calling this function.
+ * It is intended to provide camera frames as input data without any preprocessing on the host.
+ *
+ * Images are provided in HWC order (interleaved channels, e.g. RGBRGB...), as produced by most cameras and image decoders. They are transposed to the
+ * CHW layout of the tensor, each sample being normalized as (sample - mean[c]) / std[c] and converted to the tensor type. Fixed point results are rounded
+ * to the nearest value of the representation given by tensor->fp_shift and saturated.
+ *
+ * The tensor must have 3 (CHW, one image) or 4 (NCHW, N images stored one after the other) dimensions.
+ *
+ * \param[in] user_ptr      A pointer to the images
+ * \param[in] image         A pointer to the description of the images
+ * \param[in] tensor        The destination tensor
+ * \param[in] file          The name of the source file where the GIGA function that raised the error has been asynchronously called
+ * \param[in] line          The line number in file
+ */
+#define giga_copy_image_to_tensor(user_ptr, image, tensor) giga_copy_image_to_tensor_(user_ptr, image, tensor, __FILE__, __LINE__)
+GIGA_API GIGA_error giga_copy_image_to_tensor_(const void *user_ptr, const GIGA_image_t *image, GIGA_tensor_t *tensor, const char *file, int line);
+
 /*!
  * @}
  */
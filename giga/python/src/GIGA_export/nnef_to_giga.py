@@ -43,7 +43,7 @@ class GIGA_sequential_memory_allocator:
         for s in shape:
             tensor_size *= int(s)
         tensor_offset = self.next
-        allocated_size = (tensor_size + 7) // 8 * 8 # Round to 8 bytes
+        allocated_size = (tensor_size + 63) // 64 * 64 # Round to 64 bytes (cache line) to keep offsets aligned
         self.next += allocated_size
         self.total_used += allocated_size
         
@@ -82,7 +82,7 @@ class GIGA_greedy_memory_allocator:
         for s in shape:
             tensor_size *= int(s)
 
-        allocated_size = (tensor_size + 7) // 8 * 8
+        allocated_size = (tensor_size + 63) // 64 * 64 # Round to 64 bytes (cache line) to keep offsets aligned
         
         tensor_offset = None
         best_match_size = self.memory_size + 1
@@ -253,7 +253,6 @@ class GIGA_Code_Generator:
                                      '    if(error != GIGA_Success)\n'
                                      '        return error;\n')
 
-        self.avg_pool_declared = False
         self.op_index = 0
 
         self.declared_tensors = set()  # Names mapped to offsets in their memory zones
@@ -326,20 +325,32 @@ class GIGA_Code_Generator:
                 else:
                     self.declare_conv(operation, with_relu=False, index=index)
                     
+            if operation.name == 'deconv':
+                ret, op = self.look_for_relu_after(operation)
+                # integrates the ReLU into the transposed convolutions
+                if ret:
+                    operation.outputs['output'] = op.outputs['y']
+                    self.declare_deconv(operation, with_relu=True, index=index)
+                else:
+                    self.declare_deconv(operation, with_relu=False, index=index)
+
             # TODO: support dense layers
 
             # We assume 'relu' as already processed as part of a previous layer (either conv or dense)
             if operation.name == 'relu':
                 continue
 
-            if operation.name == "avg_pool":
-                self.declare_avg_pool(operation, index)
+            if operation.name == "avg_pool" or operation.name == "max_pool":
+                self.declare_pool(operation, index)
+
+            if operation.name == "mean_reduce" or operation.name == "max_reduce":
+                self.declare_reduce(operation, index)
 
             if operation.name == "multilinear_upsample":
-                self.declare_nearest_upsample(operation, index)  # TODO Transform this into a proper multilinear
+                self.declare_upsample(operation, index)
 
             if operation.name == "nearest_upsample":
-                self.declare_nearest_upsample(operation, index)
+                self.declare_upsample(operation, index)
 
             if operation.name == "batch_normalization":
                 self.declare_batch_normalization(operation, index)
@@ -422,17 +433,16 @@ class GIGA_Code_Generator:
             "int16_t": 2
         }.get(c_type)
 
-    def declare_avg_pool(self, avg_operation: nnef.Operation, index) -> None:
+    def declare_pool(self, pool_operation: nnef.Operation, index) -> None:
         """
-        Declares average pooling operation using the convolution operation and a specially made tensor. Each channel is
-        convoluted by this tensor using views.
-        :param: avg_operation: The operation.
+        Declares an average or max pooling operation.
+        :param: pool_operation: The operation.
         :param: index: the index of the operation in the graph.
         :return: None
         """
         operation_name = f"op_{self.op_index}"
-        input_name = avg_operation.inputs['input']
-        output_name = avg_operation.outputs['output']
+        input_name = pool_operation.inputs['input']
+        output_name = pool_operation.outputs['output']
 
         prefix_i = "tensors"
         if input_name in self.graph.inputs or input_name in self.graph.outputs:
@@ -447,43 +457,106 @@ class GIGA_Code_Generator:
         if output_name not in self.declared_tensors:
             self.declare_tensor(self.graph.tensors[output_name])
 
-        nb_dims = len(self.graph.tensors[input_name].shape)
-        nb_chans = 1
-        if nb_dims > 2:
-            nb_chans = self.graph.tensors[input_name].shape[nb_dims - 3]
+        # Only the last two dimensions (H and W) can be pooled
+        in_shape = self.graph.tensors[input_name].shape
+        size = pool_operation.attribs['size'][-2:]
+        stride = pool_operation.attribs['stride'][-2:] if pool_operation.attribs['stride'] else [1, 1]
+        if any(s != 1 for s in pool_operation.attribs['size'][:-2]):
+            print("Pooling is only supported along H and W")
+            exit(-1)
 
-            # Declare views for each channels
-            for chan in range(nb_chans):
-                self.declare_slice(self.graph.tensors[input_name], nb_dims - 3, chan)
-                self.declare_slice(self.graph.tensors[output_name], nb_dims - 3, chan)
+        padding = pool_operation.attribs['padding'][-2:]
+        if not padding:
+            # Automatic padding as defined by NNEF
+            padding = []
+            for dim in range(2):
+                in_size = in_shape[len(in_shape) - 2 + dim]
+                out_size = (in_size + stride[dim] - 1) // stride[dim]
+                total = max((out_size - 1) * stride[dim] + size[dim] - in_size, 0)
+                padding.append((total // 2, total - total // 2))
+
+        mode = "GIGA_Pool_Max" if pool_operation.name == "max_pool" else "GIGA_Pool_Average"
+
+        # A window covering the whole feature map is a global pooling
+        if list(size) == list(in_shape[-2:]) and all(p == (0, 0) for p in padding):
+            self.declare_global_pool(input_name, output_name, mode, index)
+            return
 
-        kernel_name = self.declare_avg_pool_tensor()
+        # Padded pixels count as zeros ('constant') or are left out of the window ('ignore'), other borders are not supported
+        border = pool_operation.attribs['border']
+        if border not in ('constant', 'ignore') and any(p[0] or p[1] for p in padding):
+            print(f"Unsupported pooling border {border}")
+            exit(-1)
 
-        self.op_structure_string += f"    GIGA_conv2d_t {operation_name}_params;\n"
+        b_exclude_padding = "false" if border == 'constant' else "true"
+
+        self.op_structure_string += f"    GIGA_pool2d_t {operation_name}_params;\n"
         self.set_operations_string += ('\n'
-                                       f'    ops_params->{operation_name}_params = (GIGA_conv2d_t){{\n'
-                                        '        .padding = { { 1, 1 }, { 1, 1 } },\n'
-                                        '        .stride = { 2, 2 },\n'
-                                        '        .dilation = { 1, 1 },\n'
-                                        '        .b_ReLU = false,\n'
-                                       f'        .kernel = &tensors->{kernel_name},\n'
-                                        '        .bias = NULL,\n'
+                                       f'    ops_params->{operation_name}_params = (GIGA_pool2d_t){{\n'
+                                       f'        .mode = {mode},\n'
+                                       f'        .kernel_size = {{ {size[0]}, {size[1]} }},\n'
+                                       f'        .stride = {{ {stride[0]}, {stride[1]} }},\n'
+                                       f'        .padding = {{ {{ {padding[0][0]}, {padding[0][1]} }}, {{ {padding[1][0]}, {padding[1][1]} }} }},\n'
+                                       f'        .b_exclude_padding = {b_exclude_padding},\n'
                                         '        };\n')
 
         self.process_list[index] = ""
         if self.verbose_code:
             self.process_list[index] += f'    printf("{operation_name}\\n");\n'
-        if nb_dims > 2:
-            self.process_list[index] += "    /* Avg pooling */\n"
-            for chan in range(nb_chans):
-                self.process_list[index] += ('\n'
-                                 f'    if((error = giga_conv2d(&ops_params->{operation_name}_params, &tensors->{input_name}_{chan}, &tensors->{output_name}_{chan})) != GIGA_Success)\n'
-                                 '        return error;\n')
-        else:
-            self.process_list[index] += ('\n'
-                             f'    if((error = giga_conv2d(&ops_params->{operation_name}_params, &{prefix_i}->{input_name}, &{prefix_o}->{output_name})) != GIGA_Success)\n'
-                             '        return error;')
-            
+        self.process_list[index] += ('    /* Pooling */\n'
+                                     f'    if((error = giga_pool2d(&ops_params->{operation_name}_params, &{prefix_i}->{input_name}, &{prefix_o}->{output_name})) != GIGA_Success)\n'
+                                      '        return error;\n')
+
+    def declare_global_pool(self, input_name: str, output_name: str, mode: str, index) -> None:
+        """
+        Declares a global average or max pooling operation.
+        :param: input_name: The name of the input tensor.
+        :param: output_name: The name of the output tensor.
+        :param: mode: The GIGA pooling mode.
+        :param: index: the index of the operation in the graph.
+        :return: None
+        """
+        operation_name = f"op_{self.op_index}"
+
+        prefix_i = "tensors"
+        if input_name in self.graph.inputs or input_name in self.graph.outputs:
+            prefix_i = "io"
+
+        prefix_o = "tensors"
+        if output_name in self.graph.inputs or output_name in self.graph.outputs:
+            prefix_o = "io"
+
+        if input_name not in self.declared_tensors:
+            self.declare_tensor(self.graph.tensors[input_name])
+        if output_name not in self.declared_tensors:
+            self.declare_tensor(self.graph.tensors[output_name])
+
+        self.op_structure_string += f"    GIGA_global_pool_t {operation_name}_params;\n"
+        self.set_operations_string += f"\n    ops_params->{operation_name}_params.mode = {mode};\n"
+
+        self.process_list[index] = ""
+        if self.verbose_code:
+            self.process_list[index] += f'    printf("{operation_name}\\n");\n'
+        self.process_list[index] += ('    /* Global pooling */\n'
+                                     f'    if((error = giga_global_pool(&ops_params->{operation_name}_params, &{prefix_i}->{input_name}, &{prefix_o}->{output_name})) != GIGA_Success)\n'
+                                      '        return error;\n')
+
+    def declare_reduce(self, reduce_operation: nnef.Operation, index) -> None:
+        """
+        Declares a mean or max reduction over the H and W dimensions as a global pooling operation.
+        :param: reduce_operation: The operation.
+        :param: index: the index of the operation in the graph.
+        :return: None
+        """
+        input_name = reduce_operation.inputs['input']
+        nb_dims = len(self.graph.tensors[input_name].shape)
+        if sorted(reduce_operation.attribs['axes']) != [nb_dims - 2, nb_dims - 1]:
+            print(f"Unsupported {reduce_operation.name} axes {reduce_operation.attribs['axes']}")
+            exit(-1)
+
+        mode = "GIGA_Pool_Max" if reduce_operation.name == "max_reduce" else "GIGA_Pool_Average"
+        self.declare_global_pool(input_name, reduce_operation.outputs['output'], mode, index)
+
     def set_tensor_params(self, tensor_type, fp_shift, shape) -> str:
         nb_dims = len(shape)
         ret = (f'(GIGA_tensor_t){{\n'
@@ -561,21 +634,32 @@ class GIGA_Code_Generator:
                                           '        return error;\n'
                                           '\n')
 
-    def declare_nearest_upsample(self, nearest_upsample_operation: nnef.Operation, index) -> None:
+    def declare_upsample(self, upsample_operation: nnef.Operation, index) -> None:
         """
-
-        :param nearest_upsample_operation:
-        :param index:
-        :return:
+        Declares a nearest or multilinear upsampling operation.
+        :param upsample_operation: The operation.
+        :param index: the index of the operation in the graph.
+        :return: None
         """
 
-        if nearest_upsample_operation.attribs['factor'][0] != 2 or nearest_upsample_operation.attribs['factor'][1] != 2:
+        factor = upsample_operation.attribs['factor']
+        if len(factor) != 2 or factor[0] != factor[1]:
             print("Wrong upsampling factor")
             exit(-1)
 
+        if upsample_operation.name == "nearest_upsample":
+            mode = "GIGA_Upsample_Nearest"
+        elif upsample_operation.attribs['method'] == "aligned":
+            mode = "GIGA_Upsample_Bilinear_Align_Corners"
+        elif upsample_operation.attribs['method'] == "symmetric" and upsample_operation.attribs['border'] == "replicate":
+            mode = "GIGA_Upsample_Bilinear"
+        else:
+            print(f"Unsupported multilinear upsampling method {upsample_operation.attribs['method']} with border {upsample_operation.attribs['border']}")
+            exit(-1)
+
         operation_name = f"op_{self.op_index}"
-        input_name = nearest_upsample_operation.inputs['input']
-        output_name = nearest_upsample_operation.outputs['output']
+        input_name = upsample_operation.inputs['input']
+        output_name = upsample_operation.outputs['output']
 
         if input_name not in self.declared_tensors:
             self.declare_tensor(self.graph.tensors[input_name])
@@ -591,12 +675,14 @@ class GIGA_Code_Generator:
             prefix_o = "io"
 
         self.op_structure_string += f"    GIGA_upsample_t {operation_name}_params;\n"
-        self.set_operations_string += f"\n    ops_params->{operation_name}_params.factor = 2;\n"
+        self.set_operations_string += (f"\n    ops_params->{operation_name}_params.factor = {factor[0]};\n"
+                                       f"    ops_params->{operation_name}_params.mode = {mode};\n"
+                                       f"    ops_params->{operation_name}_params.addend = NULL;\n")
 
         self.process_list[index] = ""
         if self.verbose_code:
             self.process_list[index] += f'    printf("{operation_name}\\n");\n'
-        self.process_list[index] += ('    /* Nearest upsampling */\n'
+        self.process_list[index] += ('    /* Upsampling */\n'
                                      f'    if((error = giga_upsample(&ops_params->{operation_name}_params, &{prefix_i}->{input_name}, &{prefix_o}->{output_name})) != GIGA_Success)\n'
                                       '        return error;\n')
 
@@ -749,26 +835,6 @@ class GIGA_Code_Generator:
 
         return False, None
 
-    def declare_avg_pool_tensor(self) -> str:
-        """
-        :return: The name of the declared tensor
-        """
-        tensor_name = "avg_pool_kernel"
-        if self.avg_pool_declared:
-            return tensor_name
-
-        self.declare_tensor({'name':tensor_name, 'shape': [1,1,3,3]})
-
-        # Fill the upper half of the tensor
-        self.fill_string += ('\n'
-                             f'    {self.intermediate_type} data_{tensor_name}[] = {{0.0, 0.0, 0.0, 0.0, 0.25, 0.25, 0.0, 0.25, 0.25}};\n'
-                             f'    if ((error = giga_copy_to_tensor(data_{tensor_name}, {self.giga_intermediate_type}, 0, &tensors->{tensor_name})) != GIGA_Succes)\n'
-                              '        return error;\n')
-
-        self.avg_pool_declared = True
-        self.kernels.add(tensor_name)
-        return tensor_name
-
     def declare_tensor(self, tensor, is_view: bool = False) -> int:
         """
 
@@ -1007,6 +1073,66 @@ class GIGA_Code_Generator:
         self.process_list[index] += (f'    if((error = giga_conv2d(&ops_params->{operation_name}_params, &{prefix_i}->{input_name}, &{prefix_o}->{output_name})) != GIGA_Success)\n'
                                       '        return error;\n')
 
+    def declare_deconv(self, deconv_operation: nnef.Operation, with_relu: bool, index) -> None:
+        """
+        Declares a stride 2 transposed convolution.
+        :param: deconv_operation: The operation.
+        :param: with_relu: If true, the following ReLU is applied by the transposed convolution.
+        :param: index: the index of the operation in the graph.
+        :return: None
+        """
+
+        operation_name = f"op_{self.op_index}"
+        kernel_name = deconv_operation.inputs['filter']
+        kernel_shape = self.graph.tensors[kernel_name].shape
+        self.kernels.add(kernel_name)
+        bias_name = deconv_operation.inputs['bias']
+        self.biases.add(bias_name)
+        stride = deconv_operation.attribs['stride']
+        if list(stride) != [2, 2]:
+            print(f"Unsupported transposed convolution stride {stride}")
+            exit(-1)
+        with_relu = str(with_relu).lower()
+        input_name = deconv_operation.inputs['input']
+        output_name = deconv_operation.outputs['output']
+
+        padding = [list(p) for p in deconv_operation.attribs['padding']]
+        if not padding:
+            # Automatic padding crops the full output to twice the input size
+            padding = []
+            for dim in range(2):
+                total = kernel_shape[2 + dim] - 2
+                padding.append([total // 2, total - total // 2])
+
+        if input_name not in self.declared_tensors:
+            self.declare_tensor(self.graph.tensors[input_name])
+        if output_name not in self.declared_tensors:
+            self.declare_tensor(self.graph.tensors[output_name])
+
+        self.op_structure_string += f"    GIGA_conv2d_transpose_t {operation_name}_params;\n"
+        self.set_operations_string += ( '\n'
+                                       f'    ops_params->{operation_name}_params = (GIGA_conv2d_transpose_t){{\n'
+                                       f'        .padding = {{ {{ {padding[0][0]}, {padding[0][1]} }}, {{ {padding[1][0]}, {padding[1][1]} }} }},\n'
+                                        '        .stride = { 2, 2 },\n'
+                                       f'        .b_ReLU = {with_relu},\n'
+                                       f'        .kernel = &tensors->{kernel_name},\n'
+                                       f'        .bias = &tensors->{bias_name}\n'
+                                        '        };\n')
+
+        prefix_i = "tensors"
+        if input_name in self.graph.inputs or input_name in self.graph.outputs:
+            prefix_i = "io"
+
+        prefix_o = "tensors"
+        if output_name in self.graph.inputs or output_name in self.graph.outputs:
+            prefix_o = "io"
+
+        self.process_list[index] = '    /* Transposed convolution */\n'
+        if self.verbose_code:
+            self.process_list[index] += f'    printf("{operation_name}\\n");\n'
+        self.process_list[index] += (f'    if((error = giga_conv2d_transpose(&ops_params->{operation_name}_params, &{prefix_i}->{input_name}, &{prefix_o}->{output_name})) != GIGA_Success)\n'
+                                      '        return error;\n')
+
     def get_full_c_file_string(self):
         return self.header_string + "\n" \
                + self.initialize_string + "\n" \
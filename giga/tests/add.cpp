@@ -5,6 +5,8 @@
 #include <giga/giga.h>
 #include "utils.h"
 
+#include <algorithm>
+
 GIGA_error addition_test(GIGA_data_type GT, uint8_t a_shift = 0, uint8_t b_shift = 0, uint8_t out_shift = 0)
 {
     ScopedMessage msg;
@@ -35,7 +37,7 @@ GIGA_error addition_test(GIGA_data_type GT, uint8_t a_shift = 0, uint8_t b_shift
     GIGA_allocate_t a_params;
     a_params.memory_zone_id = 0;
     a_params.offset = offset;
-    offset += tensor_size_in_bytes(&a);
+    offset += align_address(tensor_size_in_bytes(&a), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&a, &a_params)) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor a" << std::endl;
@@ -74,7 +76,7 @@ GIGA_error addition_test(GIGA_data_type GT, uint8_t a_shift = 0, uint8_t b_shift
     GIGA_allocate_t b_params;
     b_params.memory_zone_id = 0;
     b_params.offset = offset;
-    offset += tensor_size_in_bytes(&b);
+    offset += align_address(tensor_size_in_bytes(&b), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&b, &b_params) ) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor b" << std::endl;
@@ -107,7 +109,7 @@ GIGA_error addition_test(GIGA_data_type GT, uint8_t a_shift = 0, uint8_t b_shift
     GIGA_allocate_t out_params;
     out_params.memory_zone_id = 0;
     out_params.offset = offset;
-    offset += tensor_size_in_bytes(&out);
+    offset += align_address(tensor_size_in_bytes(&out), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&out, &out_params) ) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor out" << std::endl;
@@ -144,7 +146,7 @@ GIGA_error addition_test(GIGA_data_type GT, uint8_t a_shift = 0, uint8_t b_shift
     GIGA_allocate_t result_params;
     result_params.memory_zone_id = 0;
     result_params.offset = offset;
-    offset += tensor_size_in_bytes(&result);
+    offset += align_address(tensor_size_in_bytes(&result), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&result, &result_params) ) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor result" << std::endl;
@@ -204,6 +206,470 @@ GIGA_error addition_test(GIGA_data_type GT, uint8_t a_shift = 0, uint8_t b_shift
     return GIGA_Success;
 }
 
+GIGA_error addition_view_test(GIGA_data_type GT)
+{
+    ScopedMessage msg;
+    msg << "Add on views " << giga_data_type_str(GT) << "\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+        return error;
+
+    size_t offset = 0;
+
+    // a is read through a view with holes on both spatial dimensions
+    GIGA_tensor_t a_parent;
+    a_parent.nb_dims = 4;
+    a_parent.dims[0] = 1;
+    a_parent.dims[1] = 2;
+    a_parent.dims[2] = 7;
+    a_parent.dims[3] = 9;
+    a_parent.device_id = device_id;
+    a_parent.type = GT;
+    a_parent.data = NULL;
+    a_parent.fp_shift = 0;
+
+    GIGA_allocate_t a_parent_params;
+    a_parent_params.memory_zone_id = 0;
+    a_parent_params.offset = offset;
+    offset += align_address(tensor_size_in_bytes(&a_parent), TENSOR_ALIGNMENT);
+    if((error = giga_allocate_tensor(&a_parent, &a_parent_params)) != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor a_parent" << std::endl;
+        return error;
+    }
+
+    std::vector<float> data_a_parent(2 * 7 * 9);
+    for(size_t i = 0; i < data_a_parent.size(); ++i)
+        data_a_parent[i] = float(i % 11);
+
+    if ((error = giga_copy_to_tensor(data_a_parent.data(), GIGA_Float32, 0, &a_parent)) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error filling tensor with data" << std::endl;
+        return error;
+    }
+
+    GIGA_tensor_t a;
+    a.nb_dims = 4;
+    a.dims[0] = 1;
+    a.dims[1] = 2;
+    a.dims[2] = 5;
+    a.dims[3] = 5;
+    a.device_id = device_id;
+    a.type = GT;
+    a.data = NULL;
+    a.fp_shift = 0;
+
+    GIGA_view_t a_view_params;
+    a_view_params.offset[0] = 0;
+    a_view_params.offset[1] = 0;
+    a_view_params.offset[2] = 1;
+    a_view_params.offset[3] = 2;
+    if((error = giga_view(&a_view_params, &a_parent, &a)) != GIGA_Success)
+    {
+        std::cerr << "Error creating view a" << std::endl;
+        return error;
+    }
+
+    GIGA_tensor_t b;
+    b.nb_dims = 4;
+    b.dims[0] = 1;
+    b.dims[1] = 2;
+    b.dims[2] = 5;
+    b.dims[3] = 5;
+    b.device_id = device_id;
+    b.type = GT;
+    b.data = NULL;
+    b.fp_shift = 0;
+
+    GIGA_allocate_t b_params;
+    b_params.memory_zone_id = 0;
+    b_params.offset = offset;
+    offset += align_address(tensor_size_in_bytes(&b), TENSOR_ALIGNMENT);
+    if((error = giga_allocate_tensor(&b, &b_params)) != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor b" << std::endl;
+        return error;
+    }
+
+    std::vector<float> data_b(2 * 5 * 5);
+    for(size_t i = 0; i < data_b.size(); ++i)
+        data_b[i] = float((i * 7) % 13);
+
+    if ((error = giga_copy_to_tensor(data_b.data(), GIGA_Float32, 0, &b)) != GIGA_Success)
+    {
+        std::cerr << "Error filling tensor with data" << std::endl;
+        return error;
+    }
+
+    // out is the second half of a concatenation along channels
+    GIGA_tensor_t concat;
+    concat.nb_dims = 4;
+    concat.dims[0] = 1;
+    concat.dims[1] = 3;
+    concat.dims[2] = 5;
+    concat.dims[3] = 5;
+    concat.device_id = device_id;
+    concat.type = GT;
+    concat.data = NULL;
+    concat.fp_shift = 0;
+
+    GIGA_allocate_t concat_params;
+    concat_params.memory_zone_id = 0;
+    concat_params.offset = offset;
+    offset += align_address(tensor_size_in_bytes(&concat), TENSOR_ALIGNMENT);
+    if((error = giga_allocate_tensor(&concat, &concat_params)) != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor concat" << std::endl;
+        return error;
+    }
+
+    const std::vector<float> data_concat(3 * 5 * 5, 3.f);
+    if ((error = giga_copy_to_tensor(data_concat.data(), GIGA_Float32, 0, &concat)) != GIGA_Success)
+    {
+        std::cerr << "Error filling tensor with data" << std::endl;
+        return error;
+    }
+
+    GIGA_tensor_t out;
+    out.nb_dims = 4;
+    out.dims[0] = 1;
+    out.dims[1] = 2;
+    out.dims[2] = 5;
+    out.dims[3] = 5;
+    out.device_id = device_id;
+    out.type = GT;
+    out.data = NULL;
+    out.fp_shift = 0;
+
+    GIGA_view_t out_view_params;
+    out_view_params.offset[0] = 0;
+    out_view_params.offset[1] = 1;
+    out_view_params.offset[2] = 0;
+    out_view_params.offset[3] = 0;
+    if((error = giga_view(&out_view_params, &concat, &out)) != GIGA_Success)
+    {
+        std::cerr << "Error creating view out" << std::endl;
+        return error;
+    }
+
+    GIGA_add_t add_params;
+    if((error = giga_add(&add_params, &a, &b, &out) ) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing add on a and b to out" << std::endl;
+        return error;
+    }
+
+    // The first channel of the concatenation must not have been touched
+    std::vector<float> data_result(3 * 5 * 5, 3.f);
+    for(uint32_t c = 0; c < 2; ++c)
+        for(uint32_t y = 0; y < 5; ++y)
+            for(uint32_t x = 0; x < 5; ++x)
+                data_result[((c + 1) * 5 + y) * 5 + x] = data_a_parent[(c * 7 + y + 1) * 9 + x + 2] + data_b[(c * 5 + y) * 5 + x];
+
+    GIGA_tensor_t result = concat;
+    result.data = NULL;
+
+    GIGA_allocate_t result_params;
+    result_params.memory_zone_id = 0;
+    result_params.offset = offset;
+    offset += align_address(tensor_size_in_bytes(&result), TENSOR_ALIGNMENT);
+    if((error = giga_allocate_tensor(&result, &result_params) ) != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor result" << std::endl;
+        return error;
+    }
+
+    if ((error = giga_copy_to_tensor(data_result.data(), GIGA_Float32, 0, &result)) != GIGA_Success)
+    {
+        std::cerr << "Error filling tensor with data" << std::endl;
+        return error;
+    }
+
+    if(!compare_tensors(&concat, &result))
+    {
+        print_tensor(msg, a, "a");
+        print_tensor(msg, b, "b");
+        print_tensor(msg, concat, "concat");
+        print_tensor(msg, result, "result");
+        std::cerr << "Error comparing tensors" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    //Clean up
+    for(GIGA_tensor_t *tensor : {&a, &out, &a_parent, &b, &concat, &result})
+    {
+        if((error = giga_release_tensor(tensor) ) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return error;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
+GIGA_error addition_saturation_test(GIGA_data_type GT, uint8_t out_shift = 0)
+{
+    ScopedMessage msg;
+    msg << "Add saturation " << giga_data_type_str(GT) << " " << int(out_shift) << "\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+        return error;
+
+    float max_value = 0.f;
+    switch(GT)
+    {
+    case GIGA_SFixed8:  max_value = 127.f;      break;
+    case GIGA_SFixed16: max_value = 32767.f;    break;
+    case GIGA_UFixed8:  max_value = 255.f;      break;
+    case GIGA_UFixed16: max_value = 65535.f;    break;
+    default:
+        msg.clear();
+        return GIGA_Success;
+    }
+    const float min_value = is_signed(GT) ? -max_value - 1.f : 0.f;
+
+    const float data_a[4] = {max_value - 10.f, min_value, max_value, 10.f};
+    const float data_b[4] = {20.f, is_signed(GT) ? -1.f : 0.f, max_value, 5.f};
+    //The output representation may be too small for the inputs, large shifts must not overflow the intermediate sums
+    const float out_max = std::ldexp(max_value, -int(out_shift));
+    const float out_min = std::ldexp(min_value, -int(out_shift));
+    const float data_result[4] = {out_max, out_min, out_max, std::min(15.f, out_max)};
+
+    size_t offset = 0;
+
+    GIGA_tensor_t tensors[4];
+    const float * const data[4] = {data_a, data_b, nullptr, data_result};
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = 1;
+        tensor.dims[0] = 4;
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = i < 2 ? 0 : out_shift;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return error;
+        }
+
+        if(data[i] && (error = giga_copy_to_tensor(data[i], GIGA_Float32, 0, &tensor)) != GIGA_Success)
+        {
+            std::cerr << "Error filling tensor with data" << std::endl;
+            return error;
+        }
+    }
+
+    GIGA_add_t add_params;
+    if((error = giga_add(&add_params, &tensors[0], &tensors[1], &tensors[2]) ) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing add on a and b to out" << std::endl;
+        return error;
+    }
+
+    if(!compare_tensors(&tensors[2], &tensors[3]))
+    {
+        print_tensor(msg, tensors[2], "out");
+        print_tensor(msg, tensors[3], "result");
+        std::cerr << "Error comparing tensors" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    //Clean up
+    for(GIGA_tensor_t &tensor : tensors)
+    {
+        if((error = giga_release_tensor(&tensor) ) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return error;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
+GIGA_error addition_broadcast_test(GIGA_data_type GT, const std::vector<uint32_t> &a_dims, const std::vector<uint32_t> &b_dims)
+{
+    ScopedMessage msg;
+    msg << "Add with broadcasting " << giga_data_type_str(GT) << ", a (";
+    for(const uint32_t dim : a_dims)
+        msg << " " << dim;
+    msg << " ), b (";
+    for(const uint32_t dim : b_dims)
+        msg << " " << dim;
+    msg << " )\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+        return error;
+
+    // Broadcast shape, right aligned
+    const uint32_t nb_dims = std::max(a_dims.size(), b_dims.size());
+    std::vector<uint32_t> a_full(nb_dims, 1), b_full(nb_dims, 1), out_dims(nb_dims);
+    std::copy(a_dims.begin(), a_dims.end(), a_full.end() - a_dims.size());
+    std::copy(b_dims.begin(), b_dims.end(), b_full.end() - b_dims.size());
+    for(uint32_t i = 0; i < nb_dims; ++i)
+        out_dims[i] = std::max(a_full[i], b_full[i]);
+
+    size_t offset = 0;
+
+    GIGA_tensor_t tensors[4];
+    const std::vector<uint32_t> * const dims[4] = {&a_dims, &b_dims, &out_dims, &out_dims};
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = dims[i]->size();
+        for(uint32_t d = 0; d < tensor.nb_dims; ++d)
+            tensor.dims[d] = (*dims[i])[d];
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = 0;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return error;
+        }
+    }
+    GIGA_tensor_t &a = tensors[0];
+    GIGA_tensor_t &b = tensors[1];
+    GIGA_tensor_t &out = tensors[2];
+    GIGA_tensor_t &result = tensors[3];
+
+    std::vector<float> data_a(tensor_elements_count(&a));
+    std::vector<float> data_b(tensor_elements_count(&b));
+    for(size_t i = 0; i < data_a.size(); ++i)
+        data_a[i] = float(i % 10);
+    for(size_t i = 0; i < data_b.size(); ++i)
+        data_b[i] = float((i * 3) % 7);
+
+    if ((error = giga_copy_to_tensor(data_a.data(), GIGA_Float32, 0, &a)) != GIGA_Success
+        || (error = giga_copy_to_tensor(data_b.data(), GIGA_Float32, 0, &b)) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error filling tensor with data" << std::endl;
+        return error;
+    }
+
+    // Fill output with garbage to make sure we don't test an unwritten tensor
+    fill_contiguous_tensor_with_random_data(out, 0.f, 100.f);
+
+    GIGA_add_t add_params;
+    if((error = giga_add(&add_params, &a, &b, &out) ) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing add on a and b to out" << std::endl;
+        return error;
+    }
+
+    // Reference computed on the host
+    std::vector<float> data_result(tensor_elements_count(&out));
+    for(size_t i = 0; i < data_result.size(); ++i)
+    {
+        size_t rem = i;
+        size_t a_index = 0, b_index = 0, a_stride = 1, b_stride = 1;
+        for(int32_t d = nb_dims - 1; d >= 0; --d)
+        {
+            const size_t idx = rem % out_dims[d];
+            rem /= out_dims[d];
+            a_index += (a_full[d] == 1 ? 0 : idx) * a_stride;
+            b_index += (b_full[d] == 1 ? 0 : idx) * b_stride;
+            a_stride *= a_full[d];
+            b_stride *= b_full[d];
+        }
+        data_result[i] = data_a[a_index] + data_b[b_index];
+    }
+
+    if ((error = giga_copy_to_tensor(data_result.data(), GIGA_Float32, 0, &result)) != GIGA_Success)
+    {
+        std::cerr << "Error filling tensor with data" << std::endl;
+        return error;
+    }
+
+    if(!compare_tensors(&out, &result))
+    {
+        print_tensor(msg, a, "a");
+        print_tensor(msg, b, "b");
+        print_tensor(msg, out, "out");
+        print_tensor(msg, result, "result");
+        std::cerr << "Error comparing tensors" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    //Clean up
+    for(GIGA_tensor_t &tensor : tensors)
+    {
+        if((error = giga_release_tensor(&tensor) ) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return error;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
 int main()
 {
     GIGA_error error = GIGA_Success;
@@ -229,6 +695,27 @@ int main()
                 }
             }
         }
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_SFixed8, GIGA_SFixed16, GIGA_UFixed8, GIGA_UFixed16})
+        {
+            if((error = addition_view_test(GT)) != GIGA_Success)
+                EARLY_ABORT();
+            for(uint8_t out_shift : {0, 7, 15, 24})
+            {
+                if((error = addition_saturation_test(GT, out_shift)) != GIGA_Success)
+                    EARLY_ABORT();
+            }
+            // Per channel, per pixel, per row and two sided broadcasts
+            if((error = addition_broadcast_test(GT, {2, 3, 4, 5}, {3, 1, 1})) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = addition_broadcast_test(GT, {1, 3, 1, 1}, {2, 3, 4, 5})) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = addition_broadcast_test(GT, {2, 3, 4, 5}, {4, 5})) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = addition_broadcast_test(GT, {2, 3, 4, 5}, {2, 1, 1, 5})) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = addition_broadcast_test(GT, {2, 1, 4, 1}, {3, 1, 5})) != GIGA_Success)
+                EARLY_ABORT();
+        }
     }
     catch(const std::exception &e)
     {
@@ -4,6 +4,39 @@
  */
 #include <giga/giga.h>
 #include "utils.h"
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <sched.h>
+
+//Weights written to the file mapped as memory zone 1, after a header as in exported networks
+static const uint32_t WEIGHTS_OFFSET = 4096;
+static const uint32_t NB_WEIGHTS = 256;
+
+inline float weight_value(uint32_t i)   {   return float(i) * 0.5f - 32.f;   }
+
+//Writes the blob of weights to a temporary file and returns its path (empty on error)
+std::string write_weights_file()
+{
+    char path[] = "/tmp/giga_allocation_XXXXXX";
+    const int fd = mkstemp(path);
+    if(fd < 0)
+        return std::string();
+
+    std::vector<float> weights(NB_WEIGHTS);
+    for(uint32_t i = 0; i < NB_WEIGHTS; ++i)
+        weights[i] = weight_value(i);
+    const std::vector<char> header(WEIGHTS_OFFSET, 'H');
+    const bool b_written = write(fd, header.data(), header.size()) == ssize_t(header.size())
+                        && write(fd, weights.data(), NB_WEIGHTS * sizeof(float)) == ssize_t(NB_WEIGHTS * sizeof(float));
+    close(fd);
+    if(!b_written)
+    {
+        unlink(path);
+        return std::string();
+    }
+    return path;
+}
 
 GIGA_error allocation_test(GIGA_data_type GT)
 {
@@ -34,7 +67,7 @@ GIGA_error allocation_test(GIGA_data_type GT)
         GIGA_allocate_t tensor_params;
         tensor_params.memory_zone_id = 0;
         tensor_params.offset = offset;
-        offset += tensor_size_in_bytes(&tensor);
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
         if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
         {
             std::cerr << "Allocation failed!" << std::endl;
@@ -69,7 +102,7 @@ GIGA_error allocation_test(GIGA_data_type GT)
         GIGA_allocate_t tensor_params;
         tensor_params.memory_zone_id = 0;
         tensor_params.offset = offset;
-        offset += tensor_size_in_bytes(&tensor);
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
         if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
         {
             std::cerr << "Allocation failed!" << std::endl;
@@ -112,7 +145,7 @@ GIGA_error allocation_test(GIGA_data_type GT)
         GIGA_allocate_t tensor_params;
         tensor_params.memory_zone_id = 0;
         tensor_params.offset = offset;
-        offset += tensor_size_in_bytes(&tensor);
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
         if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
         {
             std::cerr << "Allocation failed!" << std::endl;
@@ -136,15 +169,461 @@ GIGA_error allocation_test(GIGA_data_type GT)
         msg.clear();
     }
 
+    //Testing allocation at a misaligned offset
+    {
+        ScopedMessage msg("Error allocating misaligned tensor");
+        GIGA_tensor_t tensor;
+        tensor.nb_dims = 1;
+        tensor.dims[0] = 5;
+        tensor.device_id = device_id;
+        tensor.type = GT;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset + 1;
+        if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Bad_Memory_Alignment)
+        {
+            std::cerr << "Misaligned allocation was not rejected!" << std::endl;
+            if(error == GIGA_Success)
+                giga_release_tensor(&tensor);
+            return GIGA_Unknown_Error;
+        }
+
+        msg.clear();
+    }
+
     const std::string line = msg.message();
     msg.replaceMessage(line.substr(0, line.find('\n')));
     return GIGA_Success;
 }
 
+//Fills a tensor allocated at an automatic offset with values depending on seed
+GIGA_error auto_allocate(GIGA_tensor_t *tensor, uint32_t size, uint32_t device_id, float seed)
+{
+    tensor->nb_dims = 1;
+    tensor->dims[0] = size;
+    tensor->device_id = device_id;
+    tensor->type = GIGA_Float32;
+    tensor->fp_shift = 0;
+
+    GIGA_allocate_t tensor_params;
+    tensor_params.memory_zone_id = 0;
+    tensor_params.offset = GIGA_AUTO_OFFSET;
+    GIGA_error error;
+    if((error = giga_allocate_tensor(tensor, &tensor_params)) != GIGA_Success)
+        return error;
+
+    std::vector<float> data(size);
+    for(uint32_t i = 0; i < size; ++i)
+        data[i] = seed + float(i);
+    return giga_copy_to_tensor(data.data(), GIGA_Float32, 0, tensor);
+}
+
+//Checks the values written by auto_allocate have not been overwritten by another tensor
+bool check_values(const GIGA_tensor_t *tensor, float seed)
+{
+    std::vector<float> data(tensor->dims[0]);
+    if(giga_copy_from_tensor(data.data(), GIGA_Float32, 0, tensor) != GIGA_Success)
+        return false;
+    for(uint32_t i = 0; i < tensor->dims[0]; ++i)
+        if(data[i] != seed + float(i))
+            return false;
+    return true;
+}
+
+GIGA_error auto_offset_test()
+{
+    ScopedMessage msg("Automatic offsets\n");
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+       return error;
+
+    //Tensors of automatic offsets must not overlap
+    GIGA_tensor_t a, b, c;
+    if((error = auto_allocate(&a, 1000, device_id, 1000.f)) != GIGA_Success)   return error;
+    if((error = auto_allocate(&b, 77, device_id, 2000.f)) != GIGA_Success)     return error;
+    if((error = auto_allocate(&c, 333, device_id, 3000.f)) != GIGA_Success)    return error;
+    if(!check_values(&a, 1000.f) || !check_values(&b, 2000.f) || !check_values(&c, 3000.f))
+    {
+        std::cerr << "Tensors allocated at automatic offsets overlap!" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    //Released memory is reused without overlapping the remaining tensors
+    if((error = giga_release_tensor(&b)) != GIGA_Success)                       return error;
+    if((error = auto_allocate(&b, 50, device_id, 4000.f)) != GIGA_Success)     return error;
+    if(!check_values(&a, 1000.f) || !check_values(&b, 4000.f) || !check_values(&c, 3000.f))
+    {
+        std::cerr << "Tensor allocated in released memory overlaps!" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    //Allocating and releasing large tensors many times only succeeds if their memory is reused
+    for(int i = 0; i < 256; ++i)
+    {
+        GIGA_tensor_t large;
+        if((error = auto_allocate(&large, 1 << 20, device_id, float(i))) != GIGA_Success)
+        {
+            std::cerr << "Released memory is not reused!" << std::endl;
+            return error;
+        }
+        if((error = giga_release_tensor(&large)) != GIGA_Success)
+            return error;
+    }
+
+    //Tensors larger than the free memory are refused
+    {
+        GIGA_tensor_t huge;
+        huge.nb_dims = 2;
+        huge.dims[0] = 1 << 14;
+        huge.dims[1] = 1 << 14;
+        huge.device_id = device_id;
+        huge.type = GIGA_Float32;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = GIGA_AUTO_OFFSET;
+        if(giga_allocate_tensor(&huge, &tensor_params) != GIGA_Out_Of_Device_Memory)
+        {
+            std::cerr << "Allocation larger than the memory zone was not refused!" << std::endl;
+            return GIGA_Unknown_Error;
+        }
+    }
+
+    //The memory of a released tensor is not reused while one of its views is alive
+    {
+        GIGA_tensor_t view;
+        view.nb_dims = 1;
+        view.dims[0] = 1000;
+        view.device_id = device_id;
+        view.type = GIGA_Float32;
+        view.fp_shift = 0;
+        GIGA_view_t view_params;
+        view_params.offset[0] = 0;
+        if((error = giga_view(&view_params, &a, &view)) != GIGA_Success)            return error;
+        if((error = giga_release_tensor(&a)) != GIGA_Success)                       return error;
+        if((error = auto_allocate(&a, 1000, device_id, 5000.f)) != GIGA_Success)   return error;
+        if(!check_values(&view, 1000.f) || !check_values(&a, 5000.f))
+        {
+            std::cerr << "Tensor allocated in the memory of a view overlaps!" << std::endl;
+            return GIGA_Unknown_Error;
+        }
+        if((error = giga_release_tensor(&view)) != GIGA_Success)                    return error;
+    }
+
+    if((error = giga_release_tensor(&a)) != GIGA_Success)   return error;
+    if((error = giga_release_tensor(&b)) != GIGA_Success)   return error;
+    if((error = giga_release_tensor(&c)) != GIGA_Success)   return error;
+
+    msg.replaceMessage("Automatic offsets");
+    return GIGA_Success;
+}
+
+GIGA_error import_test()
+{
+    ScopedMessage msg("Imported tensors\n");
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+       return error;
+
+    //A 2x3x4 tensor whose rows are padded to 6 values in the user buffer
+    std::vector<float> buffer(2 * 3 * 6, -1.f);
+    for(uint32_t c = 0; c < 2; ++c)
+        for(uint32_t y = 0; y < 3; ++y)
+            for(uint32_t x = 0; x < 4; ++x)
+                buffer[(c * 3 + y) * 6 + x] = float(c * 100 + y * 10 + x);
+
+    GIGA_tensor_t tensor;
+    tensor.nb_dims = 3;
+    tensor.dims[0] = 2;
+    tensor.dims[1] = 3;
+    tensor.dims[2] = 4;
+    tensor.strides[0] = 3 * 6 * sizeof(float);
+    tensor.strides[1] = 6 * sizeof(float);
+    tensor.strides[2] = sizeof(float);
+    tensor.device_id = device_id;
+    tensor.type = GIGA_Float32;
+    tensor.fp_shift = 0;
+    if((error = giga_import_tensor(&tensor, buffer.data())) != GIGA_Success)
+    {
+        std::cerr << "Import failed!" << std::endl;
+        return error;
+    }
+
+    //Values are read in place
+    std::vector<float> data(2 * 3 * 4);
+    if((error = giga_copy_from_tensor(data.data(), GIGA_Float32, 0, &tensor)) != GIGA_Success)
+        return error;
+    for(uint32_t i = 0; i < data.size(); ++i)
+    {
+        if(data[i] != float((i / 12) * 100 + (i / 4 % 3) * 10 + i % 4))
+        {
+            std::cerr << "Wrong value read from an imported tensor!" << std::endl;
+            return GIGA_Unknown_Error;
+        }
+    }
+
+    //Writing to the tensor writes to the user buffer, padding excluded
+    for(uint32_t i = 0; i < data.size(); ++i)
+        data[i] = float(i);
+    if((error = giga_copy_to_tensor(data.data(), GIGA_Float32, 0, &tensor)) != GIGA_Success)
+        return error;
+
+    GIGA_tensor_t view;
+    view.nb_dims = 3;
+    view.dims[0] = 1;
+    view.dims[1] = 2;
+    view.dims[2] = 2;
+    view.device_id = device_id;
+    view.type = GIGA_Float32;
+    view.fp_shift = 0;
+    GIGA_view_t view_params;
+    view_params.offset[0] = 1;
+    view_params.offset[1] = 1;
+    view_params.offset[2] = 2;
+    if((error = giga_view(&view_params, &tensor, &view)) != GIGA_Success)
+        return error;
+    std::vector<float> view_data(4);
+    if((error = giga_copy_from_tensor(view_data.data(), GIGA_Float32, 0, &view)) != GIGA_Success)
+        return error;
+    if((error = giga_release_tensor(&view)) != GIGA_Success)
+        return error;
+    if((error = giga_release_tensor(&tensor)) != GIGA_Success)
+        return error;
+
+    for(uint32_t c = 0; c < 2; ++c)
+        for(uint32_t y = 0; y < 3; ++y)
+            for(uint32_t x = 0; x < 6; ++x)
+            {
+                const float expected = x < 4 ? float((c * 3 + y) * 4 + x) : -1.f;
+                if(buffer[(c * 3 + y) * 6 + x] != expected)
+                {
+                    std::cerr << "Wrong value written to the buffer of an imported tensor!" << std::endl;
+                    return GIGA_Unknown_Error;
+                }
+            }
+    if(view_data != std::vector<float>({18.f, 19.f, 22.f, 23.f}))
+    {
+        std::cerr << "Wrong value read from a view of an imported tensor!" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    //Strides left to 0 are filled as for allocated tensors
+    GIGA_tensor_t packed;
+    packed.nb_dims = 2;
+    packed.dims[0] = 3;
+    packed.dims[1] = 5;
+    packed.strides[0] = 0;
+    packed.strides[1] = 0;
+    packed.device_id = device_id;
+    packed.type = GIGA_SFixed16;
+    packed.fp_shift = 0;
+    std::vector<int16_t> packed_buffer(3 * 5);
+    if((error = giga_import_tensor(&packed, packed_buffer.data())) != GIGA_Success)
+        return error;
+    if(packed.strides[0] != 5 * sizeof(int16_t) || packed.strides[1] != sizeof(int16_t))
+    {
+        std::cerr << "Strides of an imported tensor are incorrect!" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+    if((error = giga_release_tensor(&packed)) != GIGA_Success)
+        return error;
+
+    //Misaligned buffers are refused
+    if(giga_import_tensor(&packed, (char*)packed_buffer.data() + 1) != GIGA_Bad_Memory_Alignment)
+    {
+        std::cerr << "Import of a misaligned buffer was not rejected!" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    msg.replaceMessage("Imported tensors");
+    return GIGA_Success;
+}
+
+GIGA_error file_zone_test(const std::string &path)
+{
+    ScopedMessage msg("Memory zone mapped from a file\n");
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+       return error;
+
+    GIGA_tensor_t weights;
+    weights.nb_dims = 2;
+    weights.dims[0] = 16;
+    weights.dims[1] = NB_WEIGHTS / 16;
+    weights.device_id = device_id;
+    weights.type = GIGA_Float32;
+    weights.fp_shift = 0;
+
+    GIGA_allocate_t tensor_params;
+    tensor_params.memory_zone_id = 1;
+    tensor_params.offset = WEIGHTS_OFFSET;
+    if((error = giga_allocate_tensor(&weights, &tensor_params)) != GIGA_Success)
+    {
+        std::cerr << "Allocation in the file failed!" << std::endl;
+        return error;
+    }
+
+    //Values are read from the file in place
+    std::vector<float> data(NB_WEIGHTS);
+    if((error = giga_copy_from_tensor(data.data(), GIGA_Float32, 0, &weights)) != GIGA_Success)
+        return error;
+    for(uint32_t i = 0; i < NB_WEIGHTS; ++i)
+    {
+        if(data[i] != weight_value(i))
+        {
+            std::cerr << "Wrong value read from a tensor mapped from a file!" << std::endl;
+            return GIGA_Unknown_Error;
+        }
+    }
+
+    //Writing to the tensor never modifies the file
+    std::vector<float> zeros(NB_WEIGHTS, 0.f);
+    if((error = giga_copy_to_tensor(zeros.data(), GIGA_Float32, 0, &weights)) != GIGA_Success)
+        return error;
+    if((error = giga_copy_from_tensor(data.data(), GIGA_Float32, 0, &weights)) != GIGA_Success)
+        return error;
+    if((error = giga_release_tensor(&weights)) != GIGA_Success)
+        return error;
+
+    std::vector<float> file_data(NB_WEIGHTS);
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(WEIGHTS_OFFSET);
+    file.read((char*)file_data.data(), NB_WEIGHTS * sizeof(float));
+    for(uint32_t i = 0; i < NB_WEIGHTS; ++i)
+    {
+        if(data[i] != 0.f || file_data[i] != weight_value(i))
+        {
+            std::cerr << "Writing to a tensor mapped from a file is not private!" << std::endl;
+            return GIGA_Unknown_Error;
+        }
+    }
+
+    //Tensors must lie inside the file
+    tensor_params.offset = WEIGHTS_OFFSET + 64;
+    if(giga_allocate_tensor(&weights, &tensor_params) != GIGA_Out_Of_Device_Memory)
+    {
+        std::cerr << "Allocation past the end of the file was not refused!" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    //Automatic offsets never place tensors over the weights
+    tensor_params.offset = GIGA_AUTO_OFFSET;
+    weights.dims[0] = 1;
+    weights.dims[1] = 1;
+    if(giga_allocate_tensor(&weights, &tensor_params) != GIGA_Out_Of_Device_Memory)
+    {
+        std::cerr << "Allocation at an automatic offset in a file was not refused!" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    msg.replaceMessage("Memory zone mapped from a file");
+    return GIGA_Success;
+}
+
+//Memory zone 2 is "1M@0" on NUMA systems
+GIGA_error numa_zone_test()
+{
+    ScopedMessage msg("Memory zone bound to a NUMA node\n");
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+       return error;
+
+    //The node is not part of the size: the zone holds exactly 1MB
+    GIGA_tensor_t tensor;
+    tensor.nb_dims = 2;
+    tensor.dims[0] = 512;
+    tensor.dims[1] = 512;
+    tensor.device_id = device_id;
+    tensor.type = GIGA_Float32;
+    tensor.fp_shift = 0;
+
+    GIGA_allocate_t tensor_params;
+    tensor_params.memory_zone_id = 2;
+    tensor_params.offset = 64;
+    if(giga_allocate_tensor(&tensor, &tensor_params) != GIGA_Out_Of_Device_Memory)
+    {
+        std::cerr << "Allocation past the end of the zone was not refused!" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+    tensor_params.offset = 0;
+    if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+    {
+        std::cerr << "Allocation of the whole zone failed!" << std::endl;
+        return error;
+    }
+
+    //Operations run on the node without moving the calling thread
+    cpu_set_t cpus_before, cpus_after;
+    if(sched_getaffinity(0, sizeof(cpu_set_t), &cpus_before) != 0)
+        return GIGA_Unknown_Error;
+    std::vector<float> data(512 * 512);
+    for(uint32_t i = 0; i < data.size(); ++i)
+        data[i] = float(i % 1000);
+    if((error = giga_copy_to_tensor(data.data(), GIGA_Float32, 0, &tensor)) != GIGA_Success)
+        return error;
+    std::vector<float> values(512 * 512);
+    if((error = giga_copy_from_tensor(values.data(), GIGA_Float32, 0, &tensor)) != GIGA_Success)
+        return error;
+    if((error = giga_release_tensor(&tensor)) != GIGA_Success)
+        return error;
+    if(sched_getaffinity(0, sizeof(cpu_set_t), &cpus_after) != 0)
+        return GIGA_Unknown_Error;
+
+    if(values != data)
+    {
+        std::cerr << "Wrong value read from a tensor bound to a NUMA node!" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+    if(!CPU_EQUAL(&cpus_before, &cpus_after))
+    {
+        std::cerr << "Affinity of the calling thread was changed!" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    msg.replaceMessage("Memory zone bound to a NUMA node");
+    return GIGA_Success;
+}
+
 int main()
 {
     GIGA_error error = GIGA_Success;
 
+    //Memory zones are read when the device is initialized: the default zone, followed by a blob of weights and, on NUMA systems,
+    //a zone bound to the first node
+    const std::string weights_path = write_weights_file();
+    if(weights_path.empty())
+    {
+        std::cerr << "Error writing the weights file" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+    const bool b_numa = access("/sys/devices/system/node/node0", F_OK) == 0;
+    setenv("GIGA_CPU_MEMORY", ("128M;file:" + weights_path + (b_numa ? ";1M@0" : "")).c_str(), 1);
+
 #define EARLY_ABORT() throw std::runtime_error("Error")
 
     try
@@ -161,6 +640,14 @@ int main()
             EARLY_ABORT();
         if((error = allocation_test(GIGA_UFixed16)) != GIGA_Success)
             EARLY_ABORT();
+        if((error = auto_offset_test()) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = import_test()) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = file_zone_test(weights_path)) != GIGA_Success)
+            EARLY_ABORT();
+        if(b_numa && (error = numa_zone_test()) != GIGA_Success)
+            EARLY_ABORT();
     }
     catch(const std::exception &e)
     {
@@ -173,5 +660,6 @@ int main()
         }
     }
 
+    unlink(weights_path.c_str());
     return error;
 }
@@ -0,0 +1,285 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \date 16/01/2025
+ */
+
+#include <giga/giga.h>
+
+#include "utils.h"
+
+GIGA_error argmax_test(GIGA_data_type i_GT, GIGA_data_type l_GT, uint8_t in_shift, uint8_t prob_shift)
+{
+    ScopedMessage msg;
+
+    msg << "Argmax, in " << giga_data_type_str(i_GT)
+        << ", labels " << giga_data_type_str(l_GT)
+        << ", in_shift " << int(in_shift)
+        << ", prob_shift " << int(prob_shift) << "\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error getting default device id" << std::endl;
+        return error;
+    }
+
+    error = giga_initialize_device(device_id);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error initializing device" << std::endl;
+        return error;
+    }
+
+    const uint32_t N = 2;
+    const uint32_t C = 5;
+    const uint32_t H = 7;
+    const uint32_t W = 9;
+
+    size_t offset = 0;
+
+    GIGA_tensor_t tensor;
+    tensor.nb_dims = 4;
+    tensor.dims[0] = N;
+    tensor.dims[1] = C;
+    tensor.dims[2] = H;
+    tensor.dims[3] = W;
+    tensor.device_id = device_id;
+    tensor.data = NULL;
+    tensor.type = i_GT;
+    tensor.fp_shift = in_shift;
+
+    GIGA_allocate_t tensor_params;
+    tensor_params.memory_zone_id = 0;
+    tensor_params.offset = offset;
+    offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+    error = giga_allocate_tensor(&tensor, &tensor_params);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor tensor" << std::endl;
+        return error;
+    }
+
+    // Multiples of 1/16 in [-4, 4] are exactly representable in all tested types, and ties are frequent
+    std::vector<float> data(N * C * H * W);
+    uint32_t seed = 1234;
+    for(float &value : data)
+        value = float(int(rand_r(&seed) % 129) - 64) / 16.f;
+
+    fill_4d_tensor(data.data(), tensor);
+
+    GIGA_tensor_t labels;
+    labels.nb_dims = 4;
+    labels.dims[0] = N;
+    labels.dims[1] = 1;
+    labels.dims[2] = H;
+    labels.dims[3] = W;
+    labels.device_id = device_id;
+    labels.data = NULL;
+    labels.type = l_GT;
+    labels.fp_shift = 0;
+
+    GIGA_allocate_t labels_params;
+    labels_params.memory_zone_id = 0;
+    labels_params.offset = offset;
+    offset += align_address(tensor_size_in_bytes(&labels), TENSOR_ALIGNMENT);
+    error = giga_allocate_tensor(&labels, &labels_params);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor labels" << std::endl;
+        return error;
+    }
+
+    GIGA_tensor_t probability = labels;
+    probability.data = NULL;
+    probability.type = i_GT;
+    probability.fp_shift = prob_shift;
+
+    GIGA_allocate_t probability_params;
+    probability_params.memory_zone_id = 0;
+    probability_params.offset = offset;
+    offset += align_address(tensor_size_in_bytes(&probability), TENSOR_ALIGNMENT);
+    error = giga_allocate_tensor(&probability, &probability_params);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor probability" << std::endl;
+        return error;
+    }
+
+    // Fill outputs with garbage to make sure we don't test an unwritten tensor
+    fill_contiguous_tensor_with_random_data(labels, 0.f, 255.f);
+    fill_contiguous_tensor_with_random_data(probability, 0.f, 0.5f);
+
+    GIGA_argmax_t argmax_params;
+    argmax_params.probability = &probability;
+    error = giga_argmax(&argmax_params, &tensor, &labels);
+    if(error != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            std::cout << "Type not implemented!" << std::endl;
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing giga_argmax" << std::endl;
+        return error;
+    }
+
+    // Reference computed on the host, ties resolve to the first channel
+    std::vector<float> data_labels(N * H * W);
+    std::vector<float> data_probability(N * H * W);
+    for(uint32_t n = 0; n < N; ++n)
+        for(uint32_t p = 0; p < H * W; ++p)
+        {
+            const float * const in_ptr = data.data() + n * C * H * W + p;
+            uint32_t max_index = 0;
+            for(uint32_t c = 1; c < C; ++c)
+                if(in_ptr[c * H * W] > in_ptr[max_index * H * W])
+                    max_index = c;
+            float sum = 0.f;
+            for(uint32_t c = 0; c < C; ++c)
+                sum += std::exp(in_ptr[c * H * W] - in_ptr[max_index * H * W]);
+            data_labels[n * H * W + p] = float(max_index);
+            data_probability[n * H * W + p] = 1.f / sum;
+        }
+
+    GIGA_tensor_t result_labels = labels;
+    result_labels.data = NULL;
+
+    GIGA_allocate_t result_labels_params;
+    result_labels_params.memory_zone_id = 0;
+    result_labels_params.offset = offset;
+    offset += align_address(tensor_size_in_bytes(&result_labels), TENSOR_ALIGNMENT);
+    error = giga_allocate_tensor(&result_labels, &result_labels_params);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor result_labels" << std::endl;
+        return error;
+    }
+
+    GIGA_tensor_t result_probability = probability;
+    result_probability.data = NULL;
+
+    GIGA_allocate_t result_probability_params;
+    result_probability_params.memory_zone_id = 0;
+    result_probability_params.offset = offset;
+    offset += align_address(tensor_size_in_bytes(&result_probability), TENSOR_ALIGNMENT);
+    error = giga_allocate_tensor(&result_probability, &result_probability_params);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor result_probability" << std::endl;
+        return error;
+    }
+
+    fill_4d_tensor(data_labels.data(), result_labels);
+    fill_4d_tensor(data_probability.data(), result_probability);
+
+    if(!compare_tensors(&labels, &result_labels))
+    {
+        print_tensor(msg, labels, "giga_argmax output");
+        print_tensor(msg, result_labels, "expected output");
+        std::cerr << "Error comparing tensors labels and result_labels" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    if(!compare_tensors(&probability, &result_probability, 0.01))
+    {
+        print_tensor(msg, probability, "giga_argmax probability");
+        print_tensor(msg, result_probability, "expected probability");
+        std::cerr << "Error comparing tensors probability and result_probability" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    // Argmax only
+    fill_contiguous_tensor_with_random_data(labels, 0.f, 255.f);
+    argmax_params.probability = NULL;
+    error = giga_argmax(&argmax_params, &tensor, &labels);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error performing giga_argmax without probability" << std::endl;
+        return error;
+    }
+
+    if(!compare_tensors(&labels, &result_labels))
+    {
+        print_tensor(msg, labels, "giga_argmax output");
+        print_tensor(msg, result_labels, "expected output");
+        std::cerr << "Error comparing tensors labels and result_labels without probability" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    error = giga_release_tensor(&tensor);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error releasing tensor tensor" << std::endl;
+        return error;
+    }
+
+    error = giga_release_tensor(&labels);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error releasing tensor labels" << std::endl;
+        return error;
+    }
+
+    error = giga_release_tensor(&probability);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error releasing tensor probability" << std::endl;
+        return error;
+    }
+
+    error = giga_release_tensor(&result_labels);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error releasing tensor result_labels" << std::endl;
+        return error;
+    }
+
+    error = giga_release_tensor(&result_probability);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error releasing tensor result_probability" << std::endl;
+        return error;
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
+int main()
+{
+    GIGA_error error = GIGA_Success;
+
+#define EARLY_ABORT() throw std::runtime_error("Error")
+
+    try
+    {
+        for(GIGA_data_type l_GT : {GIGA_UFixed8, GIGA_UFixed16})
+        {
+            if((error = argmax_test(GIGA_Float32, l_GT, 0, 0)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = argmax_test(GIGA_Float16, l_GT, 0, 0)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = argmax_test(GIGA_SFixed8, l_GT, 4, 7)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = argmax_test(GIGA_SFixed16, l_GT, 4, 14)) != GIGA_Success)
+                EARLY_ABORT();
+        }
+    }
+    catch(const std::exception &e)
+    {
+        if (error != GIGA_Success)
+            std::cerr << "Error: " << giga_str_error(error) << std::endl;
+        else
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            error = GIGA_Unknown_Error;
+        }
+    }
+
+    return error;
+}
@@ -52,7 +52,7 @@ GIGA_error average_pooling_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_d
     GIGA_allocate_t in_params;
     in_params.memory_zone_id = 0;
     in_params.offset = offset;
-    offset += tensor_size_in_bytes(&in);
+    offset += align_address(tensor_size_in_bytes(&in), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&in, &in_params);
     if(err != GIGA_Success)
     {
@@ -85,7 +85,7 @@ GIGA_error average_pooling_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_d
     GIGA_allocate_t out_params;
     out_params.memory_zone_id = 0;
     out_params.offset = offset;
-    offset += tensor_size_in_bytes(&out);
+    offset += align_address(tensor_size_in_bytes(&out), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&out, &out_params);
     if(err != GIGA_Success)
     {
@@ -112,7 +112,7 @@ GIGA_error average_pooling_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_d
     GIGA_allocate_t kernel_params;
     kernel_params.memory_zone_id = 0;
     kernel_params.offset = offset;
-    offset += tensor_size_in_bytes(&kernel);
+    offset += align_address(tensor_size_in_bytes(&kernel), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&kernel, &kernel_params);
     if(err != GIGA_Success)
     {
@@ -131,6 +131,7 @@ GIGA_error average_pooling_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_d
     conv_params.padding[1][1] = 1;
     conv_params.dilation[0] = 1;
     conv_params.dilation[1] = 1;
+    conv_params.upsampling = 1;
     conv_params.stride[0] = 2;
     conv_params.stride[1] = 2;
     conv_params.bias = NULL;
@@ -169,7 +170,7 @@ GIGA_error average_pooling_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_d
     GIGA_allocate_t result_params;
     result_params.memory_zone_id = 0;
     result_params.offset = offset;
-    offset += tensor_size_in_bytes(&result);
+    offset += align_address(tensor_size_in_bytes(&result), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&result, &result_params);
     if(err != GIGA_Success)
     {
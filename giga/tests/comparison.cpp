@@ -44,7 +44,7 @@ GIGA_error comparison_test(GIGA_data_type a_GT, GIGA_data_type b_GT, uint8_t a_s
     GIGA_allocate_t tensor_1_params;
     tensor_1_params.memory_zone_id = 0;
     tensor_1_params.offset = offset;
-    offset += tensor_size_in_bytes(&tensor_1);
+    offset += align_address(tensor_size_in_bytes(&tensor_1), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&tensor_1, &tensor_1_params)) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor tensor_1" << std::endl;
@@ -64,7 +64,7 @@ GIGA_error comparison_test(GIGA_data_type a_GT, GIGA_data_type b_GT, uint8_t a_s
     GIGA_allocate_t tensor_2_params;
     tensor_2_params.memory_zone_id = 0;
     tensor_2_params.offset = offset;
-    offset += tensor_size_in_bytes(&tensor_2);
+    offset += align_address(tensor_size_in_bytes(&tensor_2), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&tensor_2, &tensor_2_params)) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor tensor_2" << std::endl;
@@ -4,7 +4,9 @@
  */
 #include <giga/giga.h>
 #include "utils.h"
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 
 GIGA_error conv2d_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type k_GT, uint8_t in_shift = 0, uint8_t ker_shift = 0, uint8_t out_shift = 0, bool b_activation = false)
@@ -53,7 +55,7 @@ GIGA_error conv2d_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type
     GIGA_allocate_t in_params;
     in_params.memory_zone_id = 0;
     in_params.offset = offset;
-    offset += tensor_size_in_bytes(&in);
+    offset += align_address(tensor_size_in_bytes(&in), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&in, &in_params);
     if(err != GIGA_Success)
     {
@@ -95,7 +97,7 @@ GIGA_error conv2d_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type
     GIGA_allocate_t out_params;
     out_params.memory_zone_id = 0;
     out_params.offset = offset;
-    offset += tensor_size_in_bytes(&out);
+    offset += align_address(tensor_size_in_bytes(&out), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&out, &out_params);
     if(err != GIGA_Success)
     {
@@ -141,7 +143,7 @@ GIGA_error conv2d_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type
     GIGA_allocate_t kernel_params;
     kernel_params.memory_zone_id = 0;
     kernel_params.offset = offset;
-    offset += tensor_size_in_bytes(&kernel);
+    offset += align_address(tensor_size_in_bytes(&kernel), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&kernel, &kernel_params);
     if(err != GIGA_Success)
     {
@@ -164,7 +166,7 @@ GIGA_error conv2d_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type
     GIGA_allocate_t bias_params;
     bias_params.memory_zone_id = 0;
     bias_params.offset = offset;
-    offset += tensor_size_in_bytes(&bias);
+    offset += align_address(tensor_size_in_bytes(&bias), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&bias, &bias_params);
     if(err != GIGA_Success)
     {
@@ -188,6 +190,7 @@ GIGA_error conv2d_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type
     conv_params.padding[1][1] = 1;
     conv_params.dilation[0] = 1;
     conv_params.dilation[1] = 1;
+    conv_params.upsampling = 1;
     conv_params.stride[0] = 1;
     conv_params.stride[1] = 1;
     conv_params.bias = &bias;
@@ -260,7 +263,7 @@ GIGA_error conv2d_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type
     GIGA_allocate_t result_params;
     result_params.memory_zone_id = 0;
     result_params.offset = offset;
-    offset += tensor_size_in_bytes(&result);
+    offset += align_address(tensor_size_in_bytes(&result), TENSOR_ALIGNMENT);
     err = giga_allocate_tensor(&result, &result_params);
     if(err != GIGA_Success)
     {
@@ -321,6 +324,448 @@ GIGA_error conv2d_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type
     return GIGA_Success;
 }
 
+GIGA_error conv2d_upsampling_test(GIGA_data_type GT, int32_t padding_begin, int32_t padding_end, bool b_activation)
+{
+    ScopedMessage msg;
+
+    msg << "Conv2d with x2 upsampling, " << giga_data_type_str(GT)
+        << ", padding " << padding_begin << " " << padding_end
+        << ", activation " << int(b_activation) << "\n";
+
+    GIGA_error err;
+    uint32_t device_id = giga_get_default_device_id(&err);
+    if(err != GIGA_Success)
+        return err;
+
+    if((err = giga_initialize_device(device_id)) != GIGA_Success)
+        return err;
+
+    const uint32_t N = 2;
+    const uint32_t Ci = 3;
+    const uint32_t Co = 4;
+    const uint32_t H = 6;
+    const uint32_t W = 7;
+    const uint32_t out_H = 2 * H + padding_begin + padding_end - 2;
+    const uint32_t out_W = 2 * W + padding_begin + padding_end - 2;
+
+    // in, upsampled, kernel, bias, out (fused), result (upsample then conv)
+    const std::vector<uint32_t> dims[6] = {{N, Ci, H, W}, {N, Ci, 2 * H, 2 * W}, {Co, Ci, 3, 3}, {Co}, {N, Co, out_H, out_W}, {N, Co, out_H, out_W}};
+    GIGA_tensor_t tensors[6];
+    size_t offset = 0;
+    for(uint32_t i = 0; i < 6; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = dims[i].size();
+        for(uint32_t d = 0; d < tensor.nb_dims; ++d)
+            tensor.dims[d] = dims[i][d];
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = 0;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((err = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return err;
+        }
+    }
+    GIGA_tensor_t &in = tensors[0];
+    GIGA_tensor_t &upsampled = tensors[1];
+    GIGA_tensor_t &kernel = tensors[2];
+    GIGA_tensor_t &bias = tensors[3];
+    GIGA_tensor_t &out = tensors[4];
+    GIGA_tensor_t &result = tensors[5];
+
+    // Small integers so that all accumulations are exact in every tested type
+    std::vector<float> data_in(N * Ci * H * W);
+    for(size_t i = 0; i < data_in.size(); ++i)
+        data_in[i] = float(int((i * 7) % 5) - 2);
+    std::vector<float> data_ker(Co * Ci * 9);
+    for(size_t i = 0; i < data_ker.size(); ++i)
+        data_ker[i] = float(int((i * 5) % 3) - 1);
+    const float data_bias[Co] = {1.f, -2.f, 0.f, 3.f};
+
+    fill_4d_tensor(data_in.data(), in);
+    fill_4d_tensor(data_ker.data(), kernel);
+    fill_4d_tensor(data_bias, bias);
+
+    // Fill output with garbage to make sure we don't test an unwritten tensor
+    fill_contiguous_tensor_with_random_data(out, 0.f, 100.f);
+
+    GIGA_conv2d_t conv_params;
+    conv_params.kernel = &kernel;
+    conv_params.padding[0][0] = padding_begin;
+    conv_params.padding[0][1] = padding_end;
+    conv_params.padding[1][0] = padding_begin;
+    conv_params.padding[1][1] = padding_end;
+    conv_params.dilation[0] = 1;
+    conv_params.dilation[1] = 1;
+    conv_params.upsampling = 2;
+    conv_params.stride[0] = 1;
+    conv_params.stride[1] = 1;
+    conv_params.bias = &bias;
+    conv_params.b_ReLU = b_activation;
+
+    if((err = giga_conv2d(&conv_params, &in, &out)) != GIGA_Success)
+    {
+        if (err == GIGA_Unimplemented_Type)
+        {
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing giga_conv2d with upsampling" << std::endl;
+        return err;
+    }
+
+    // Reference: explicit upsampling followed by a regular convolution
+    GIGA_upsample_t upsample_params;
+    upsample_params.factor = 2;
+    upsample_params.mode = GIGA_Upsample_Nearest;
+    upsample_params.addend = NULL;
+    if((err = giga_upsample(&upsample_params, &in, &upsampled)) != GIGA_Success)
+    {
+        std::cerr << "Error performing giga_upsample" << std::endl;
+        return err;
+    }
+    conv_params.upsampling = 1;
+    if((err = giga_conv2d(&conv_params, &upsampled, &result)) != GIGA_Success)
+    {
+        std::cerr << "Error performing giga_conv2d" << std::endl;
+        return err;
+    }
+
+    if(!compare_tensors(&out, &result))
+    {
+        print_tensor(msg, out, "giga_conv2d output");
+        print_tensor(msg, result, "Expected output");
+        std::cerr << "Error comparing tensors out and result" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    //Clean up
+    for(GIGA_tensor_t &tensor : tensors)
+    {
+        if((err = giga_release_tensor(&tensor)) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return err;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
+GIGA_error conv2d_stride2_test(GIGA_data_type GT, int32_t padding_begin, int32_t padding_end, bool b_activation)
+{
+    ScopedMessage msg;
+
+    msg << "Conv2d with stride 2, " << giga_data_type_str(GT)
+        << ", padding " << padding_begin << " " << padding_end
+        << ", activation " << int(b_activation) << "\n";
+
+    GIGA_error err;
+    uint32_t device_id = giga_get_default_device_id(&err);
+    if(err != GIGA_Success)
+        return err;
+
+    if((err = giga_initialize_device(device_id)) != GIGA_Success)
+        return err;
+
+    const uint32_t N = 2;
+    const uint32_t Ci = 3;
+    const uint32_t Co = 4;
+    const uint32_t H = 9;
+    const uint32_t W = 12;
+    const uint32_t out_H = (H + padding_begin + padding_end - 3) / 2 + 1;
+    const uint32_t out_W = (W + padding_begin + padding_end - 3) / 2 + 1;
+
+    // in, kernel, bias, out, result
+    const std::vector<uint32_t> dims[5] = {{N, Ci, H, W}, {Co, Ci, 3, 3}, {Co}, {N, Co, out_H, out_W}, {N, Co, out_H, out_W}};
+    GIGA_tensor_t tensors[5];
+    size_t offset = 0;
+    for(uint32_t i = 0; i < 5; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = dims[i].size();
+        for(uint32_t d = 0; d < tensor.nb_dims; ++d)
+            tensor.dims[d] = dims[i][d];
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = 0;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((err = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return err;
+        }
+    }
+    GIGA_tensor_t &in = tensors[0];
+    GIGA_tensor_t &kernel = tensors[1];
+    GIGA_tensor_t &bias = tensors[2];
+    GIGA_tensor_t &out = tensors[3];
+    GIGA_tensor_t &result = tensors[4];
+
+    // Small integers so that all accumulations are exact in every tested type
+    std::vector<float> data_in(N * Ci * H * W);
+    for(size_t i = 0; i < data_in.size(); ++i)
+        data_in[i] = float(int((i * 7) % 5) - 2);
+    std::vector<float> data_ker(Co * Ci * 9);
+    for(size_t i = 0; i < data_ker.size(); ++i)
+        data_ker[i] = float(int((i * 5) % 3) - 1);
+    const float data_bias[Co] = {1.f, -2.f, 0.f, 3.f};
+
+    fill_4d_tensor(data_in.data(), in);
+    fill_4d_tensor(data_ker.data(), kernel);
+    fill_4d_tensor(data_bias, bias);
+
+    // Fill output with garbage to make sure we don't test an unwritten tensor
+    fill_contiguous_tensor_with_random_data(out, 0.f, 100.f);
+
+    GIGA_conv2d_t conv_params;
+    conv_params.kernel = &kernel;
+    conv_params.padding[0][0] = padding_begin;
+    conv_params.padding[0][1] = padding_end;
+    conv_params.padding[1][0] = padding_begin;
+    conv_params.padding[1][1] = padding_end;
+    conv_params.dilation[0] = 1;
+    conv_params.dilation[1] = 1;
+    conv_params.upsampling = 1;
+    conv_params.stride[0] = 2;
+    conv_params.stride[1] = 2;
+    conv_params.bias = &bias;
+    conv_params.b_ReLU = b_activation;
+
+    if((err = giga_conv2d(&conv_params, &in, &out)) != GIGA_Success)
+    {
+        if (err == GIGA_Unimplemented_Type)
+        {
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing giga_conv2d with stride 2" << std::endl;
+        return err;
+    }
+
+    // Reference computed on the host
+    std::vector<float> data_result(N * Co * out_H * out_W);
+    for(uint32_t n = 0; n < N; ++n)
+        for(uint32_t co = 0; co < Co; ++co)
+            for(uint32_t y = 0; y < out_H; ++y)
+                for(uint32_t x = 0; x < out_W; ++x)
+                {
+                    float acc = data_bias[co];
+                    for(uint32_t ci = 0; ci < Ci; ++ci)
+                        for(uint32_t ky = 0; ky < 3; ++ky)
+                            for(uint32_t kx = 0; kx < 3; ++kx)
+                            {
+                                const int32_t in_y = int32_t(2 * y + ky) - padding_begin;
+                                const int32_t in_x = int32_t(2 * x + kx) - padding_begin;
+                                if(in_y < 0 || in_y >= int32_t(H) || in_x < 0 || in_x >= int32_t(W))
+                                    continue;
+                                acc += data_ker[(co * Ci + ci) * 9 + ky * 3 + kx] * data_in[((n * Ci + ci) * H + in_y) * W + in_x];
+                            }
+                    data_result[((n * Co + co) * out_H + y) * out_W + x] = b_activation ? std::max(acc, 0.f) : acc;
+                }
+
+    fill_4d_tensor(data_result.data(), result);
+
+    if(!compare_tensors(&out, &result))
+    {
+        print_tensor(msg, out, "giga_conv2d output");
+        print_tensor(msg, result, "Expected output");
+        std::cerr << "Error comparing tensors out and result" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    //Clean up
+    for(GIGA_tensor_t &tensor : tensors)
+    {
+        if((err = giga_release_tensor(&tensor)) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return err;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
+GIGA_error conv2d_separable_test(GIGA_data_type GT, int32_t padding_begin, int32_t padding_end, bool b_activation, bool b_separable)
+{
+    ScopedMessage msg;
+
+    msg << "Conv2d with " << (b_separable ? "rank 1" : "non separable") << " kernels, " << giga_data_type_str(GT)
+        << ", padding " << padding_begin << " " << padding_end
+        << ", activation " << int(b_activation) << "\n";
+
+    GIGA_error err;
+    uint32_t device_id = giga_get_default_device_id(&err);
+    if(err != GIGA_Success)
+        return err;
+
+    if((err = giga_initialize_device(device_id)) != GIGA_Success)
+        return err;
+
+    const uint32_t N = 2;
+    const uint32_t C = 3;
+    const uint32_t H = 37;
+    const uint32_t W = 21;
+    const uint32_t out_H = H + padding_begin + padding_end - 2;
+    const uint32_t out_W = W + padding_begin + padding_end - 2;
+
+    // in, kernel, bias, out, result
+    const std::vector<uint32_t> dims[5] = {{N, C, H, W}, {C, C, 3, 3}, {C}, {N, C, out_H, out_W}, {N, C, out_H, out_W}};
+    GIGA_tensor_t tensors[5];
+    size_t offset = 0;
+    for(uint32_t i = 0; i < 5; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = dims[i].size();
+        for(uint32_t d = 0; d < tensor.nb_dims; ++d)
+            tensor.dims[d] = dims[i][d];
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = 0;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((err = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return err;
+        }
+    }
+    GIGA_tensor_t &in = tensors[0];
+    GIGA_tensor_t &kernel = tensors[1];
+    GIGA_tensor_t &bias = tensors[2];
+    GIGA_tensor_t &out = tensors[3];
+    GIGA_tensor_t &result = tensors[4];
+
+    // Small integers so that all accumulations are exact in every tested type
+    std::vector<float> data_in(N * C * H * W);
+    for(size_t i = 0; i < data_in.size(); ++i)
+        data_in[i] = float(int((i * 7) % 5) - 2);
+
+    // Sobel and Gaussian filters on the diagonal, a few rank 1 kernels mixing channels and zero kernels elsewhere
+    struct Separable_kernel
+    {
+        uint32_t co;
+        uint32_t ci;
+        float vertical[3];
+        float horizontal[3];
+    };
+    const Separable_kernel separable_kernels[] = {{0, 0, {1.f, 2.f, 1.f}, {-1.f, 0.f, 1.f}},
+                                                  {1, 1, {-1.f, 0.f, 1.f}, {1.f, 2.f, 1.f}},
+                                                  {2, 2, {1.f, 2.f, 1.f}, {1.f, 2.f, 1.f}},
+                                                  {0, 1, {0.f, 1.f, 0.f}, {2.f, -2.f, 0.f}},
+                                                  {2, 0, {3.f, 0.f, -3.f}, {1.f, 1.f, 1.f}}};
+    std::vector<float> data_ker(C * C * 9, 0.f);
+    for(const Separable_kernel &k : separable_kernels)
+        for(uint32_t ky = 0; ky < 3; ++ky)
+            for(uint32_t kx = 0; kx < 3; ++kx)
+                data_ker[(k.co * C + k.ci) * 9 + ky * 3 + kx] = k.vertical[ky] * k.horizontal[kx];
+    // A single non separable kernel disables the separable path
+    if(!b_separable)
+        data_ker[(1 * C + 1) * 9 + 4] += 1.f;
+    const float data_bias[C] = {1.f, -2.f, 3.f};
+
+    fill_4d_tensor(data_in.data(), in);
+    fill_4d_tensor(data_ker.data(), kernel);
+    fill_4d_tensor(data_bias, bias);
+
+    // Fill output with garbage to make sure we don't test an unwritten tensor
+    fill_contiguous_tensor_with_random_data(out, 0.f, 100.f);
+
+    GIGA_conv2d_t conv_params;
+    conv_params.kernel = &kernel;
+    conv_params.padding[0][0] = padding_begin;
+    conv_params.padding[0][1] = padding_end;
+    conv_params.padding[1][0] = padding_begin;
+    conv_params.padding[1][1] = padding_end;
+    conv_params.dilation[0] = 1;
+    conv_params.dilation[1] = 1;
+    conv_params.upsampling = 1;
+    conv_params.stride[0] = 1;
+    conv_params.stride[1] = 1;
+    conv_params.bias = &bias;
+    conv_params.b_ReLU = b_activation;
+
+    if((err = giga_conv2d(&conv_params, &in, &out)) != GIGA_Success)
+    {
+        if (err == GIGA_Unimplemented_Type)
+        {
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing giga_conv2d" << std::endl;
+        return err;
+    }
+
+    // Reference computed on the host
+    std::vector<float> data_result(N * C * out_H * out_W);
+    for(uint32_t n = 0; n < N; ++n)
+        for(uint32_t co = 0; co < C; ++co)
+            for(uint32_t y = 0; y < out_H; ++y)
+                for(uint32_t x = 0; x < out_W; ++x)
+                {
+                    float acc = data_bias[co];
+                    for(uint32_t ci = 0; ci < C; ++ci)
+                        for(uint32_t ky = 0; ky < 3; ++ky)
+                            for(uint32_t kx = 0; kx < 3; ++kx)
+                            {
+                                const int32_t in_y = int32_t(y + ky) - padding_begin;
+                                const int32_t in_x = int32_t(x + kx) - padding_begin;
+                                if(in_y < 0 || in_y >= int32_t(H) || in_x < 0 || in_x >= int32_t(W))
+                                    continue;
+                                acc += data_ker[(co * C + ci) * 9 + ky * 3 + kx] * data_in[((n * C + ci) * H + in_y) * W + in_x];
+                            }
+                    data_result[((n * C + co) * out_H + y) * out_W + x] = b_activation ? std::max(acc, 0.f) : acc;
+                }
+
+    fill_4d_tensor(data_result.data(), result);
+
+    if(!compare_tensors(&out, &result))
+    {
+        print_tensor(msg, out, "giga_conv2d output");
+        print_tensor(msg, result, "Expected output");
+        std::cerr << "Error comparing tensors out and result" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    //Clean up
+    for(GIGA_tensor_t &tensor : tensors)
+    {
+        if((err = giga_release_tensor(&tensor)) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return err;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
 int main()
 {
     GIGA_error error = GIGA_Success;
@@ -369,6 +814,27 @@ int main()
                 }
             }
         }
+
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_SFixed8, GIGA_SFixed16})
+        {
+            for(int32_t padding : {0, 1, 2})
+            {
+                if((error = conv2d_upsampling_test(GT, padding, padding, false)) != GIGA_Success)
+                    EARLY_ABORT();
+                if((error = conv2d_upsampling_test(GT, padding, 2 - padding, true)) != GIGA_Success)
+                    EARLY_ABORT();
+                if((error = conv2d_stride2_test(GT, padding, padding, false)) != GIGA_Success)
+                    EARLY_ABORT();
+                if((error = conv2d_stride2_test(GT, padding, 2 - padding, true)) != GIGA_Success)
+                    EARLY_ABORT();
+                if((error = conv2d_separable_test(GT, padding, padding, false, true)) != GIGA_Success)
+                    EARLY_ABORT();
+                if((error = conv2d_separable_test(GT, padding, 2 - padding, true, true)) != GIGA_Success)
+                    EARLY_ABORT();
+                if((error = conv2d_separable_test(GT, padding, padding, false, false)) != GIGA_Success)
+                    EARLY_ABORT();
+            }
+        }
     }
     catch(const std::exception &e)
     {
@@ -0,0 +1,188 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \date 16/01/2025
+ */
+
+#include <giga/giga.h>
+#include "utils.h"
+#include <algorithm>
+
+GIGA_error conv2d_transpose_test(GIGA_data_type GT, uint32_t kernel_size, int32_t padding_begin, int32_t padding_end, bool b_activation)
+{
+    ScopedMessage msg;
+
+    msg << "Conv2d transpose, " << giga_data_type_str(GT)
+        << ", kernel " << kernel_size
+        << ", padding " << padding_begin << " " << padding_end
+        << ", activation " << int(b_activation) << "\n";
+
+    GIGA_error err;
+    uint32_t device_id = giga_get_default_device_id(&err);
+    if(err != GIGA_Success)
+        return err;
+
+    if((err = giga_initialize_device(device_id)) != GIGA_Success)
+        return err;
+
+    const uint32_t N = 2;
+    const uint32_t Ci = 3;
+    const uint32_t Co = 4;
+    const uint32_t H = 5;
+    const uint32_t W = 7;
+    const uint32_t K = kernel_size;
+    const uint32_t full_H = (H - 1) * 2 + K;
+    const uint32_t full_W = (W - 1) * 2 + K;
+    const uint32_t out_H = full_H - padding_begin - padding_end;
+    const uint32_t out_W = full_W - padding_begin - padding_end;
+
+    // in, kernel, bias, out, result
+    const std::vector<uint32_t> dims[5] = {{N, Ci, H, W}, {Ci, Co, K, K}, {Co}, {N, Co, out_H, out_W}, {N, Co, out_H, out_W}};
+    GIGA_tensor_t tensors[5];
+    size_t offset = 0;
+    for(uint32_t i = 0; i < 5; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = dims[i].size();
+        for(uint32_t d = 0; d < tensor.nb_dims; ++d)
+            tensor.dims[d] = dims[i][d];
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = 0;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((err = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return err;
+        }
+    }
+    GIGA_tensor_t &in = tensors[0];
+    GIGA_tensor_t &kernel = tensors[1];
+    GIGA_tensor_t &bias = tensors[2];
+    GIGA_tensor_t &out = tensors[3];
+    GIGA_tensor_t &result = tensors[4];
+
+    // Small integers so that all accumulations are exact in every tested type
+    std::vector<float> data_in(N * Ci * H * W);
+    for(size_t i = 0; i < data_in.size(); ++i)
+        data_in[i] = float(int((i * 7) % 5) - 2);
+    std::vector<float> data_ker(Ci * Co * K * K);
+    for(size_t i = 0; i < data_ker.size(); ++i)
+        data_ker[i] = float(int((i * 5) % 3) - 1);
+    const float data_bias[Co] = {1.f, -2.f, 0.f, 3.f};
+
+    fill_4d_tensor(data_in.data(), in);
+    fill_4d_tensor(data_ker.data(), kernel);
+    fill_4d_tensor(data_bias, bias);
+
+    // Fill output with garbage to make sure we don't test an unwritten tensor
+    fill_contiguous_tensor_with_random_data(out, 0.f, 100.f);
+
+    GIGA_conv2d_transpose_t conv_params;
+    conv_params.kernel = &kernel;
+    conv_params.padding[0][0] = padding_begin;
+    conv_params.padding[0][1] = padding_end;
+    conv_params.padding[1][0] = padding_begin;
+    conv_params.padding[1][1] = padding_end;
+    conv_params.stride[0] = 2;
+    conv_params.stride[1] = 2;
+    conv_params.bias = &bias;
+    conv_params.b_ReLU = b_activation;
+
+    if((err = giga_conv2d_transpose(&conv_params, &in, &out)) != GIGA_Success)
+    {
+        if (err == GIGA_Unimplemented_Type)
+        {
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing giga_conv2d_transpose" << std::endl;
+        return err;
+    }
+
+    // Reference computed on the host: each input pixel scatters the kernel into the full output, which is then cropped
+    std::vector<float> data_full(N * Co * full_H * full_W, 0.f);
+    for(uint32_t n = 0; n < N; ++n)
+        for(uint32_t c_in = 0; c_in < Ci; ++c_in)
+            for(uint32_t y = 0; y < H; ++y)
+                for(uint32_t x = 0; x < W; ++x)
+                    for(uint32_t c_out = 0; c_out < Co; ++c_out)
+                        for(uint32_t ky = 0; ky < K; ++ky)
+                            for(uint32_t kx = 0; kx < K; ++kx)
+                                data_full[((n * Co + c_out) * full_H + y * 2 + ky) * full_W + x * 2 + kx] +=
+                                        data_in[((n * Ci + c_in) * H + y) * W + x] * data_ker[((c_in * Co + c_out) * K + ky) * K + kx];
+
+    std::vector<float> data_result(N * Co * out_H * out_W);
+    for(uint32_t nc = 0; nc < N * Co; ++nc)
+        for(uint32_t y = 0; y < out_H; ++y)
+            for(uint32_t x = 0; x < out_W; ++x)
+            {
+                const float value = data_full[(nc * full_H + y + padding_begin) * full_W + x + padding_begin] + data_bias[nc % Co];
+                data_result[(nc * out_H + y) * out_W + x] = b_activation ? std::max(value, 0.f) : value;
+            }
+
+    fill_4d_tensor(data_result.data(), result);
+
+    if(!compare_tensors(&out, &result))
+    {
+        print_tensor(msg, out, "giga_conv2d_transpose output");
+        print_tensor(msg, result, "expected output");
+        std::cerr << "Error comparing tensors out and result" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    for(GIGA_tensor_t &t : tensors)
+    {
+        if((err = giga_release_tensor(&t)) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return err;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
+int main()
+{
+    GIGA_error error = GIGA_Success;
+
+#define EARLY_ABORT() throw std::runtime_error("Error")
+
+    try
+    {
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_SFixed8, GIGA_SFixed16})
+        {
+            for(uint32_t kernel_size : {2, 3, 4})
+            {
+                for(int32_t padding = 0; padding < int32_t(kernel_size); ++padding)
+                {
+                    if((error = conv2d_transpose_test(GT, kernel_size, padding, padding, false)) != GIGA_Success)
+                        EARLY_ABORT();
+                }
+                // Output padding of 1 as used to double the input size
+                if((error = conv2d_transpose_test(GT, kernel_size, 1, 0, true)) != GIGA_Success)
+                    EARLY_ABORT();
+            }
+        }
+    }
+    catch(const std::exception &e)
+    {
+        if (error != GIGA_Success)
+            std::cerr << "Error: " << giga_str_error(error) << std::endl;
+        else
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            error = GIGA_Unknown_Error;
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,276 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \date 16/01/2025
+ */
+
+#include <giga/giga.h>
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static uint8_t fp_shift_for(GIGA_data_type GT)
+{
+    switch(GT)
+    {
+    case GIGA_SFixed8:  return 5;
+    case GIGA_SFixed16: return 10;
+    case GIGA_UFixed8:  return 4;
+    case GIGA_UFixed16: return 8;
+    default:            return 0;
+    }
+}
+
+static double min_for(GIGA_data_type GT)
+{
+    switch(GT)
+    {
+    case GIGA_SFixed8:  return std::numeric_limits<int8_t>::min();
+    case GIGA_SFixed16: return std::numeric_limits<int16_t>::min();
+    case GIGA_UFixed8:
+    case GIGA_UFixed16: return 0;
+    default:            return -std::numeric_limits<double>::infinity();
+    }
+}
+
+static double max_for(GIGA_data_type GT)
+{
+    switch(GT)
+    {
+    case GIGA_SFixed8:  return std::numeric_limits<int8_t>::max();
+    case GIGA_SFixed16: return std::numeric_limits<int16_t>::max();
+    case GIGA_UFixed8:  return std::numeric_limits<uint8_t>::max();
+    case GIGA_UFixed16: return std::numeric_limits<uint16_t>::max();
+    default:            return std::numeric_limits<double>::infinity();
+    }
+}
+
+GIGA_error copy_image_test(GIGA_data_type GT, GIGA_data_type sample_type, bool b_normalize, uint32_t nb_dims, bool b_view = false)
+{
+    ScopedMessage msg;
+    msg << "Copy image " << giga_data_type_str(sample_type) << " to " << giga_data_type_str(GT)
+        << (b_normalize ? ", normalized" : "")
+        << ", " << nb_dims << " dims" << (b_view ? ", view" : "") << "\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+        return error;
+
+    const uint32_t N = nb_dims == 4 ? 2 : 1;
+    const uint32_t C = 3;
+    const uint32_t H = 5;
+    const uint32_t W = 9;
+
+    size_t offset = 0;
+
+    // out, result and the padded tensor out is a view of (rows and columns are added around the image)
+    const uint32_t nb_tensors = b_view ? 3 : 2;
+    GIGA_tensor_t tensors[3];
+    for(uint32_t i = 0; i < nb_tensors; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = nb_dims;
+        const uint32_t dims[4] = {N, C, i == 2 ? H + 2 : H, i == 2 ? W + 3 : W};
+        for(uint32_t d = 0; d < nb_dims; ++d)
+            tensor.dims[d] = dims[4 - nb_dims + d];
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = fp_shift_for(GT);
+        if(b_view && i == 0)
+            continue;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return error;
+        }
+    }
+    GIGA_tensor_t &out = tensors[0];
+    GIGA_tensor_t &result = tensors[1];
+    GIGA_tensor_t &padded = tensors[2];
+
+    std::vector<float> padded_data(b_view ? size_t(N) * C * (H + 2) * (W + 3) : 0);
+    if(b_view)
+    {
+        GIGA_view_t view_params;
+        view_params.offset[0] = 0;
+        view_params.offset[1] = 0;
+        view_params.offset[nb_dims - 2] = 1;
+        view_params.offset[nb_dims - 1] = 2;
+        if((error = giga_view(&view_params, &padded, &out)) != GIGA_Success)
+        {
+            std::cerr << "Error performing giga_view" << std::endl;
+            return error;
+        }
+    }
+
+    // HWC images with padded rows, 8 bits samples or 12 bits samples in 16 bits words
+    const bool b_16bits = sample_type == GIGA_UFixed16;
+    const uint32_t sample_size = b_16bits ? 2 : 1;
+    const uint32_t row_stride = W * C * sample_size + 8;
+    std::vector<uint8_t> image_data(N * H * row_stride, 0xA5);
+    std::vector<float> samples(N * H * W * C);
+    for(uint32_t n = 0; n < N; ++n)
+        for(uint32_t y = 0; y < H; ++y)
+            for(uint32_t x = 0; x < W; ++x)
+                for(uint32_t c = 0; c < C; ++c)
+                {
+                    const uint32_t i = ((n * H + y) * W + x) * C + c;
+                    const uint32_t value = b_16bits ? (i * 1237) % 4096 : (i * 37) % 256;
+                    samples[i] = float(value);
+                    uint8_t * const ptr = image_data.data() + (n * H + y) * row_stride + (x * C + c) * sample_size;
+                    if(b_16bits)
+                    {
+                        const uint16_t value16 = value;
+                        memcpy(ptr, &value16, 2);
+                    }
+                    else
+                        *ptr = value;
+                }
+
+    const float mean8[C] = {123.675f, 116.28f, 103.53f};
+    const float std8[C] = {58.395f, 57.12f, 57.375f};
+    const float mean16[C] = {2048.f, 2000.f, 1900.f};
+    const float std16[C] = {1024.f, 800.f, 600.f};
+
+    GIGA_image_t image;
+    image.type = sample_type;
+    image.row_stride = row_stride;
+    image.mean = b_normalize ? (b_16bits ? mean16 : mean8) : NULL;
+    image.std = b_normalize ? (b_16bits ? std16 : std8) : NULL;
+
+    // Fill output with garbage to make sure we don't test an unwritten tensor
+    fill_contiguous_tensor_with_random_data(b_view ? padded : out, 0.f, 1.f);
+    if(b_view && (error = giga_copy_from_tensor(padded_data.data(), GIGA_Float32, 0, &padded)) != GIGA_Success)
+    {
+        std::cerr << "Error reading tensor padded" << std::endl;
+        return error;
+    }
+
+    if((error = giga_copy_image_to_tensor(image_data.data(), &image, &out)) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            std::cout << "Type not implemented!" << std::endl;
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing giga_copy_image_to_tensor" << std::endl;
+        return error;
+    }
+
+    // Reference computed on the host
+    const double scale = double(1 << fp_shift_for(GT));
+    std::vector<float> data_result(N * C * H * W);
+    for(uint32_t n = 0; n < N; ++n)
+        for(uint32_t c = 0; c < C; ++c)
+            for(uint32_t y = 0; y < H; ++y)
+                for(uint32_t x = 0; x < W; ++x)
+                {
+                    double value = samples[((n * H + y) * W + x) * C + c];
+                    if(b_normalize)
+                        value = (value - image.mean[c]) / image.std[c];
+                    // Fixed point values are rounded to the nearest value of the representation and saturated
+                    if(!is_float(GT))
+                        value = std::min(std::max(std::round(value * scale), min_for(GT)), max_for(GT)) / scale;
+                    data_result[((n * C + c) * H + y) * W + x] = float(value);
+                }
+
+    fill_4d_tensor(data_result.data(), result);
+
+    // Fixed point values may differ by one unit when the exact value lies half way, half floats keep 11 significant bits
+    const double max_value = b_normalize ? 4.0 : 4096.0;
+    const double epsilon = is_float(GT) ? max_value * (GT == GIGA_Float16 ? 1e-3 : 1e-6) : 1.0 / scale;
+    if(!compare_tensors(&out, &result, epsilon))
+    {
+        print_tensor(msg, out, "giga_copy_image_to_tensor output");
+        print_tensor(msg, result, "expected output");
+        std::cerr << "Error comparing tensors out and result" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    // The border of the padded tensor is left untouched
+    if(b_view)
+    {
+        std::vector<float> padded_result(padded_data.size());
+        if((error = giga_copy_from_tensor(padded_result.data(), GIGA_Float32, 0, &padded)) != GIGA_Success)
+        {
+            std::cerr << "Error reading tensor padded" << std::endl;
+            return error;
+        }
+        for(size_t i = 0; i < padded_data.size(); ++i)
+        {
+            const uint32_t x = i % (W + 3);
+            const uint32_t y = (i / (W + 3)) % (H + 2);
+            const bool b_inside = y >= 1 && y < H + 1 && x >= 2 && x < W + 2;
+            if(!b_inside && padded_result[i] != padded_data[i])
+            {
+                std::cerr << "Error: the border of the padded tensor has been written" << std::endl;
+                return GIGA_Unknown_Error;
+            }
+        }
+    }
+
+    for(uint32_t i = 0; i < nb_tensors; ++i)
+    {
+        if((error = giga_release_tensor(&tensors[i])) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return error;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
+int main()
+{
+    GIGA_error error = GIGA_Success;
+
+#define EARLY_ABORT() throw std::runtime_error("Error")
+
+    try
+    {
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_SFixed8, GIGA_SFixed16, GIGA_UFixed8, GIGA_UFixed16})
+        {
+            for(GIGA_data_type sample_type : {GIGA_UFixed8, GIGA_UFixed16})
+            {
+                for(bool b_normalize : {true, false})
+                {
+                    if((error = copy_image_test(GT, sample_type, b_normalize, 4)) != GIGA_Success)
+                        EARLY_ABORT();
+                }
+            }
+            if((error = copy_image_test(GT, GIGA_UFixed8, true, 3)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = copy_image_test(GT, GIGA_UFixed8, true, 4, true)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = copy_image_test(GT, GIGA_UFixed16, false, 3, true)) != GIGA_Success)
+                EARLY_ABORT();
+        }
+    }
+    catch(const std::exception &e)
+    {
+        if (error != GIGA_Success)
+            std::cerr << "Error: " << giga_str_error(error) << std::endl;
+        else
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            error = GIGA_Unknown_Error;
+        }
+    }
+
+    return error;
+}
@@ -43,7 +43,7 @@ GIGA_error dense_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type k
     GIGA_allocate_t in_params;
     in_params.memory_zone_id = 0;
     in_params.offset = offset;
-    offset += tensor_size_in_bytes(&in);
+    offset += align_address(tensor_size_in_bytes(&in), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&in, &in_params)) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor in" << std::endl;
@@ -70,7 +70,7 @@ GIGA_error dense_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type k
     GIGA_allocate_t out_params;
     out_params.memory_zone_id = 0;
     out_params.offset = offset;
-    offset += tensor_size_in_bytes(&out);
+    offset += align_address(tensor_size_in_bytes(&out), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&out, &out_params)) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor out" << std::endl;
@@ -91,7 +91,7 @@ GIGA_error dense_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type k
     GIGA_allocate_t ker_params;
     ker_params.memory_zone_id = 0;
     ker_params.offset = offset;
-    offset += tensor_size_in_bytes(&ker);
+    offset += align_address(tensor_size_in_bytes(&ker), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&ker, &ker_params)) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor ker" << std::endl;
@@ -139,7 +139,7 @@ GIGA_error dense_test(GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type k
     GIGA_allocate_t result_params;
     result_params.memory_zone_id = 0;
     result_params.offset = offset;
-    offset += tensor_size_in_bytes(&result);
+    offset += align_address(tensor_size_in_bytes(&result), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&result, &result_params)) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor result" << std::endl;
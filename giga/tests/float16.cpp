@@ -5,6 +5,29 @@
 
 #include <giga/float16.h>
 #include <iostream>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+//Checks the bits of the conversion of v to half precision
+bool check_conversion(float v, uint16_t expected)
+{
+    const half h(v);
+    if(h.data != expected)
+    {
+        std::cerr << "Conversion of " << v << " gives 0x" << std::hex << h.data << " instead of 0x" << expected << std::dec << std::endl;
+        return false;
+    }
+    return true;
+}
+
+//NaN test on the bits, std::isnan being optimized away with -ffast-math
+bool is_nan(float v)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return (bits & 0x7FFFFFFF) > 0x7F800000;
+}
 
 int main()
 {
@@ -20,5 +43,81 @@ int main()
     h1+=h2;
     std::cout << h1 << std::endl;
 
+    //Rounding to nearest even, denormals, signed zeros and overflows
+    bool b_ok = true;
+    b_ok &= check_conversion(1.f + std::ldexp(1.f, -11), 0x3C00);
+    b_ok &= check_conversion(1.f + 3.f * std::ldexp(1.f, -11), 0x3C02);
+    b_ok &= check_conversion(1.f + 1.5f * std::ldexp(1.f, -11), 0x3C01);
+    b_ok &= check_conversion(std::ldexp(1.f, -24), 0x0001);
+    b_ok &= check_conversion(std::ldexp(1.f, -25), 0x0000);
+    b_ok &= check_conversion(-3.f * std::ldexp(1.f, -25), 0x8002);
+    b_ok &= check_conversion(std::ldexp(1023.f, -24), 0x03FF);
+    b_ok &= check_conversion(-0.f, 0x8000);
+    b_ok &= check_conversion(65519.f, 0x7BFF);
+    b_ok &= check_conversion(65520.f, 0x7C00);
+    b_ok &= check_conversion(-1e10f, 0xFC00);
+    if(!b_ok)
+        return 1;
+
+    //Every half precision value (but signaling NaNs, which become quiet) is converted to float and back exactly
+    for(uint32_t bits = 0; bits < 0x10000; ++bits)
+    {
+        half h;
+        h.data = uint16_t(bits);
+        const float v = h;
+        if(is_nan(v) != ((bits & 0x7C00) == 0x7C00 && (bits & 0x3FF) != 0))
+        {
+            std::cerr << "NaN mismatch for 0x" << std::hex << bits << std::dec << std::endl;
+            return 1;
+        }
+        if(half(v).data != (is_nan(v) ? bits | 0x200 : bits))
+        {
+            std::cerr << "Round trip of 0x" << std::hex << bits << " gives 0x" << half(v).data << std::dec << std::endl;
+            return 1;
+        }
+    }
+
+    //Bulk conversions give the same bits as scalar ones (NaN payloads included), including the values after the last full block
+    std::vector<float> values(1003);
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = std::ldexp(float(int(i * 7919 % 2001) - 1000) / 7.f, int(i % 41) - 28);
+        if(i % 97 == 0)
+        {
+            //Quiet and signaling NaNs with various payloads
+            const uint32_t bits = 0x7F800001 | uint32_t(i * 2654435761U) >> 10 | (i % 2 ? 0x80000000 : 0);
+            memcpy(&values[i], &bits, sizeof(bits));
+        }
+    }
+    std::vector<half> halves(values.size());
+    std::vector<float> floats(values.size());
+    giga_half_from_float_n(halves.data(), values.data(), values.size());
+    giga_float_from_half_n(floats.data(), halves.data(), halves.size());
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+        const float scalar = halves[i];
+        if(halves[i].data != half(values[i]).data || memcmp(&floats[i], &scalar, sizeof(float)) != 0)
+        {
+            std::cerr << "Bulk conversion of " << values[i] << " differs from the scalar one" << std::endl;
+            return 1;
+        }
+    }
+
+    //Same for every half precision value, signaling NaNs included
+    std::vector<half> all_halves(0x10000);
+    for(uint32_t bits = 0; bits < 0x10000; ++bits)
+        all_halves[bits].data = uint16_t(bits);
+    std::vector<float> all_floats(all_halves.size());
+    giga_float_from_half_n(all_floats.data(), all_halves.data(), all_halves.size());
+    for(uint32_t bits = 0; bits < 0x10000; ++bits)
+    {
+        const float scalar = all_halves[bits];
+        if(memcmp(&all_floats[bits], &scalar, sizeof(float)) != 0)
+        {
+            std::cerr << "Bulk conversion of 0x" << std::hex << bits << std::dec << " differs from the scalar one" << std::endl;
+            return 1;
+        }
+    }
+
     return 0;
 }
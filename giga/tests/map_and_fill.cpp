@@ -40,7 +40,7 @@ GIGA_error map_and_fill_test(GIGA_data_type GT)
     GIGA_allocate_t tensor_params;
     tensor_params.memory_zone_id = 0;
     tensor_params.offset = offset;
-    offset += tensor_size_in_bytes(&tensor);
+    offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
     if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
     {
         std::cerr << "Error allocating tensor tensor" << std::endl;
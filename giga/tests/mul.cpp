@@ -0,0 +1,209 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \date 16/01/2025
+ */
+#include <giga/giga.h>
+#include "utils.h"
+
+#include <algorithm>
+
+GIGA_error multiplication_test(GIGA_data_type GT, const std::vector<uint32_t> &a_dims, const std::vector<uint32_t> &b_dims, uint8_t a_shift = 0, uint8_t b_shift = 0, uint8_t out_shift = 0)
+{
+    ScopedMessage msg;
+    msg << "Mul " << giga_data_type_str(GT) << ", a_shift " << int(a_shift) << ", b_shift " << int(b_shift) << ", out_shift " << int(out_shift) << ", a (";
+    for(const uint32_t dim : a_dims)
+        msg << " " << dim;
+    msg << " ), b (";
+    for(const uint32_t dim : b_dims)
+        msg << " " << dim;
+    msg << " )\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+        return error;
+
+    // Broadcast shape, right aligned
+    const uint32_t nb_dims = std::max(a_dims.size(), b_dims.size());
+    std::vector<uint32_t> a_full(nb_dims, 1), b_full(nb_dims, 1), out_dims(nb_dims);
+    std::copy(a_dims.begin(), a_dims.end(), a_full.end() - a_dims.size());
+    std::copy(b_dims.begin(), b_dims.end(), b_full.end() - b_dims.size());
+    for(uint32_t i = 0; i < nb_dims; ++i)
+        out_dims[i] = std::max(a_full[i], b_full[i]);
+
+    size_t offset = 0;
+
+    GIGA_tensor_t tensors[4];
+    const std::vector<uint32_t> * const dims[4] = {&a_dims, &b_dims, &out_dims, &out_dims};
+    const uint8_t shifts[4] = {a_shift, b_shift, out_shift, out_shift};
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = dims[i]->size();
+        for(uint32_t d = 0; d < tensor.nb_dims; ++d)
+            tensor.dims[d] = (*dims[i])[d];
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = shifts[i];
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return error;
+        }
+    }
+    GIGA_tensor_t &a = tensors[0];
+    GIGA_tensor_t &b = tensors[1];
+    GIGA_tensor_t &out = tensors[2];
+    GIGA_tensor_t &result = tensors[3];
+
+    std::vector<float> data_a(tensor_elements_count(&a));
+    std::vector<float> data_b(tensor_elements_count(&b));
+    // Values chosen so that the products are exact with the tested shifts
+    const float a_offset = is_signed(GT) ? 4.f : 0.f;
+    const float b_offset = is_signed(GT) ? 3.f : 0.f;
+    for(size_t i = 0; i < data_a.size(); ++i)
+        data_a[i] = (float(i % 9) - a_offset) / 2.f;
+    for(size_t i = 0; i < data_b.size(); ++i)
+        data_b[i] = (float((i * 3) % 7) - b_offset) / 2.f;
+
+    if ((error = giga_copy_to_tensor(data_a.data(), GIGA_Float32, 0, &a)) != GIGA_Success
+        || (error = giga_copy_to_tensor(data_b.data(), GIGA_Float32, 0, &b)) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error filling tensor with data" << std::endl;
+        return error;
+    }
+
+    // Fill output with garbage to make sure we don't test an unwritten tensor
+    fill_contiguous_tensor_with_random_data(out, 0.f, 100.f);
+
+    GIGA_mul_t mul_params;
+    if((error = giga_mul(&mul_params, &a, &b, &out) ) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing mul on a and b to out" << std::endl;
+        return error;
+    }
+
+    // Reference computed on the host
+    std::vector<float> data_result(tensor_elements_count(&out));
+    for(size_t i = 0; i < data_result.size(); ++i)
+    {
+        size_t rem = i;
+        size_t a_index = 0, b_index = 0, a_stride = 1, b_stride = 1;
+        for(int32_t d = nb_dims - 1; d >= 0; --d)
+        {
+            const size_t idx = rem % out_dims[d];
+            rem /= out_dims[d];
+            a_index += (a_full[d] == 1 ? 0 : idx) * a_stride;
+            b_index += (b_full[d] == 1 ? 0 : idx) * b_stride;
+            a_stride *= a_full[d];
+            b_stride *= b_full[d];
+        }
+        data_result[i] = data_a[a_index] * data_b[b_index];
+    }
+
+    if ((error = giga_copy_to_tensor(data_result.data(), GIGA_Float32, 0, &result)) != GIGA_Success)
+    {
+        std::cerr << "Error filling tensor with data" << std::endl;
+        return error;
+    }
+
+    if(!compare_tensors(&out, &result))
+    {
+        print_tensor(msg, a, "a");
+        print_tensor(msg, b, "b");
+        print_tensor(msg, out, "out");
+        print_tensor(msg, result, "result");
+        std::cerr << "Error comparing tensors" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    //Clean up
+    for(GIGA_tensor_t &tensor : tensors)
+    {
+        if((error = giga_release_tensor(&tensor) ) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return error;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
+int main()
+{
+    GIGA_error error = GIGA_Success;
+
+#define EARLY_ABORT() throw std::runtime_error("Error")
+
+    try
+    {
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_SFixed8, GIGA_SFixed16, GIGA_UFixed8, GIGA_UFixed16})
+        {
+            // Same shapes, per channel scale, per pixel map and two sided broadcast
+            // Fixed point values need one fractional bit to be exact
+            const uint8_t in_shift = is_float(GT) ? 0 : 1;
+            const uint8_t out_shift = is_float(GT) ? 0 : 2;
+            if((error = multiplication_test(GT, {2, 3, 4, 5}, {2, 3, 4, 5}, in_shift, in_shift, out_shift)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = multiplication_test(GT, {2, 3, 4, 5}, {3, 1, 1}, in_shift, in_shift, out_shift)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = multiplication_test(GT, {1, 4, 5}, {2, 3, 4, 5}, in_shift, in_shift, out_shift)) != GIGA_Success)
+                EARLY_ABORT();
+            if((error = multiplication_test(GT, {2, 1, 4, 1}, {3, 1, 5}, in_shift, in_shift, out_shift)) != GIGA_Success)
+                EARLY_ABORT();
+        }
+        for(GIGA_data_type GT : {GIGA_SFixed8, GIGA_SFixed16, GIGA_UFixed8, GIGA_UFixed16})
+        {
+            // Products are exact with a fp_shift of 2 or more
+            for(uint8_t out_shift = 2; out_shift < 5; out_shift++)
+            {
+                if((error = multiplication_test(GT, {2, 3, 4, 5}, {3, 1, 1}, 1, 1, out_shift)) != GIGA_Success)
+                    EARLY_ABORT();
+                if((error = multiplication_test(GT, {2, 3, 4, 5}, {2, 3, 4, 5}, 2, 1, out_shift)) != GIGA_Success)
+                    EARLY_ABORT();
+            }
+            // Output representations too small for the products, which saturate (the expected values are saturated when copied to the result tensor)
+            for(uint8_t out_shift : {16, 28})
+            {
+                if((error = multiplication_test(GT, {2, 3, 4, 5}, {2, 3, 4, 5}, 1, 1, out_shift)) != GIGA_Success)
+                    EARLY_ABORT();
+            }
+        }
+    }
+    catch(const std::exception &e)
+    {
+        if (error != GIGA_Success)
+            std::cerr << "Error: " << giga_str_error(error) << std::endl;
+        else
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            error = GIGA_Unknown_Error;
+        }
+    }
+
+    return error;
+}
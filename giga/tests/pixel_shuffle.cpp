@@ -0,0 +1,198 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \date 16/01/2025
+ */
+
+#include <giga/giga.h>
+#include "utils.h"
+
+static const char *depth_order_str(GIGA_depth_order order)
+{
+    switch(order)
+    {
+    case GIGA_Depth_Channel_Major:  return "channel major";
+    case GIGA_Depth_Block_Major:    return "block major";
+    default:                        return "unknown";
+    }
+}
+
+GIGA_error pixel_shuffle_test(GIGA_data_type GT, uint32_t block_size, GIGA_depth_order order, uint8_t fp_shift = 0)
+{
+    ScopedMessage msg;
+    msg << "Space to depth / depth to space " << giga_data_type_str(GT)
+        << ", block size " << block_size
+        << ", " << depth_order_str(order)
+        << ", fp_shift " << int(fp_shift) << "\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+        return error;
+
+    const uint32_t N = 2;
+    const uint32_t C = 3;
+    const uint32_t H = 5;
+    const uint32_t W = 7;
+    const uint32_t B = block_size;
+
+    size_t offset = 0;
+
+    // space, depth, expected depth, space rebuilt from depth
+    GIGA_tensor_t tensors[4];
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        const bool b_depth = i == 1 || i == 2;
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = 4;
+        tensor.dims[0] = N;
+        tensor.dims[1] = b_depth ? C * B * B : C;
+        tensor.dims[2] = b_depth ? H : H * B;
+        tensor.dims[3] = b_depth ? W : W * B;
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = fp_shift;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return error;
+        }
+    }
+    GIGA_tensor_t &space = tensors[0];
+    GIGA_tensor_t &depth = tensors[1];
+    GIGA_tensor_t &result = tensors[2];
+    GIGA_tensor_t &rebuilt = tensors[3];
+
+    // Distinct integer values in the range of all tested types
+    const float data_offset = is_signed(GT) ? 60.f : 0.f;
+    std::vector<float> data(N * C * H * B * W * B);
+    for(size_t i = 0; i < data.size(); ++i)
+        data[i] = float((i * 37) % 121) - data_offset;
+
+    fill_4d_tensor(data.data(), space);
+
+    // Fill outputs with garbage to make sure we don't test an unwritten tensor
+    fill_contiguous_tensor_with_random_data(depth, 0.f, 100.f);
+    fill_contiguous_tensor_with_random_data(rebuilt, 0.f, 100.f);
+
+    GIGA_space_to_depth_t space_to_depth_params;
+    space_to_depth_params.block_size = B;
+    space_to_depth_params.order = order;
+
+    if((error = giga_space_to_depth(&space_to_depth_params, &space, &depth)) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            std::cout << "Type not implemented!" << std::endl;
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing giga_space_to_depth" << std::endl;
+        return error;
+    }
+
+    // Reference computed on the host
+    std::vector<float> data_result(data.size());
+    for(uint32_t n = 0; n < N; ++n)
+        for(uint32_t c = 0; c < C; ++c)
+            for(uint32_t y = 0; y < H * B; ++y)
+                for(uint32_t x = 0; x < W * B; ++x)
+                {
+                    const uint32_t i = y % B;
+                    const uint32_t j = x % B;
+                    const uint32_t depth_c = order == GIGA_Depth_Channel_Major ? (c * B + i) * B + j : (i * B + j) * C + c;
+                    data_result[((n * C * B * B + depth_c) * H + y / B) * W + x / B] = data[((n * C + c) * H * B + y) * W * B + x];
+                }
+
+    fill_4d_tensor(data_result.data(), result);
+
+    if(!compare_tensors(&depth, &result))
+    {
+        print_tensor(msg, depth, "giga_space_to_depth output");
+        print_tensor(msg, result, "expected output");
+        std::cerr << "Error comparing tensors depth and result" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    // Depth to space is the inverse operation
+    GIGA_depth_to_space_t depth_to_space_params;
+    depth_to_space_params.block_size = B;
+    depth_to_space_params.order = order;
+
+    if((error = giga_depth_to_space(&depth_to_space_params, &depth, &rebuilt)) != GIGA_Success)
+    {
+        std::cerr << "Error performing giga_depth_to_space" << std::endl;
+        return error;
+    }
+
+    if(!compare_tensors(&rebuilt, &space))
+    {
+        print_tensor(msg, rebuilt, "giga_depth_to_space output");
+        print_tensor(msg, space, "expected output");
+        std::cerr << "Error comparing tensors rebuilt and space" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    for(GIGA_tensor_t &t : tensors)
+    {
+        if((error = giga_release_tensor(&t)) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return error;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
+int main()
+{
+    GIGA_error error = GIGA_Success;
+
+#define EARLY_ABORT() throw std::runtime_error("Error")
+
+    try
+    {
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_SFixed8, GIGA_SFixed16, GIGA_UFixed8, GIGA_UFixed16})
+        {
+            for(uint32_t block_size : {1, 2, 3})
+            {
+                for(GIGA_depth_order order : {GIGA_Depth_Channel_Major, GIGA_Depth_Block_Major})
+                {
+                    if((error = pixel_shuffle_test(GT, block_size, order)) != GIGA_Success)
+                        EARLY_ABORT();
+                }
+            }
+
+            // Fixed point values are moved without any change of representation
+            if(!is_float(GT))
+            {
+                if((error = pixel_shuffle_test(GT, 2, GIGA_Depth_Channel_Major, 2)) != GIGA_Success)
+                    EARLY_ABORT();
+            }
+        }
+    }
+    catch(const std::exception &e)
+    {
+        if (error != GIGA_Success)
+            std::cerr << "Error: " << giga_str_error(error) << std::endl;
+        else
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            error = GIGA_Unknown_Error;
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,228 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \date 16/01/2025
+ */
+
+#include <giga/giga.h>
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static const char *pool_mode_str(GIGA_pool_mode mode)
+{
+    switch(mode)
+    {
+    case GIGA_Pool_Average: return "average";
+    case GIGA_Pool_Max:     return "max";
+    default:                return "unknown";
+    }
+}
+
+GIGA_error pool2d_test(GIGA_data_type GT, GIGA_pool_mode mode, uint32_t kernel_size, uint32_t stride, int32_t padding_begin, int32_t padding_end, bool b_exclude_padding, uint8_t in_shift = 0, uint8_t out_shift = 0)
+{
+    ScopedMessage msg;
+    msg << "Pool2d " << giga_data_type_str(GT) << " " << pool_mode_str(mode)
+        << ", kernel " << kernel_size
+        << ", stride " << stride
+        << ", padding " << padding_begin << "/" << padding_end
+        << (b_exclude_padding ? ", exclude padding" : "")
+        << ", in_shift " << int(in_shift)
+        << ", out_shift " << int(out_shift) << "\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+        return error;
+
+    const uint32_t N = 2;
+    const uint32_t C = 3;
+    const uint32_t H = 7;
+    const uint32_t W = 11;
+    const uint32_t out_H = (H + padding_begin + padding_end - kernel_size) / stride + 1;
+    const uint32_t out_W = (W + padding_begin + padding_end - kernel_size) / stride + 1;
+
+    size_t offset = 0;
+
+    GIGA_tensor_t tensors[3];
+    for(uint32_t i = 0; i < 3; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = 4;
+        tensor.dims[0] = N;
+        tensor.dims[1] = C;
+        tensor.dims[2] = i == 0 ? H : out_H;
+        tensor.dims[3] = i == 0 ? W : out_W;
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = i == 0 ? in_shift : out_shift;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return error;
+        }
+    }
+    GIGA_tensor_t &tensor = tensors[0];
+    GIGA_tensor_t &pooled = tensors[1];
+    GIGA_tensor_t &result = tensors[2];
+
+    // Integer values in the range of all tested types
+    const float data_offset = is_signed(GT) ? 60.f : 0.f;
+    std::vector<float> data(N * C * H * W);
+    for(size_t i = 0; i < data.size(); ++i)
+        data[i] = float((i * 37) % 121) - data_offset;
+
+    fill_4d_tensor(data.data(), tensor);
+
+    // Fill output with garbage to make sure we don't test an unwritten tensor
+    fill_contiguous_tensor_with_random_data(pooled, 0.f, 100.f);
+
+    GIGA_pool2d_t pool_params;
+    pool_params.mode = mode;
+    pool_params.kernel_size[0] = kernel_size;
+    pool_params.kernel_size[1] = kernel_size;
+    pool_params.stride[0] = stride;
+    pool_params.stride[1] = stride;
+    pool_params.padding[0][0] = padding_begin;
+    pool_params.padding[0][1] = padding_end;
+    pool_params.padding[1][0] = padding_begin;
+    pool_params.padding[1][1] = padding_end;
+    pool_params.b_exclude_padding = b_exclude_padding;
+
+    if((error = giga_pool2d(&pool_params, &tensor, &pooled)) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            std::cout << "Type not implemented!" << std::endl;
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing giga_pool2d" << std::endl;
+        return error;
+    }
+
+    // Reference computed on the host
+    const double out_scale = double(1 << out_shift);
+    std::vector<float> data_result(N * C * out_H * out_W);
+    for(uint32_t nc = 0; nc < N * C; ++nc)
+        for(uint32_t y = 0; y < out_H; ++y)
+            for(uint32_t x = 0; x < out_W; ++x)
+            {
+                const float * const in_ptr = data.data() + nc * H * W;
+                double sum = 0;
+                double max = -std::numeric_limits<double>::infinity();
+                uint32_t count = 0;
+                for(uint32_t ky = 0; ky < kernel_size; ++ky)
+                    for(uint32_t kx = 0; kx < kernel_size; ++kx)
+                    {
+                        const int32_t in_y = int32_t(y * stride + ky) - padding_begin;
+                        const int32_t in_x = int32_t(x * stride + kx) - padding_begin;
+                        if(in_y < 0 || in_y >= int32_t(H) || in_x < 0 || in_x >= int32_t(W))
+                            continue;
+                        const double value = in_ptr[in_y * W + in_x];
+                        sum += value;
+                        max = std::max(max, value);
+                        ++count;
+                    }
+
+                double value = max;
+                if(mode == GIGA_Pool_Average)
+                {
+                    value = sum / (b_exclude_padding ? count : kernel_size * kernel_size);
+                    // Fixed point averages are rounded to the nearest value of the output representation
+                    if(!is_float(GT))
+                        value = std::round(value * out_scale) / out_scale;
+                }
+                data_result[(nc * out_H + y) * out_W + x] = float(value);
+            }
+
+    fill_4d_tensor(data_result.data(), result);
+
+    const double epsilon = is_float(GT) ? (GT == GIGA_Float16 ? 0.1 : 1e-4) : 0.0;
+    if(!compare_tensors(&pooled, &result, epsilon))
+    {
+        print_tensor(msg, tensor, "giga_pool2d input");
+        print_tensor(msg, pooled, "giga_pool2d output");
+        print_tensor(msg, result, "expected output");
+        std::cerr << "Error comparing tensors pooled and result" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    for(GIGA_tensor_t &t : tensors)
+    {
+        if((error = giga_release_tensor(&t)) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return error;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
+int main()
+{
+    GIGA_error error = GIGA_Success;
+
+#define EARLY_ABORT() throw std::runtime_error("Error")
+
+    try
+    {
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_SFixed8, GIGA_SFixed16, GIGA_UFixed8, GIGA_UFixed16})
+        {
+            for(GIGA_pool_mode mode : {GIGA_Pool_Average, GIGA_Pool_Max})
+            {
+                for(uint32_t kernel_size : {2, 3})
+                {
+                    for(uint32_t stride : {1, 2})
+                    {
+                        for(int32_t padding = 0; padding < int32_t(kernel_size); ++padding)
+                        {
+                            for(bool b_exclude_padding : {false, true})
+                            {
+                                if((error = pool2d_test(GT, mode, kernel_size, stride, padding, padding, b_exclude_padding)) != GIGA_Success)
+                                    EARLY_ABORT();
+                            }
+                        }
+                        // Assymetric padding as used by "same" pooling with even kernels
+                        if((error = pool2d_test(GT, mode, kernel_size, stride, 0, 1, true)) != GIGA_Success)
+                            EARLY_ABORT();
+                    }
+                }
+
+                // Fixed point alignment between input and output
+                if(!is_float(GT))
+                {
+                    if((error = pool2d_test(GT, mode, 2, 2, 0, 0, false, 1, 0)) != GIGA_Success)
+                        EARLY_ABORT();
+                    if((error = pool2d_test(GT, mode, 3, 2, 1, 1, false, 0, 1)) != GIGA_Success)
+                        EARLY_ABORT();
+                }
+            }
+        }
+    }
+    catch(const std::exception &e)
+    {
+        if (error != GIGA_Success)
+            std::cerr << "Error: " << giga_str_error(error) << std::endl;
+        else
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            error = GIGA_Unknown_Error;
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,204 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \date 16/01/2025
+ */
+
+#include <giga/giga.h>
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+
+static const char *pyramid_filter_str(GIGA_pyramid_filter filter)
+{
+    switch(filter)
+    {
+    case GIGA_Pyramid_Box:      return "box";
+    case GIGA_Pyramid_Gaussian: return "gaussian";
+    default:                    return "unknown";
+    }
+}
+
+GIGA_error pyramid_test(GIGA_data_type GT, GIGA_pyramid_filter filter, uint8_t level_shift = 0)
+{
+    ScopedMessage msg;
+    msg << "Pyramid " << giga_data_type_str(GT) << " " << pyramid_filter_str(filter)
+        << ", level_shift " << int(level_shift) << "\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+        return error;
+
+    const uint32_t N = 2;
+    const uint32_t C = 3;
+    const uint32_t nb_levels = 4;
+
+    // Odd sizes so that border replication is exercised at every level
+    uint32_t H[nb_levels + 1] = {37};
+    uint32_t W[nb_levels + 1] = {50};
+    for(uint32_t l = 1; l <= nb_levels; ++l)
+    {
+        H[l] = (H[l - 1] + 1) / 2;
+        W[l] = (W[l - 1] + 1) / 2;
+    }
+
+    size_t offset = 0;
+
+    // input, levels, expected levels
+    GIGA_tensor_t tensors[2 * nb_levels + 1];
+    for(uint32_t i = 0; i < 2 * nb_levels + 1; ++i)
+    {
+        const uint32_t level = i == 0 ? 0 : (i - 1) % nb_levels + 1;
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = 4;
+        tensor.dims[0] = N;
+        tensor.dims[1] = C;
+        tensor.dims[2] = H[level];
+        tensor.dims[3] = W[level];
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = level > 0 ? level_shift : 0;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return error;
+        }
+    }
+    GIGA_tensor_t &tensor = tensors[0];
+    GIGA_tensor_t * const levels = tensors + 1;
+    GIGA_tensor_t * const results = tensors + 1 + nb_levels;
+
+    // Integer values in the range of all tested types
+    const float data_offset = is_signed(GT) ? 60.f : 0.f;
+    std::vector<float> data(N * C * H[0] * W[0]);
+    for(size_t i = 0; i < data.size(); ++i)
+        data[i] = float((i * 37) % 121) - data_offset;
+
+    fill_4d_tensor(data.data(), tensor);
+
+    // Fill outputs with garbage to make sure we don't test an unwritten tensor
+    for(uint32_t l = 0; l < nb_levels; ++l)
+        fill_contiguous_tensor_with_random_data(levels[l], 0.f, 10.f);
+
+    GIGA_pyramid_t pyramid_params;
+    pyramid_params.filter = filter;
+    pyramid_params.nb_levels = nb_levels;
+
+    if((error = giga_pyramid(&pyramid_params, &tensor, levels)) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            std::cout << "Type not implemented!" << std::endl;
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing giga_pyramid" << std::endl;
+        return error;
+    }
+
+    // Reference computed on the host, each level from the rounded previous one
+    const uint32_t size = filter == GIGA_Pyramid_Box ? 2 : 5;
+    const int32_t begin = filter == GIGA_Pyramid_Box ? 0 : -2;
+    const float taps[2][5] = {{1.f, 1.f}, {1.f, 4.f, 6.f, 4.f, 1.f}};
+    const float * const w = taps[filter == GIGA_Pyramid_Box ? 0 : 1];
+    const double norm = filter == GIGA_Pyramid_Box ? 4.0 : 256.0;
+
+    std::vector<float> src = data;
+    for(uint32_t l = 1; l <= nb_levels; ++l)
+    {
+        const double scale = double(1 << level_shift);
+        std::vector<float> dst(N * C * H[l] * W[l]);
+        for(uint32_t nc = 0; nc < N * C; ++nc)
+            for(uint32_t y = 0; y < H[l]; ++y)
+                for(uint32_t x = 0; x < W[l]; ++x)
+                {
+                    double sum = 0;
+                    for(uint32_t ky = 0; ky < size; ++ky)
+                        for(uint32_t kx = 0; kx < size; ++kx)
+                        {
+                            const int32_t sy = std::min(std::max(int32_t(2 * y) + begin + int32_t(ky), 0), int32_t(H[l - 1]) - 1);
+                            const int32_t sx = std::min(std::max(int32_t(2 * x) + begin + int32_t(kx), 0), int32_t(W[l - 1]) - 1);
+                            sum += w[ky] * w[kx] * src[(nc * H[l - 1] + sy) * W[l - 1] + sx];
+                        }
+
+                    double value = sum / norm;
+                    // Fixed point values are rounded to the nearest value of the level representation
+                    if(!is_float(GT))
+                        value = std::round(value * scale) / scale;
+                    dst[(nc * H[l] + y) * W[l] + x] = float(value);
+                }
+
+        fill_4d_tensor(dst.data(), results[l - 1]);
+
+        const double epsilon = is_float(GT) ? (GT == GIGA_Float16 ? 0.15 : 1e-4) : 0.0;
+        if(!compare_tensors(&levels[l - 1], &results[l - 1], epsilon))
+        {
+            print_tensor(msg, levels[l - 1], "giga_pyramid output");
+            print_tensor(msg, results[l - 1], "expected output");
+            std::cerr << "Error comparing tensors of level " << l << std::endl;
+            return GIGA_Unknown_Error;
+        }
+        src.swap(dst);
+    }
+
+    for(GIGA_tensor_t &t : tensors)
+    {
+        if((error = giga_release_tensor(&t)) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return error;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
+int main()
+{
+    GIGA_error error = GIGA_Success;
+
+#define EARLY_ABORT() throw std::runtime_error("Error")
+
+    try
+    {
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_SFixed8, GIGA_SFixed16, GIGA_UFixed8, GIGA_UFixed16})
+        {
+            for(GIGA_pyramid_filter filter : {GIGA_Pyramid_Box, GIGA_Pyramid_Gaussian})
+            {
+                if((error = pyramid_test(GT, filter)) != GIGA_Success)
+                    EARLY_ABORT();
+
+                // Levels gain one bit of precision over the input
+                if(!is_float(GT))
+                {
+                    if((error = pyramid_test(GT, filter, 1)) != GIGA_Success)
+                        EARLY_ABORT();
+                }
+            }
+        }
+    }
+    catch(const std::exception &e)
+    {
+        if (error != GIGA_Success)
+            std::cerr << "Error: " << giga_str_error(error) << std::endl;
+        else
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            error = GIGA_Unknown_Error;
+        }
+    }
+
+    return error;
+}
@@ -43,7 +43,7 @@ GIGA_error reshape_test(GIGA_data_type GT)
     GIGA_allocate_t tensor_params;
     tensor_params.memory_zone_id = 0;
     tensor_params.offset = offset;
-    offset += tensor_size_in_bytes(&tensor);
+    offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
     error = giga_allocate_tensor(&tensor, &tensor_params);
     if(error != GIGA_Success)
     {
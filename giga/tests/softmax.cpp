@@ -7,12 +7,13 @@
 
 #include "utils.h"
 
-GIGA_error softmax_test(GIGA_data_type i_GT, GIGA_data_type o_GT)
+GIGA_error softmax_test(GIGA_data_type i_GT, GIGA_data_type o_GT, uint8_t in_shift = 0, uint8_t out_shift = 0)
 {
     ScopedMessage msg;
 
     msg << "Softmax, in " << giga_data_type_str(i_GT)
-        << ", out " << giga_data_type_str(o_GT) << "\n";
+        << ", out " << giga_data_type_str(o_GT)
+        << ", in_shift " << int(in_shift) << ", out_shift " << int(out_shift) << "\n";
 
     GIGA_error error;
     uint32_t device_id = giga_get_default_device_id(&error);
@@ -41,12 +42,12 @@ GIGA_error softmax_test(GIGA_data_type i_GT, GIGA_data_type o_GT)
     tensor.device_id = device_id;
     tensor.data = NULL;
     tensor.type = i_GT;
-    tensor.fp_shift = 0;
+    tensor.fp_shift = in_shift;
 
     GIGA_allocate_t tensor_params;
     tensor_params.memory_zone_id = 0;
     tensor_params.offset = offset;
-    offset += tensor_size_in_bytes(&tensor);
+    offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
     error = giga_allocate_tensor(&tensor, &tensor_params);
     if(error != GIGA_Success)
     {
@@ -83,12 +84,12 @@ GIGA_error softmax_test(GIGA_data_type i_GT, GIGA_data_type o_GT)
     softmaxed.device_id = device_id;
     softmaxed.data = NULL;
     softmaxed.type = o_GT;
-    softmaxed.fp_shift = 0;
+    softmaxed.fp_shift = out_shift;
 
     GIGA_allocate_t softmaxed_params;
     softmaxed_params.memory_zone_id = 0;
     softmaxed_params.offset = offset;
-    offset += tensor_size_in_bytes(&softmaxed);
+    offset += align_address(tensor_size_in_bytes(&softmaxed), TENSOR_ALIGNMENT);
     error = giga_allocate_tensor(&softmaxed, &softmaxed_params);
     if(error != GIGA_Success)
     {
@@ -124,7 +125,7 @@ GIGA_error softmax_test(GIGA_data_type i_GT, GIGA_data_type o_GT)
     result.device_id = device_id;
     result.type = o_GT;
     result.data = NULL;
-    result.fp_shift = 0;
+    result.fp_shift = out_shift;
 
     float data_result[3*5*5] = {4.6831e-01f, 4.9546e-01f, 4.9938e-01f, 4.9992e-01f, 4.9999e-01f,
                                 4.2232e-01f, 4.6831e-01f, 4.8786e-01f, 4.9546e-01f, 4.9832e-01f,
@@ -147,7 +148,7 @@ GIGA_error softmax_test(GIGA_data_type i_GT, GIGA_data_type o_GT)
     GIGA_allocate_t result_params;
     result_params.memory_zone_id = 0;
     result_params.offset = offset;
-    offset += tensor_size_in_bytes(&result);
+    offset += align_address(tensor_size_in_bytes(&result), TENSOR_ALIGNMENT);
     error = giga_allocate_tensor(&result, &result_params);
     if(error != GIGA_Success)
     {
@@ -158,7 +159,9 @@ GIGA_error softmax_test(GIGA_data_type i_GT, GIGA_data_type o_GT)
     fill_4d_tensor(data_result, result);
     print_tensor(msg, result, "expected output");
 
-    if(!compare_tensors(&softmaxed, &result, 0.01))
+    // The reference is truncated when converted to fixed point, hence the extra quantization step
+    const double epsilon = out_shift ? std::max(0.01, 1.5 / (1 << out_shift)) : 0.01;
+    if(!compare_tensors(&softmaxed, &result, epsilon))
     {
         std::cerr << "Error comparing tensors softmaxed and result" << std::endl;
         return GIGA_Unknown_Error;
@@ -191,6 +194,170 @@ GIGA_error softmax_test(GIGA_data_type i_GT, GIGA_data_type o_GT)
     return GIGA_Success;
 }
 
+GIGA_error softmax_channels_test(GIGA_data_type i_GT, GIGA_data_type o_GT, uint8_t in_shift = 0, uint8_t out_shift = 0)
+{
+    ScopedMessage msg;
+
+    msg << "Softmax along channels, in " << giga_data_type_str(i_GT)
+        << ", out " << giga_data_type_str(o_GT)
+        << ", in_shift " << int(in_shift) << ", out_shift " << int(out_shift) << "\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error getting default device id" << std::endl;
+        return error;
+    }
+
+    error = giga_initialize_device(device_id);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error initializing device" << std::endl;
+        return error;
+    }
+
+    // Sizes chosen so that the image is not a multiple of any reasonable tile size
+    const uint32_t N = 2;
+    const uint32_t C = 21;
+    const uint32_t H = 17;
+    const uint32_t W = 19;
+
+    size_t offset = 0;
+
+    GIGA_tensor_t tensor;
+    tensor.nb_dims = 4;
+    tensor.dims[0] = N;
+    tensor.dims[1] = C;
+    tensor.dims[2] = H;
+    tensor.dims[3] = W;
+    tensor.device_id = device_id;
+    tensor.data = NULL;
+    tensor.type = i_GT;
+    tensor.fp_shift = in_shift;
+
+    GIGA_allocate_t tensor_params;
+    tensor_params.memory_zone_id = 0;
+    tensor_params.offset = offset;
+    offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+    error = giga_allocate_tensor(&tensor, &tensor_params);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor tensor" << std::endl;
+        return error;
+    }
+
+    std::vector<float> data(N * C * H * W);
+    uint32_t seed = 42;
+    for(float &value : data)
+        value = float(rand_r(&seed) % 161) / 16.f - 5.f;
+
+    fill_4d_tensor(data.data(), tensor);
+
+    GIGA_tensor_t softmaxed = tensor;
+    softmaxed.data = NULL;
+    softmaxed.type = o_GT;
+    softmaxed.fp_shift = out_shift;
+
+    GIGA_allocate_t softmaxed_params;
+    softmaxed_params.memory_zone_id = 0;
+    softmaxed_params.offset = offset;
+    offset += align_address(tensor_size_in_bytes(&softmaxed), TENSOR_ALIGNMENT);
+    error = giga_allocate_tensor(&softmaxed, &softmaxed_params);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor softmaxed" << std::endl;
+        return error;
+    }
+
+    // Fill output with garbage to make sure we don't test an unwritten tensor
+    fill_contiguous_tensor_with_random_data(softmaxed, 0.f, 255.f);
+
+    GIGA_softmax_t softmax_params;
+    error = giga_softmax(&softmax_params, &tensor, &softmaxed);
+    if(error != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            std::cout << "Type not implemented!" << std::endl;
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing giga_softmax" << std::endl;
+        return error;
+    }
+
+    // Reference softmax computed on the host
+    std::vector<float> data_result(data.size());
+    for(uint32_t n = 0; n < N; ++n)
+        for(uint32_t p = 0; p < H * W; ++p)
+        {
+            const float * const in_ptr = data.data() + n * C * H * W + p;
+            float * const out_ptr = data_result.data() + n * C * H * W + p;
+            float max_value = in_ptr[0];
+            for(uint32_t c = 1; c < C; ++c)
+                max_value = std::max(max_value, in_ptr[c * H * W]);
+            float sum = 0.f;
+            for(uint32_t c = 0; c < C; ++c)
+                sum += out_ptr[c * H * W] = std::exp(in_ptr[c * H * W] - max_value);
+            for(uint32_t c = 0; c < C; ++c)
+                out_ptr[c * H * W] /= sum;
+        }
+
+    GIGA_tensor_t result = softmaxed;
+    result.data = NULL;
+
+    GIGA_allocate_t result_params;
+    result_params.memory_zone_id = 0;
+    result_params.offset = offset;
+    offset += align_address(tensor_size_in_bytes(&result), TENSOR_ALIGNMENT);
+    error = giga_allocate_tensor(&result, &result_params);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor result" << std::endl;
+        return error;
+    }
+
+    fill_4d_tensor(data_result.data(), result);
+
+    // The reference is truncated when converted to fixed point, hence the extra quantization step
+    const double epsilon = out_shift ? std::max(0.01, 1.5 / (1 << out_shift)) : 0.01;
+    if(!compare_tensors(&softmaxed, &result, epsilon))
+    {
+        print_tensor(msg, softmaxed, "giga_softmax output");
+        print_tensor(msg, result, "expected output");
+        std::cerr << "Error comparing tensors softmaxed and result" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    error = giga_release_tensor(&tensor);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error releasing tensor tensor" << std::endl;
+        return error;
+    }
+
+    error = giga_release_tensor(&softmaxed);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error releasing tensor softmaxed" << std::endl;
+        return error;
+    }
+
+    error = giga_release_tensor(&result);
+    if(error != GIGA_Success)
+    {
+        std::cerr << "Error releasing tensor result" << std::endl;
+        return error;
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
 int main()
 {
     GIGA_error error = GIGA_Success;
@@ -203,6 +370,18 @@ int main()
             EARLY_ABORT();
         if((error = softmax_test(GIGA_Float16, GIGA_Float16)) != GIGA_Success)
             EARLY_ABORT();
+        if((error = softmax_channels_test(GIGA_Float32, GIGA_Float32)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = softmax_channels_test(GIGA_Float16, GIGA_Float16)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = softmax_test(GIGA_SFixed8, GIGA_SFixed8, 1, 6)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = softmax_test(GIGA_SFixed16, GIGA_SFixed16, 8, 14)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = softmax_channels_test(GIGA_SFixed8, GIGA_SFixed8, 4, 7)) != GIGA_Success)
+            EARLY_ABORT();
+        if((error = softmax_channels_test(GIGA_SFixed16, GIGA_SFixed16, 4, 14)) != GIGA_Success)
+            EARLY_ABORT();
     }
     catch(const std::exception &e)
     {
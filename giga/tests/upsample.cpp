@@ -5,6 +5,27 @@
 
 #include <giga/giga.h>
 #include "utils.h"
+#include <algorithm>
+#include <cmath>
+
+static const char *upsample_mode_str(GIGA_upsample_mode mode)
+{
+    switch(mode)
+    {
+    case GIGA_Upsample_Nearest:                 return "nearest";
+    case GIGA_Upsample_Bilinear:                return "bilinear";
+    case GIGA_Upsample_Bilinear_Align_Corners:  return "bilinear align corners";
+    }
+    return "unknown";
+}
+
+// Source coordinate of an output coordinate, following the PyTorch conventions for align_corners
+static float source_coordinate(uint32_t o, uint32_t in_size, uint32_t out_size, GIGA_upsample_mode mode)
+{
+    if(mode == GIGA_Upsample_Bilinear_Align_Corners)
+        return out_size > 1 ? float(o) * float(in_size - 1) / float(out_size - 1) : 0.f;
+    return std::max((float(o) + 0.5f) / float(out_size / in_size) - 0.5f, 0.f);
+}
 
 GIGA_error upsample_test(GIGA_data_type GT)
 {
@@ -41,7 +62,7 @@ GIGA_error upsample_test(GIGA_data_type GT)
     GIGA_allocate_t tensor_params;
     tensor_params.memory_zone_id = 0;
     tensor_params.offset = offset;
-    offset += align_address(tensor_size_in_bytes(&tensor), element_size_in_bits(&tensor) / 8);
+    offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
     error = giga_allocate_tensor(&tensor, &tensor_params);
     if(error != GIGA_Success)
     {
@@ -75,7 +96,7 @@ GIGA_error upsample_test(GIGA_data_type GT)
     GIGA_allocate_t upsampled_params;
     upsampled_params.memory_zone_id = 0;
     upsampled_params.offset = offset;
-    offset += align_address(tensor_size_in_bytes(&upsampled), element_size_in_bits(&upsampled) / 8);
+    offset += align_address(tensor_size_in_bytes(&upsampled), TENSOR_ALIGNMENT);
 
     error = giga_allocate_tensor(&upsampled, &upsampled_params);
     if(error != GIGA_Success)
@@ -89,6 +110,8 @@ GIGA_error upsample_test(GIGA_data_type GT)
 
     GIGA_upsample_t upsample_params;
     upsample_params.factor = 2;
+    upsample_params.mode = GIGA_Upsample_Nearest;
+    upsample_params.addend = NULL;
 
     error = giga_upsample(&upsample_params, &tensor, &upsampled);
     if(error != GIGA_Success)
@@ -117,7 +140,7 @@ GIGA_error upsample_test(GIGA_data_type GT)
     GIGA_allocate_t result_params;
     result_params.memory_zone_id = 0;
     result_params.offset = offset;
-    offset += align_address(tensor_size_in_bytes(&result), element_size_in_bits(&result) / 8);
+    offset += align_address(tensor_size_in_bytes(&result), TENSOR_ALIGNMENT);
     error = giga_allocate_tensor(&result, &result_params);
     if(error != GIGA_Success)
     {
@@ -182,6 +205,300 @@ GIGA_error upsample_test(GIGA_data_type GT)
     return GIGA_Success;
 }
 
+GIGA_error upsample_interpolation_test(GIGA_data_type GT, GIGA_upsample_mode mode, uint32_t factor)
+{
+    ScopedMessage msg;
+    msg << "Upsample " << giga_data_type_str(GT) << " " << upsample_mode_str(mode) << " x" << factor << "\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+        return error;
+
+    const uint32_t N = 2;
+    const uint32_t C = 3;
+    const uint32_t H = 5;
+    const uint32_t W = 7;
+
+    size_t offset = 0;
+
+    GIGA_tensor_t tensors[3];
+    for(uint32_t i = 0; i < 3; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = 4;
+        tensor.dims[0] = N;
+        tensor.dims[1] = C;
+        tensor.dims[2] = i == 0 ? H : H * factor;
+        tensor.dims[3] = i == 0 ? W : W * factor;
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = 0;
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return error;
+        }
+    }
+    GIGA_tensor_t &tensor = tensors[0];
+    GIGA_tensor_t &upsampled = tensors[1];
+    GIGA_tensor_t &result = tensors[2];
+
+    // Integer values in the range of all tested types
+    const float data_offset = is_signed(GT) ? 60.f : 0.f;
+    std::vector<float> data(N * C * H * W);
+    for(size_t i = 0; i < data.size(); ++i)
+        data[i] = float((i * 37) % 121) - data_offset;
+
+    fill_4d_tensor(data.data(), tensor);
+
+    // Fill output with garbage to make sure we don't test an unwritten tensor
+    fill_contiguous_tensor_with_random_data(upsampled, 0.f, 100.f);
+
+    GIGA_upsample_t upsample_params;
+    upsample_params.factor = factor;
+    upsample_params.mode = mode;
+    upsample_params.addend = NULL;
+
+    if((error = giga_upsample(&upsample_params, &tensor, &upsampled)) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            std::cout << "Type not implemented!" << std::endl;
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing giga_upsample" << std::endl;
+        return error;
+    }
+
+    // Reference computed on the host
+    const uint32_t out_H = H * factor;
+    const uint32_t out_W = W * factor;
+    std::vector<float> data_result(N * C * out_H * out_W);
+    for(uint32_t nc = 0; nc < N * C; ++nc)
+        for(uint32_t y = 0; y < out_H; ++y)
+            for(uint32_t x = 0; x < out_W; ++x)
+            {
+                const float * const in_ptr = data.data() + nc * H * W;
+                float value;
+                if(mode == GIGA_Upsample_Nearest)
+                    value = in_ptr[(y / factor) * W + x / factor];
+                else
+                {
+                    const float sy = source_coordinate(y, H, out_H, mode);
+                    const float sx = source_coordinate(x, W, out_W, mode);
+                    const uint32_t y0 = std::min<uint32_t>(uint32_t(sy), H - 1);
+                    const uint32_t x0 = std::min<uint32_t>(uint32_t(sx), W - 1);
+                    const uint32_t y1 = std::min<uint32_t>(y0 + 1, H - 1);
+                    const uint32_t x1 = std::min<uint32_t>(x0 + 1, W - 1);
+                    const float wy = sy - float(y0);
+                    const float wx = sx - float(x0);
+                    value = (in_ptr[y0 * W + x0] * (1.f - wx) + in_ptr[y0 * W + x1] * wx) * (1.f - wy)
+                            + (in_ptr[y1 * W + x0] * (1.f - wx) + in_ptr[y1 * W + x1] * wx) * wy;
+                    if(!is_float(GT))
+                        value = std::round(value);
+                }
+                data_result[(nc * out_H + y) * out_W + x] = value;
+            }
+
+    fill_4d_tensor(data_result.data(), result);
+
+    // Fixed point results may differ by one unit when rounding ties, Float16 by its precision
+    const double epsilon = is_float(GT) ? (GT == GIGA_Float16 ? 0.1 : 1e-4) : 1.0;
+    if(!compare_tensors(&upsampled, &result, epsilon))
+    {
+        print_tensor(msg, tensor, "giga_upsample input");
+        print_tensor(msg, upsampled, "giga_upsample output");
+        print_tensor(msg, result, "expected output");
+        std::cerr << "Error comparing tensors upsampled and result" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    for(GIGA_tensor_t &t : tensors)
+    {
+        if((error = giga_release_tensor(&t)) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return error;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
+GIGA_error upsample_add_test(GIGA_data_type GT, GIGA_upsample_mode mode, uint32_t factor, uint8_t in_shift, uint8_t addend_shift, uint8_t out_shift, bool b_in_place)
+{
+    ScopedMessage msg;
+    msg << "Upsample add " << giga_data_type_str(GT) << " " << upsample_mode_str(mode) << " x" << factor
+        << ", in_shift " << int(in_shift)
+        << ", addend_shift " << int(addend_shift)
+        << ", out_shift " << int(out_shift)
+        << ", in place " << int(b_in_place) << "\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+        return error;
+
+    const uint32_t N = 2;
+    const uint32_t C = 3;
+    const uint32_t H = 4;
+    const uint32_t W = 5;
+
+    size_t offset = 0;
+
+    // in, addend, out, result
+    const uint8_t shifts[4] = {in_shift, addend_shift, out_shift, out_shift};
+    GIGA_tensor_t tensors[4];
+    for(uint32_t i = 0; i < 4; ++i)
+    {
+        GIGA_tensor_t &tensor = tensors[i];
+        tensor.nb_dims = 4;
+        tensor.dims[0] = N;
+        tensor.dims[1] = C;
+        tensor.dims[2] = i == 0 ? H : H * factor;
+        tensor.dims[3] = i == 0 ? W : W * factor;
+        tensor.device_id = device_id;
+        tensor.type = GT;
+        tensor.data = NULL;
+        tensor.fp_shift = b_in_place && i == 1 ? out_shift : shifts[i];
+
+        GIGA_allocate_t tensor_params;
+        tensor_params.memory_zone_id = 0;
+        tensor_params.offset = offset;
+        offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
+        if((error = giga_allocate_tensor(&tensor, &tensor_params)) != GIGA_Success)
+        {
+            std::cerr << "Error allocating tensor" << std::endl;
+            return error;
+        }
+    }
+    GIGA_tensor_t &tensor = tensors[0];
+    GIGA_tensor_t &addend = tensors[1];
+    GIGA_tensor_t &out = b_in_place ? tensors[1] : tensors[2];
+    GIGA_tensor_t &result = tensors[3];
+
+    // Values exactly representable with the tested shifts, sums stay in the range of all tested types
+    const float data_offset = is_signed(GT) ? 4.f : 0.f;
+    std::vector<float> data(N * C * H * W);
+    for(size_t i = 0; i < data.size(); ++i)
+        data[i] = float(int((i * 5) % 9)) - data_offset;
+    std::vector<float> data_addend(N * C * H * factor * W * factor);
+    for(size_t i = 0; i < data_addend.size(); ++i)
+        data_addend[i] = (float(int((i * 3) % 17)) - 2.f * data_offset) / 2.f;
+
+    if ((error = giga_copy_to_tensor(data.data(), GIGA_Float32, 0, &tensor)) != GIGA_Success
+        || (error = giga_copy_to_tensor(data_addend.data(), GIGA_Float32, 0, &addend)) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error filling tensor with data" << std::endl;
+        return error;
+    }
+
+    // Fill output with garbage to make sure we don't test an unwritten tensor
+    if(!b_in_place)
+        fill_contiguous_tensor_with_random_data(out, 0.f, 100.f);
+
+    GIGA_upsample_t upsample_params;
+    upsample_params.factor = factor;
+    upsample_params.mode = mode;
+    upsample_params.addend = &addend;
+
+    if((error = giga_upsample(&upsample_params, &tensor, &out)) != GIGA_Success)
+    {
+        if (error == GIGA_Unimplemented_Type)
+        {
+            std::cout << "Type not implemented!" << std::endl;
+            msg.clear();
+            return GIGA_Success;
+        }
+        std::cerr << "Error performing giga_upsample" << std::endl;
+        return error;
+    }
+
+    // Reference computed on the host
+    const uint32_t out_H = H * factor;
+    const uint32_t out_W = W * factor;
+    std::vector<float> data_result(N * C * out_H * out_W);
+    for(uint32_t nc = 0; nc < N * C; ++nc)
+        for(uint32_t y = 0; y < out_H; ++y)
+            for(uint32_t x = 0; x < out_W; ++x)
+            {
+                const float * const in_ptr = data.data() + nc * H * W;
+                float value;
+                if(mode == GIGA_Upsample_Nearest)
+                    value = in_ptr[(y / factor) * W + x / factor];
+                else
+                {
+                    const float sy = source_coordinate(y, H, out_H, mode);
+                    const float sx = source_coordinate(x, W, out_W, mode);
+                    const uint32_t y0 = std::min<uint32_t>(uint32_t(sy), H - 1);
+                    const uint32_t x0 = std::min<uint32_t>(uint32_t(sx), W - 1);
+                    const uint32_t y1 = std::min<uint32_t>(y0 + 1, H - 1);
+                    const uint32_t x1 = std::min<uint32_t>(x0 + 1, W - 1);
+                    const float wy = sy - float(y0);
+                    const float wx = sx - float(x0);
+                    value = (in_ptr[y0 * W + x0] * (1.f - wx) + in_ptr[y0 * W + x1] * wx) * (1.f - wy)
+                            + (in_ptr[y1 * W + x0] * (1.f - wx) + in_ptr[y1 * W + x1] * wx) * wy;
+                    if(!is_float(GT))
+                        value = std::round(value);
+                }
+                const size_t index = (nc * out_H + y) * out_W + x;
+                data_result[index] = value + data_addend[index];
+            }
+
+    if ((error = giga_copy_to_tensor(data_result.data(), GIGA_Float32, 0, &result)) != GIGA_Success)
+    {
+        std::cerr << "Error filling tensor with data" << std::endl;
+        return error;
+    }
+
+    // Rounding of bilinear interpolation may differ by one unit in fixed point
+    const double epsilon = mode == GIGA_Upsample_Nearest ? 0.0 : (is_float(GT) ? (GT == GIGA_Float16 ? 0.1 : 1e-4) : 1.0);
+    if(!compare_tensors(&out, &result, epsilon))
+    {
+        print_tensor(msg, tensor, "giga_upsample input");
+        print_tensor(msg, out, "giga_upsample output");
+        print_tensor(msg, result, "expected output");
+        std::cerr << "Error comparing tensors out and result" << std::endl;
+        return GIGA_Unknown_Error;
+    }
+
+    for(GIGA_tensor_t &t : tensors)
+    {
+        if((error = giga_release_tensor(&t)) != GIGA_Success)
+        {
+            std::cerr << "Error releasing tensor" << std::endl;
+            return error;
+        }
+    }
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')));
+
+    return GIGA_Success;
+}
+
 int main()
 {
     GIGA_error error = GIGA_Success;
@@ -202,6 +519,39 @@ int main()
             EARLY_ABORT();
         if((error = upsample_test(GIGA_UFixed16)) != GIGA_Success)
             EARLY_ABORT();
+
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_SFixed8, GIGA_SFixed16, GIGA_UFixed8, GIGA_UFixed16})
+        {
+            for(GIGA_upsample_mode mode : {GIGA_Upsample_Nearest, GIGA_Upsample_Bilinear, GIGA_Upsample_Bilinear_Align_Corners})
+            {
+                for(uint32_t factor : {1, 2, 3, 4})
+                {
+                    if((error = upsample_interpolation_test(GT, mode, factor)) != GIGA_Success)
+                        EARLY_ABORT();
+                }
+            }
+
+            // Fixed point alignment is only exercised with nearest neighbour so that the host reference is exact
+            const bool b_fixed = !is_float(GT);
+            for(bool b_in_place : {false, true})
+            {
+                if((error = upsample_add_test(GT, GIGA_Upsample_Nearest, 2, b_fixed ? 1 : 0, b_fixed ? 1 : 0, b_fixed ? 1 : 0, b_in_place)) != GIGA_Success)
+                    EARLY_ABORT();
+                if((error = upsample_add_test(GT, GIGA_Upsample_Nearest, 3, b_fixed ? 2 : 0, b_fixed ? 1 : 0, b_fixed ? 2 : 0, b_in_place)) != GIGA_Success)
+                    EARLY_ABORT();
+                if((error = upsample_add_test(GT, GIGA_Upsample_Nearest, 2, b_fixed ? 1 : 0, b_fixed ? 3 : 0, b_fixed ? 3 : 0, b_in_place)) != GIGA_Success)
+                    EARLY_ABORT();
+                if((error = upsample_add_test(GT, GIGA_Upsample_Bilinear, 2, b_fixed ? 1 : 0, b_fixed ? 1 : 0, b_fixed ? 1 : 0, b_in_place)) != GIGA_Success)
+                    EARLY_ABORT();
+            }
+
+            // Output representations too small for the sums, which saturate (the expected values are saturated when copied to the result tensor)
+            for(uint8_t out_shift : {15, 28})
+            {
+                if(b_fixed && (error = upsample_add_test(GT, GIGA_Upsample_Nearest, 2, 0, 1, out_shift, false)) != GIGA_Success)
+                    EARLY_ABORT();
+            }
+        }
     }
     catch(const std::exception &e)
     {
@@ -15,6 +15,7 @@
 #include <sys/time.h>
 #include <cstdlib>
 #include <sstream>
+#include <type_traits>
 
 inline size_t usec_timer()
 {
@@ -86,6 +87,9 @@ inline size_t tensor_size_in_bytes(const GIGA_tensor_t *tensor)
     return tensor_elements_count(tensor) * element_size_in_bits(tensor) >> 3;
 }
 
+//Tensor offsets in memory zones must be aligned on cache lines
+#define TENSOR_ALIGNMENT 64
+
 inline size_t align_address(size_t addr, size_t alignment)
 {
     const size_t mask = alignment - 1;
@@ -192,23 +196,44 @@ GIGA_error __impl_fill_4d_tensor(const inputType * const data, GIGA_tensor_t &te
         return error;
     }
 
+    //Contiguous half precision tensors are converted at once
+    bool b_converted = false;
+    if constexpr (std::is_same<inputType, float>::value && std::is_same<TensorType, half>::value)
+    {
+        size_t nb_elements = 1;
+        bool b_contiguous = true;
+        for(int32_t dim = int32_t(tensor.nb_dims) - 1; dim >= 0; --dim)
+        {
+            b_contiguous &= tensor.strides[dim] == nb_elements * sizeof(half);
+            nb_elements *= tensor.dims[dim];
+        }
+        if(b_contiguous && !tensor.fp_shift)
+        {
+            giga_half_from_float_n(write_ptr, data, nb_elements);
+            b_converted = true;
+        }
+    }
+
     const inputType * data_ptr = data;
-    for(uint32_t dim0_i = 0; dim0_i < dims[0]; ++dim0_i)
-        for(uint32_t dim1_i = 0; dim1_i < dims[1]; ++dim1_i)
-            for(uint32_t dim2_i = 0; dim2_i < dims[2]; ++dim2_i)
-                for(uint32_t dim3_i = 0; dim3_i < dims[3]; ++dim3_i)
-                {
-                    if(tensor.fp_shift)
-                    {
-                        write_ptr[(dim0_i * strides[0] + dim1_i * strides[1] + dim2_i * strides[2] + dim3_i * strides[3])/sizeof(TensorType)] =
-                            static_cast<TensorType>((*(data_ptr++)) * (1UL << tensor.fp_shift));
-                    }
-                    else
+    if(!b_converted)
+    {
+        for(uint32_t dim0_i = 0; dim0_i < dims[0]; ++dim0_i)
+            for(uint32_t dim1_i = 0; dim1_i < dims[1]; ++dim1_i)
+                for(uint32_t dim2_i = 0; dim2_i < dims[2]; ++dim2_i)
+                    for(uint32_t dim3_i = 0; dim3_i < dims[3]; ++dim3_i)
                     {
-                        write_ptr[(dim0_i * strides[0] + dim1_i * strides[1] + dim2_i * strides[2] + dim3_i * strides[3])/sizeof(TensorType)] =
-                            static_cast<TensorType>(*(data_ptr++));
+                        if(tensor.fp_shift)
+                        {
+                            write_ptr[(dim0_i * strides[0] + dim1_i * strides[1] + dim2_i * strides[2] + dim3_i * strides[3])/sizeof(TensorType)] =
+                                static_cast<TensorType>((*(data_ptr++)) * (1UL << tensor.fp_shift));
+                        }
+                        else
+                        {
+                            write_ptr[(dim0_i * strides[0] + dim1_i * strides[1] + dim2_i * strides[2] + dim3_i * strides[3])/sizeof(TensorType)] =
+                                static_cast<TensorType>(*(data_ptr++));
+                        }
                     }
-                }
+    }
 
     error = giga_unmap_tensor(&tensor, (void*)write_ptr, GIGA_Memory_Sync);
     if(error != GIGA_Success)
@@ -42,7 +42,7 @@ GIGA_error view_test(GIGA_data_type GT)
     GIGA_allocate_t tensor_params;
     tensor_params.memory_zone_id = 0;
     tensor_params.offset = offset;
-    offset += tensor_size_in_bytes(&tensor);
+    offset += align_address(tensor_size_in_bytes(&tensor), TENSOR_ALIGNMENT);
     error = giga_allocate_tensor(&tensor, &tensor_params);
     if(error != GIGA_Success)
     {
@@ -101,7 +101,7 @@ GIGA_error view_test(GIGA_data_type GT)
     GIGA_allocate_t result_params;
     result_params.memory_zone_id = 0;
     result_params.offset = offset;
-    offset += tensor_size_in_bytes(&result);
+    offset += align_address(tensor_size_in_bytes(&result), TENSOR_ALIGNMENT);
     error = giga_allocate_tensor(&result, &result_params);
     if(error != GIGA_Success)
     {
@@ -149,6 +149,131 @@ GIGA_error view_test(GIGA_data_type GT)
     return GIGA_Success;
 }
 
+//Copies to and from a view with holes on both spatial dimensions (the inside of a padded tensor)
+GIGA_error view_copy_test(GIGA_data_type GT)
+{
+    ScopedMessage msg;
+    msg << "Copy through view " << giga_data_type_str(GT) << "\n";
+
+    GIGA_error error;
+    uint32_t device_id = giga_get_default_device_id(&error);
+
+    if(error != GIGA_Success)
+        return error;
+
+    if((error = giga_initialize_device(device_id)) != GIGA_Success)
+        return error;
+
+    GIGA_tensor_t padded;
+    padded.nb_dims = 3;
+    padded.dims[0] = 2;
+    padded.dims[1] = 7;
+    padded.dims[2] = 9;
+    padded.device_id = device_id;
+    padded.type = GT;
+    padded.fp_shift = 0;
+
+    GIGA_allocate_t padded_params;
+    padded_params.memory_zone_id = 0;
+    padded_params.offset = 0;
+    if((error = giga_allocate_tensor(&padded, &padded_params)) != GIGA_Success)
+    {
+        std::cerr << "Error allocating tensor padded" << std::endl;
+        return error;
+    }
+
+    std::vector<float> padded_data(2 * 7 * 9, 0.f);
+    if((error = giga_copy_to_tensor(padded_data.data(), GIGA_Float32, 0, &padded)) != GIGA_Success)
+    {
+        std::cerr << "Error filling tensor padded" << std::endl;
+        return error;
+    }
+
+    GIGA_tensor_t inside;
+    inside.nb_dims = 3;
+    inside.dims[0] = 2;
+    inside.dims[1] = 5;
+    inside.dims[2] = 5;
+    inside.device_id = device_id;
+    inside.type = GT;
+    inside.fp_shift = 0;
+
+    GIGA_view_t view_params;
+    view_params.offset[0] = 0;
+    view_params.offset[1] = 1;
+    view_params.offset[2] = 2;
+    if((error = giga_view(&view_params, &padded, &inside)) != GIGA_Success)
+    {
+        std::cerr << "Error performing giga_view" << std::endl;
+        return error;
+    }
+
+    std::vector<float> data(2 * 5 * 5);
+    for(size_t i = 0; i < data.size(); ++i)
+        data[i] = float(1 + (i * 7) % 13);
+
+    //Checks the values of the view and that the border has been left untouched
+    const auto &check_padded = [&]()
+    {
+        if((error = giga_copy_from_tensor(padded_data.data(), GIGA_Float32, 0, &padded)) != GIGA_Success)
+            return false;
+        for(uint32_t c = 0; c < 2; ++c)
+            for(uint32_t y = 0; y < 7; ++y)
+                for(uint32_t x = 0; x < 9; ++x)
+                {
+                    const bool b_inside = y >= 1 && y < 6 && x >= 2 && x < 7;
+                    const float expected = b_inside ? data[(c * 5 + y - 1) * 5 + x - 2] : 0.f;
+                    if(padded_data[(c * 7 + y) * 9 + x] != expected)
+                        return false;
+                }
+
+        std::vector<float> read_back(data.size());
+        if((error = giga_copy_from_tensor(read_back.data(), GIGA_Float32, 0, &inside)) != GIGA_Success)
+            return false;
+        return read_back == data;
+    };
+
+    //Converting copies
+    if((error = giga_copy_to_tensor(data.data(), GIGA_Float32, 0, &inside)) != GIGA_Success)
+    {
+        std::cerr << "Error copying to the view" << std::endl;
+        return error;
+    }
+    if(!check_padded())
+    {
+        std::cerr << "Wrong values after a converting copy to the view" << std::endl;
+        return error != GIGA_Success ? error : GIGA_Unknown_Error;
+    }
+
+    //Plain copies, the view being read and written in its own type
+    std::vector<uint8_t> typed_data(data.size() * 4);
+    if((error = giga_copy_from_tensor(typed_data.data(), GT, 0, &inside)) != GIGA_Success)
+    {
+        std::cerr << "Error copying from the view" << std::endl;
+        return error;
+    }
+    std::fill(padded_data.begin(), padded_data.end(), 0.f);
+    if((error = giga_copy_to_tensor(padded_data.data(), GIGA_Float32, 0, &padded)) != GIGA_Success
+       || (error = giga_copy_to_tensor(typed_data.data(), GT, 0, &inside)) != GIGA_Success)
+    {
+        std::cerr << "Error copying to the view" << std::endl;
+        return error;
+    }
+    if(!check_padded())
+    {
+        std::cerr << "Wrong values after a plain copy to the view" << std::endl;
+        return error != GIGA_Success ? error : GIGA_Unknown_Error;
+    }
+
+    if((error = giga_release_tensor(&inside)) != GIGA_Success)  return error;
+    if((error = giga_release_tensor(&padded)) != GIGA_Success)  return error;
+
+    const std::string line = msg.message();
+    msg.replaceMessage(line.substr(0, line.find('\n')) + " OK");
+
+    return GIGA_Success;
+}
+
 int main()
 {
     GIGA_error error = GIGA_Success;
@@ -169,6 +294,11 @@ int main()
             EARLY_ABORT();
         if((error = view_test(GIGA_UFixed16)) != GIGA_Success)
             EARLY_ABORT();
+        for(GIGA_data_type GT : {GIGA_Float32, GIGA_Float16, GIGA_SFixed8, GIGA_SFixed16, GIGA_UFixed8, GIGA_UFixed16})
+        {
+            if((error = view_copy_test(GT)) != GIGA_Success)
+                EARLY_ABORT();
+        }
     }
     catch(const std::exception &e)
     {
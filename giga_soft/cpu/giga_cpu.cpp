@@ -70,6 +70,7 @@ GIGA_error giga_list_devices(uint32_t *device_ids, uint32_t *nb_devices)
 
 GIGA_error giga_initialize_device(uint32_t device_id)
 {
+    create_memory_zones();
     return GIGA_Success;
 }
 
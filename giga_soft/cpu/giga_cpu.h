@@ -80,6 +80,8 @@ struct Tensor_data_t
     void* data_ptr = nullptr;       // Pointer to the beginning of the buffer (parent buffer is any parent)
     void* data_start = nullptr;     // Pointer to the beginning of this tensor (data_start == data_ptr if no parent)
     uint64_t view_of = 0;
+    uint64_t range_offset = 0;      // Range of the memory zone reserved for the tensor and its views when its offset is chosen by the backend (range_size == 0 otherwise)
+    uint64_t range_size = 0;
 };
 
 template<class T>
@@ -96,6 +98,13 @@ inline const T * get_cptr(const GIGA_tensor_t * const tensor)
 
 bool check_tensor_exists(const GIGA_tensor_t *tensor);
 
+// Creates the memory zones if not done yet, they are otherwise created by the first allocation
+void create_memory_zones();
+
+// Runs the OpenMP team of the calling thread on the cores of the NUMA node of the memory zone of tensor, one thread per core with the workers
+// pinned to theirs, or gives it back its previous size and affinity when the zone has no node. The affinity of the calling thread is left unchanged
+void run_on_memory_zone_node(const GIGA_tensor_t *tensor);
+
 size_t element_size_in_bits(GIGA_data_type data_type);
 
 #endif // GIGA_CPU_H_dc5903c6ada2890c9551b4dbdc3b203b
@@ -9,6 +9,8 @@
 
 #include "giga_cpu.h"
 #include "utils.h"
+#include "giga_cpu_elementwise.h"
+#include <type_traits>
 
 template<GIGA_data_type a_GT, GIGA_data_type b_GT,  GIGA_data_type o_GT>
 GIGA_error _add_impl(const GIGA_add_t * params, const GIGA_tensor_t *a, const GIGA_tensor_t *b, GIGA_tensor_t *out)
@@ -23,26 +25,32 @@ GIGA_error _add_impl(const GIGA_add_t * params, const GIGA_tensor_t *a, const GI
     const int ashift = int(out->fp_shift) - int(a->fp_shift);
     const int bshift = int(out->fp_shift) - int(b->fp_shift);
 
-    if(a->nb_dims != b->nb_dims || a->nb_dims != out->nb_dims)
-        RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    const GIGA_error error = check_binary_broadcast(a, b, out);
+    if(error != GIGA_Success)
+        RETURN_ERROR(error);
 
-    unsigned int nb_elements = 1;
-    for(unsigned int i = 0; i < a->nb_dims; i++)
+#ifdef ENABLE_OPTIMIZATION
+    const auto add = [=](auto zero)
     {
-        if(a->dims[i] != b->dims[i] || a->dims[i] != out->dims[i])
-            RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
-
-        nb_elements *= out->dims[i];
-    }
+        typedef decltype(zero) v_T;
+        const Fixed_point_shift<v_T> a_shift(ashift);
+        const Fixed_point_shift<v_T> b_shift(bshift);
 
-    const int elt_i_end = nb_elements;
-    o_T * out_ptr = get_ptr<o_T>(out);
-    const a_T * a_ptr = get_cptr<a_T>(a);
-    const b_T * b_ptr = get_cptr<b_T>(b);
-    for(int elt_i = 0; elt_i < elt_i_end; ++elt_i, ++out_ptr, ++a_ptr, ++b_ptr)
+        elementwise_binary_run<v_T, o_T, a_T, b_T>(a, b, out, [=](const v_T a_value, const v_T b_value)
+        {
+            return a_shift(a_value) + b_shift(b_value);
+        });
+    };
+    if(fixed_point_sum_fits_32_bits<o_T>(ashift, bshift))
+        add(Fixed_point_sum_type<o_T, c_T>());
+    else
+        add(c_T());
+#else
+    elementwise_binary_reference<c_T, o_T, a_T, b_T>(a, b, out, [=](const c_T a_value, const c_T b_value)
     {
-        *out_ptr = o_T(shift(c_T(*a_ptr), ashift) + shift(c_T(*b_ptr), bshift));
-    }
+        return shift(a_value, ashift) + shift(b_value, bshift);
+    });
+#endif
 
     return GIGA_Success;
 }
@@ -52,6 +60,8 @@ GIGA_error giga_add_(const GIGA_add_t * params, const GIGA_tensor_t *a, const GI
     if (!check_tensor_exists(a) || !check_tensor_exists(b) || !check_tensor_exists(out))
         RETURN_ERROR(GIGA_Unknown_tensor);
 
+    run_on_memory_zone_node(out);
+
     GIGA_error ret;
 #ifdef ENABLE_OPTIMIZATION
     GIGA_CALL_TEMPLATED_FUNC_ON_3_TENSORS_SAME_TYPE(_add_impl, a->type, b->type, out->type, params, a, b, out)
@@ -0,0 +1,243 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \author Roland Brochard (roland.brochard@airbus.com)
+ * \date 15/01/2025
+ *
+ * Baseline CPU implementation of the GIGA API
+ *
+ */
+
+#include "giga_cpu.h"
+#include "utils.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+/*Compilation options to define the operational domain of the implementation*/
+#define ARGMAX_TILE_SIZE 128    // Number of pixels processed together when searching along the channel dimension
+
+// Writes a probability in [0, 1] into a tensor element, honoring fp_shift for fixed point types
+template<typename p_T>
+inline p_T _probability_to_type(const float p, const float p_scale)
+{
+    const float v = std::round(p * p_scale);
+    return p_T(std::min<float>(v, float(std::numeric_limits<p_T>::max())));
+}
+
+template<>
+inline float _probability_to_type<float>(const float p, const float)
+{
+    return p;
+}
+
+template<>
+inline half _probability_to_type<half>(const float p, const float)
+{
+    return half(p);
+}
+
+template<GIGA_data_type i_GT, GIGA_data_type l_GT>
+GIGA_error _argmax_impl(const GIGA_argmax_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out)
+{
+    typedef typename GIGA_C_Type<i_GT>::CType i_T;
+    typedef typename GIGA_C_Type<l_GT>::CType l_T;
+
+    GIGA_tensor_t * const probability = params->probability;
+
+    if(in->nb_dims != out->nb_dims)
+        RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+    if(in->nb_dims < 1 || in->nb_dims > 4)
+        RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+
+    //Same convention as softmax: along the only dimension in 1D, along the second one otherwise
+    const uint32_t C_dim = in->nb_dims == 1 ? 0 : 1;
+    for(uint32_t i = 0; i < in->nb_dims; i++)
+    {
+        if(out->dims[i] != (i == C_dim ? 1 : in->dims[i]))
+            RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    }
+
+    if(probability)
+    {
+        if(probability->type != in->type)
+            RETURN_ERROR(GIGA_Inconsistent_Tensor_Types);
+        if(probability->nb_dims != out->nb_dims)
+            RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+        for(uint32_t i = 0; i < out->nb_dims; i++)
+        {
+            if(probability->dims[i] != out->dims[i])
+                RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+        }
+    }
+
+    const uint32_t nb_channels = in->dims[C_dim];
+    if(nb_channels == 0 || nb_channels - 1 > std::numeric_limits<l_T>::max())
+        RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+
+    //Everything is seen as a NCHW tensor, missing dimensions are of size 1
+    const uint32_t batch_end = in->nb_dims == 1 ? 1 : in->dims[0];
+    const uint32_t y_end = in->nb_dims == 4 ? in->dims[2] : 1;
+    const uint32_t x_end = in->nb_dims >= 3 ? in->dims[in->nb_dims - 1] : 1;
+    const uint32_t H_dim = in->nb_dims == 4 ? 2 : C_dim;
+    const uint32_t W_dim = in->nb_dims >= 3 ? in->nb_dims - 1 : C_dim;
+
+    const uint32_t in_stride_B = in->nb_dims == 1 ? 0 : in->strides[0] / sizeof(i_T);
+    const uint32_t in_stride_C = in->strides[C_dim] / sizeof(i_T);
+    const uint32_t in_stride_H = in->strides[H_dim] / sizeof(i_T);
+    const uint32_t in_stride_W = in->strides[W_dim] / sizeof(i_T);
+    const uint32_t out_stride_B = out->nb_dims == 1 ? 0 : out->strides[0] / sizeof(l_T);
+    const uint32_t out_stride_H = out->strides[H_dim] / sizeof(l_T);
+    const uint32_t out_stride_W = out->strides[W_dim] / sizeof(l_T);
+    const uint32_t prob_stride_B = probability && probability->nb_dims > 1 ? probability->strides[0] / sizeof(i_T) : 0;
+    const uint32_t prob_stride_H = probability ? probability->strides[H_dim] / sizeof(i_T) : 0;
+    const uint32_t prob_stride_W = probability ? probability->strides[W_dim] / sizeof(i_T) : 0;
+
+    //Fixed point values are brought back to real values only for the exponential, the search itself is scale invariant
+    const float in_scale = is_float(in->type) ? 1.f : 1.f / float(1UL << in->fp_shift);
+    const float prob_scale = probability && !is_float(probability->type) ? float(1UL << probability->fp_shift) : 1.f;
+
+    const i_T * const in_ptr0 = get_cptr<i_T>(in);
+    l_T * const out_ptr0 = get_ptr<l_T>(out);
+    i_T * const prob_ptr0 = probability ? get_ptr<i_T>(probability) : nullptr;
+
+#ifdef ENABLE_OPTIMIZATION
+    // Assume in_stride_W == 1
+    // Assume out_stride_W == 1
+    // Assume prob_stride_W == 1
+    // Like softmax, channels are walked for a tile of pixels at once so each channel plane is read contiguously
+    const uint32_t nb_tiles = (x_end + ARGMAX_TILE_SIZE - 1) / ARGMAX_TILE_SIZE;
+    const uint32_t nb_jobs = batch_end * y_end * nb_tiles;
+#pragma omp parallel
+    {
+        float max_values[ARGMAX_TILE_SIZE];
+        uint32_t max_indexes[ARGMAX_TILE_SIZE];
+        float sums[ARGMAX_TILE_SIZE];
+
+#pragma omp for schedule(static)
+        for(uint32_t job = 0; job < nb_jobs; ++job)
+        {
+            const uint32_t tile = job % nb_tiles;
+            const uint32_t y = (job / nb_tiles) % y_end;
+            const uint32_t batch = job / (nb_tiles * y_end);
+            const uint32_t x_begin = tile * ARGMAX_TILE_SIZE;
+            const uint32_t tile_size = std::min<uint32_t>(ARGMAX_TILE_SIZE, x_end - x_begin);
+            const i_T * const in_ptr1 = in_ptr0 + batch * in_stride_B + y * in_stride_H + x_begin;
+
+            for(uint32_t i = 0; i < tile_size; ++i)
+            {
+                max_values[i] = float(in_ptr1[i]);
+                max_indexes[i] = 0;
+            }
+            for(uint32_t c = 1; c < nb_channels; ++c)
+            {
+                const i_T * const in_ptr2 = in_ptr1 + c * in_stride_C;
+                for(uint32_t i = 0; i < tile_size; ++i)
+                {
+                    const float value = float(in_ptr2[i]);
+                    //Strict comparison: ties resolve to the first channel
+                    const bool b_greater = value > max_values[i];
+                    max_values[i] = b_greater ? value : max_values[i];
+                    max_indexes[i] = b_greater ? c : max_indexes[i];
+                }
+            }
+
+            l_T * const out_ptr1 = out_ptr0 + batch * out_stride_B + y * out_stride_H + x_begin;
+            for(uint32_t i = 0; i < tile_size; ++i)
+                out_ptr1[i] = l_T(max_indexes[i]);
+
+            if(prob_ptr0)
+            {
+                //The max softmax probability is 1 / sum(exp(x - max))
+                for(uint32_t i = 0; i < tile_size; ++i)
+                    sums[i] = 0.f;
+                for(uint32_t c = 0; c < nb_channels; ++c)
+                {
+                    const i_T * const in_ptr2 = in_ptr1 + c * in_stride_C;
+                    for(uint32_t i = 0; i < tile_size; ++i)
+                        sums[i] += std::exp((float(in_ptr2[i]) - max_values[i]) * in_scale);
+                }
+
+                i_T * const prob_ptr1 = prob_ptr0 + batch * prob_stride_B + y * prob_stride_H + x_begin;
+                for(uint32_t i = 0; i < tile_size; ++i)
+                    prob_ptr1[i] = _probability_to_type<i_T>(1.f / sums[i], prob_scale);
+            }
+        }
+    }
+#else
+    for(uint32_t batch = 0; batch < batch_end; ++batch)
+    {
+        for(uint32_t y = 0; y < y_end; ++y)
+        {
+            for(uint32_t x = 0; x < x_end; ++x)
+            {
+                const uint32_t in_offset = batch * in_stride_B + y * in_stride_H + x * in_stride_W;
+
+                float max_value = float(in_ptr0[in_offset]);
+                uint32_t max_index = 0;
+                for(uint32_t c = 1; c < nb_channels; ++c)
+                {
+                    const float value = float(in_ptr0[in_offset + c * in_stride_C]);
+                    //Strict comparison: ties resolve to the first channel
+                    if(value > max_value)
+                    {
+                        max_value = value;
+                        max_index = c;
+                    }
+                }
+
+                out_ptr0[batch * out_stride_B + y * out_stride_H + x * out_stride_W] = l_T(max_index);
+
+                if(prob_ptr0)
+                {
+                    //The max softmax probability is 1 / sum(exp(x - max))
+                    float sum = 0.f;
+                    for(uint32_t c = 0; c < nb_channels; ++c)
+                        sum += std::exp((float(in_ptr0[in_offset + c * in_stride_C]) - max_value) * in_scale);
+
+                    prob_ptr0[batch * prob_stride_B + y * prob_stride_H + x * prob_stride_W] = _probability_to_type<i_T>(1.f / sum, prob_scale);
+                }
+            }
+        }
+    }
+#endif
+
+    return GIGA_Success;
+}
+
+template<GIGA_data_type i_GT>
+GIGA_error _argmax_UFixed8_labels_impl(const GIGA_argmax_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out)
+{
+    return _argmax_impl<i_GT, GIGA_UFixed8>(params, in, out);
+}
+
+template<GIGA_data_type i_GT>
+GIGA_error _argmax_UFixed16_labels_impl(const GIGA_argmax_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out)
+{
+    return _argmax_impl<i_GT, GIGA_UFixed16>(params, in, out);
+}
+
+GIGA_error giga_argmax_(const GIGA_argmax_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line)
+{
+    if (!check_tensor_exists(in) || !check_tensor_exists(out))
+        RETURN_ERROR(GIGA_Unknown_tensor);
+
+    if (params->probability && !check_tensor_exists(params->probability))
+        RETURN_ERROR(GIGA_Unknown_tensor);
+
+    run_on_memory_zone_node(out);
+
+    GIGA_error ret;
+    //Labels are always unsigned integers
+    switch(out->type)
+    {
+    case GIGA_UFixed8:
+        GIGA_CALL_TEMPLATED_FUNC_ON_TENSOR(_argmax_UFixed8_labels_impl, in->type, params, in, out)
+        break;
+    case GIGA_UFixed16:
+        GIGA_CALL_TEMPLATED_FUNC_ON_TENSOR(_argmax_UFixed16_labels_impl, in->type, params, in, out)
+        break;
+    default:
+        ret = GIGA_Unimplemented_Type;
+    }
+    RETURN_ERROR(ret);
+}
@@ -9,11 +9,93 @@
 
 #include "giga_cpu.h"
 #include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 /*Compilation options to define the operational domain of the implementation*/
 #define MAX_CONV_STRIDE 2
 #define MAX_DILATION 1
 #define KERNEL_SIZE 3
+#define MAX_UPSAMPLING 2    // Nearest neighbour upsampling fused with the convolution
+
+#ifdef ENABLE_OPTIMIZATION
+//Splits a 3x3 kernel into a vertical and a horizontal 3 taps filter when it is exactly their outer product (rank 1 kernel)
+//For fixed point types, all the non zero rows of an integer rank 1 kernel are integer multiples of the same primitive row
+template<typename c_T>
+inline bool separate_kernel(const c_T *k, c_T *v, c_T *h)
+{
+    uint32_t r = 0;
+    while(r < KERNEL_SIZE && k[r * KERNEL_SIZE] == 0 && k[r * KERNEL_SIZE + 1] == 0 && k[r * KERNEL_SIZE + 2] == 0)
+        ++r;
+    if(r == KERNEL_SIZE)
+    {
+        std::fill(v, v + KERNEL_SIZE, c_T(0));
+        std::fill(h, h + KERNEL_SIZE, c_T(0));
+        return true;
+    }
+
+    c_T g = 0;
+    for(uint32_t j = 0; j < KERNEL_SIZE; ++j)
+    {
+        c_T a = k[r * KERNEL_SIZE + j] < 0 ? -k[r * KERNEL_SIZE + j] : k[r * KERNEL_SIZE + j];
+        while(a != 0)
+        {
+            const c_T t = g % a;
+            g = a;
+            a = t;
+        }
+    }
+    for(uint32_t j = 0; j < KERNEL_SIZE; ++j)
+        h[j] = k[r * KERNEL_SIZE + j] / g;
+
+    const uint32_t c = h[0] != 0 ? 0 : (h[1] != 0 ? 1 : 2);
+    for(uint32_t i = 0; i < KERNEL_SIZE; ++i)
+    {
+        if(k[i * KERNEL_SIZE + c] % h[c] != 0)
+            return false;
+        v[i] = k[i * KERNEL_SIZE + c] / h[c];
+    }
+
+    for(uint32_t i = 0; i < KERNEL_SIZE; ++i)
+        for(uint32_t j = 0; j < KERNEL_SIZE; ++j)
+            if(v[i] * h[j] != k[i * KERNEL_SIZE + j])
+                return false;
+    return true;
+}
+
+template<>
+inline bool separate_kernel<float>(const float *k, float *v, float *h)
+{
+    uint32_t r = 0;
+    while(r < KERNEL_SIZE && k[r * KERNEL_SIZE] == 0.f && k[r * KERNEL_SIZE + 1] == 0.f && k[r * KERNEL_SIZE + 2] == 0.f)
+        ++r;
+    if(r == KERNEL_SIZE)
+    {
+        std::fill(v, v + KERNEL_SIZE, 0.f);
+        std::fill(h, h + KERNEL_SIZE, 0.f);
+        return true;
+    }
+
+    //Normalize the row by its largest tap, the kernel is kept only if the products give back all the taps exactly
+    //The division is done in double precision (volatile so that it is not narrowed back to float) since fast math float divisions use an approximate reciprocal
+    uint32_t c = 0;
+    for(uint32_t j = 1; j < KERNEL_SIZE; ++j)
+        if(std::abs(k[r * KERNEL_SIZE + j]) > std::abs(k[r * KERNEL_SIZE + c]))
+            c = j;
+    const volatile double pivot = k[r * KERNEL_SIZE + c];
+    for(uint32_t j = 0; j < KERNEL_SIZE; ++j)
+        h[j] = float(k[r * KERNEL_SIZE + j] / pivot);
+    for(uint32_t i = 0; i < KERNEL_SIZE; ++i)
+        v[i] = k[i * KERNEL_SIZE + c];
+
+    for(uint32_t i = 0; i < KERNEL_SIZE; ++i)
+        for(uint32_t j = 0; j < KERNEL_SIZE; ++j)
+            if(v[i] * h[j] != k[i * KERNEL_SIZE + j])
+                return false;
+    return true;
+}
+#endif
 
 template<GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type k_GT>
 GIGA_error _conv2d_impl(const GIGA_conv2d_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out)
@@ -60,6 +142,11 @@ GIGA_error _conv2d_impl(const GIGA_conv2d_t *params, const GIGA_tensor_t *in, GI
 
     if(params->dilation[0] != 1 || params->dilation[1] != 1)    RETURN_ERROR(GIGA_Incorrect_Parameter);
 
+    //0 and 1 both mean no upsampling
+    const uint32_t upsampling = params->upsampling ? params->upsampling : 1;
+    if(upsampling > MAX_UPSAMPLING) RETURN_ERROR(GIGA_Incorrect_Parameter);
+    if(upsampling > 1 && (params->stride[0] != 1 || params->stride[1] != 1))  RETURN_ERROR(GIGA_Incorrect_Parameter);
+
     uint32_t bias_dimension = 0;
 
     if(params->bias != NULL)
@@ -83,10 +170,10 @@ GIGA_error _conv2d_impl(const GIGA_conv2d_t *params, const GIGA_tensor_t *in, GI
     const uint32_t H_dim_out = out->nb_dims - 2;
     const uint32_t W_dim_out = H_dim_out + 1;
 
-    //check dimensions
-    if(out->dims[H_dim_out] != (in->dims[H_dim_in] + params->padding[0][0] + params->padding[0][1] - (KERNEL_SIZE - 1) - 1) / params->stride[0] + 1 )
+    //check dimensions, relative to the upsampled input
+    if(out->dims[H_dim_out] != (in->dims[H_dim_in] * upsampling + params->padding[0][0] + params->padding[0][1] - (KERNEL_SIZE - 1) - 1) / params->stride[0] + 1 )
         RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
-    if(out->dims[W_dim_out] != (in->dims[W_dim_in] + params->padding[1][0] + params->padding[1][1] - (KERNEL_SIZE - 1) - 1) / params->stride[1] + 1 )
+    if(out->dims[W_dim_out] != (in->dims[W_dim_in] * upsampling + params->padding[1][0] + params->padding[1][1] - (KERNEL_SIZE - 1) - 1) / params->stride[1] + 1 )
         RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
 
     const uint32_t in_stride_C = (in->nb_dims == 2) ? 1 : in->strides[in->nb_dims - 3] / sizeof(i_T);
@@ -116,8 +203,9 @@ GIGA_error _conv2d_impl(const GIGA_conv2d_t *params, const GIGA_tensor_t *in, GI
     const uint32_t stride0 = params->stride[0];
     const uint32_t stride1 = params->stride[1];
 
-    const uint32_t H = in->dims[H_dim_in];
-    const uint32_t W = in->dims[W_dim_in];
+    //Dimensions of the (virtually) upsampled input
+    const uint32_t H = in->dims[H_dim_in] * upsampling;
+    const uint32_t W = in->dims[W_dim_in] * upsampling;
 
     //Actually perform convolution
     const uint32_t batch_end = nb_batch;
@@ -129,6 +217,284 @@ GIGA_error _conv2d_impl(const GIGA_conv2d_t *params, const GIGA_tensor_t *in, GI
     // Assume out_stride_W == 1
     // Assume in_stride_W == 1
     // Assume kernel_stride3 == 1
+    if(upsampling == 2)
+    {
+        //Sub-pixel phase decomposition: depending on the parity of its position in the upsampled input, a 3x3 window covers
+        //only 2x2 input pixels. Kernel taps falling on the same input pixel are combined beforehand, one 2x2 kernel per phase.
+        //Input rows (and columns) covered by the taps of a phase: even phase {0, 1}, {2}, odd phase {0}, {1, 2}
+        static const uint32_t tap_begin[2][2] = {{0, 2}, {0, 1}};
+        static const uint32_t tap_end[2][2] = {{2, 3}, {1, 3}};
+
+        std::vector<c_T> phase_kernels(nb_out_channels * 4 * nb_in_channels * 4);
+        for (uint32_t out_ch = 0; out_ch < nb_out_channels ; ++out_ch)
+            for (uint32_t phase = 0; phase < 4; ++phase)
+                for (uint32_t c_in = 0 ; c_in < nb_in_channels; ++c_in)
+                    for (uint32_t a = 0; a < 2; ++a)
+                        for (uint32_t b = 0; b < 2; ++b)
+                        {
+                            const k_T * const k_ptr = get_cptr<k_T>(kernel) + out_ch * kernel_stride0 + c_in * kernel_stride1;
+                            c_T sum = 0;
+                            for (uint32_t ker_y = tap_begin[phase >> 1][a]; ker_y < tap_end[phase >> 1][a]; ++ker_y)
+                                for (uint32_t ker_x = tap_begin[phase & 1][b]; ker_x < tap_end[phase & 1][b]; ++ker_x)
+                                    sum += c_T(k_ptr[ker_y * kernel_stride2 + ker_x]);
+                            phase_kernels[((out_ch * 4 + phase) * nb_in_channels + c_in) * 4 + a * 2 + b] = sum;
+                        }
+
+        const uint32_t in_y_end = in->dims[H_dim_in];
+        const uint32_t in_x_end = in->dims[W_dim_in];
+        const uint32_t nb_jobs = batch_end * nb_out_channels * out_y_end;
+#pragma omp parallel for schedule(static)
+        for (uint32_t job = 0 ; job < nb_jobs ; ++job)
+        {
+            const uint32_t out_y = job % out_y_end;
+            const uint32_t out_ch = (job / out_y_end) % nb_out_channels;
+            const uint32_t batch = job / (out_y_end * nb_out_channels);
+
+            const i_T * const in_ptr0 = get_cptr<i_T>(in) + batch * in_stride_B;
+            o_T * const out_ptr2 = get_ptr<o_T>(out) + batch * out_stride_B + out_ch * out_stride_C + out_y * out_stride_H;
+            const c_T bias = params->bias ? c_T(get_cptr<k_T>(params->bias)[out_ch * bias_stride]) : c_T(0);
+
+            //Position of the window in the upsampled input, its parity selects the phase
+            const int32_t up_y = int32_t(out_y) - padding_y;
+            const uint32_t phase_y = up_y & 1;
+            const int32_t in_y0 = (up_y - int32_t(phase_y)) / 2;
+            for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+            {
+                const int32_t up_x = int32_t(out_x) - padding_x;
+                const uint32_t phase_x = up_x & 1;
+                const int32_t in_x0 = (up_x - int32_t(phase_x)) / 2;
+                const c_T * const k_ptr = phase_kernels.data() + (out_ch * 4 + phase_y * 2 + phase_x) * nb_in_channels * 4;
+
+                c_T acc = 0;
+                for (uint32_t c_in = 0 ; c_in < nb_in_channels; ++c_in)
+                {
+                    const i_T * const in_ptr2 = in_ptr0 + c_in * in_stride_C;
+                    for (uint32_t a = 0; a < 2; ++a)
+                    {
+                        const uint32_t in_y = in_y0 + a;
+                        if (in_y >= in_y_end)
+                            continue;
+                        for (uint32_t b = 0; b < 2; ++b)
+                        {
+                            /*Boundary checking */
+                            const uint32_t in_x = in_x0 + b;
+                            if (in_x >= in_x_end)
+                                continue;
+
+                            acc += k_ptr[c_in * 4 + a * 2 + b] * c_T(in_ptr2[in_y * in_stride_H + in_x]);
+                        }
+                    }
+                }
+
+                acc += shift(bias, bias_reshift);
+                if(params->b_ReLU)
+                    out_ptr2[out_x] = acc > 0 ? o_T(shift(acc, out_shift)) : o_T(0);
+                else
+                    out_ptr2[out_x] = o_T(shift(acc, out_shift));
+            }
+        }
+
+        return GIGA_Success;
+    }
+
+    if(stride0 == 2 && stride1 == 2)
+    {
+        //Space to depth decomposition: each input row is split into its even and odd columns, two contiguous phase rows.
+        //A kernel tap then reads one phase row at a unit stride offset, and the stride 2 convolution becomes contiguous loops over the output row.
+        //Phase row m holds the input column 2 * (m - 1) + phase, the zeros on both sides cover the padding.
+        const uint32_t phase_size = out_x_end + 2;
+        uint32_t phase_end[2];
+        for (uint32_t phase = 0; phase < 2; ++phase)
+            phase_end[phase] = std::min(phase_size, 1 + (W - phase + 1) / 2);
+
+        //Phase row and offset read by each kernel column
+        uint32_t tap_phase[KERNEL_SIZE];
+        uint32_t tap_offset[KERNEL_SIZE];
+        for (uint32_t ker_x = 0; ker_x < KERNEL_SIZE; ++ker_x)
+        {
+            const int32_t e = int32_t(ker_x) - padding_x;
+            tap_phase[ker_x] = e & 1;
+            tap_offset[ker_x] = 1 + (e - int32_t(e & 1)) / 2;
+        }
+
+        std::vector<c_T> kernels(nb_out_channels * nb_in_channels * KERNEL_SIZE * KERNEL_SIZE);
+        for (uint32_t out_ch = 0; out_ch < nb_out_channels ; ++out_ch)
+            for (uint32_t c_in = 0 ; c_in < nb_in_channels; ++c_in)
+                for (uint32_t ker_y = 0; ker_y < KERNEL_SIZE; ++ker_y)
+                    for (uint32_t ker_x = 0; ker_x < KERNEL_SIZE; ++ker_x)
+                        kernels[((out_ch * nb_in_channels + c_in) * KERNEL_SIZE + ker_y) * KERNEL_SIZE + ker_x]
+                            = c_T(get_cptr<k_T>(kernel)[out_ch * kernel_stride0 + c_in * kernel_stride1 + ker_y * kernel_stride2 + ker_x]);
+
+        //Each job computes one output row for all the output channels so that phase rows are built once per input row
+        const uint32_t nb_jobs = batch_end * out_y_end;
+#pragma omp parallel
+        {
+            std::vector<c_T> phase_rows(2 * phase_size, c_T(0));
+            std::vector<c_T> acc_rows(nb_out_channels * out_x_end);
+
+#pragma omp for schedule(static)
+            for (uint32_t job = 0 ; job < nb_jobs ; ++job)
+            {
+                const uint32_t out_y = job % out_y_end;
+                const uint32_t batch = job / out_y_end;
+                const i_T * const in_ptr0 = get_cptr<i_T>(in) + batch * in_stride_B;
+
+                std::fill(acc_rows.begin(), acc_rows.end(), c_T(0));
+                for (uint32_t c_in = 0 ; c_in < nb_in_channels; ++c_in)
+                {
+                    for (uint32_t ker_y = 0; ker_y < KERNEL_SIZE ; ++ker_y)
+                    {
+                        const uint32_t in_y = out_y * 2 - padding_y + ker_y;
+                        if (in_y >= H)
+                            continue;
+
+                        const i_T * const in_ptr2 = in_ptr0 + c_in * in_stride_C + in_y * in_stride_H;
+                        for (uint32_t phase = 0; phase < 2; ++phase)
+                        {
+                            c_T * const phase_row = phase_rows.data() + phase * phase_size;
+                            for (uint32_t m = 1; m < phase_end[phase]; ++m)
+                                phase_row[m] = c_T(in_ptr2[2 * (m - 1) + phase]);
+                        }
+
+                        for (uint32_t out_ch = 0; out_ch < nb_out_channels ; ++out_ch)
+                        {
+                            c_T * __restrict__ const acc = acc_rows.data() + out_ch * out_x_end;
+                            const c_T * const k_ptr = kernels.data() + ((out_ch * nb_in_channels + c_in) * KERNEL_SIZE + ker_y) * KERNEL_SIZE;
+                            const c_T k0 = k_ptr[0];
+                            const c_T k1 = k_ptr[1];
+                            const c_T k2 = k_ptr[2];
+                            const c_T * __restrict__ const src0 = phase_rows.data() + tap_phase[0] * phase_size + tap_offset[0];
+                            const c_T * __restrict__ const src1 = phase_rows.data() + tap_phase[1] * phase_size + tap_offset[1];
+                            const c_T * __restrict__ const src2 = phase_rows.data() + tap_phase[2] * phase_size + tap_offset[2];
+                            for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+                                acc[out_x] += k0 * src0[out_x] + k1 * src1[out_x] + k2 * src2[out_x];
+                        }
+                    }
+                }
+
+                for (uint32_t out_ch = 0; out_ch < nb_out_channels ; ++out_ch)
+                {
+                    const c_T * const acc = acc_rows.data() + out_ch * out_x_end;
+                    o_T * const out_ptr2 = get_ptr<o_T>(out) + batch * out_stride_B + out_ch * out_stride_C + out_y * out_stride_H;
+                    const c_T bias = params->bias ? shift(c_T(get_cptr<k_T>(params->bias)[out_ch * bias_stride]), bias_reshift) : c_T(0);
+                    for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+                    {
+                        const c_T value = acc[out_x] + bias;
+                        if(params->b_ReLU)
+                            out_ptr2[out_x] = value > 0 ? o_T(shift(value, out_shift)) : o_T(0);
+                        else
+                            out_ptr2[out_x] = o_T(shift(value, out_shift));
+                    }
+                }
+            }
+        }
+
+        return GIGA_Success;
+    }
+
+    if(stride0 == 1 && stride1 == 1)
+    {
+        //Classical filters (Sobel, Gaussian, box...) are often rank 1: they are run as a horizontal pass over each input row
+        //followed by a vertical pass accumulating it into the output rows it contributes to, 6 instead of 9 MACs per tap set.
+        std::vector<c_T> vertical(nb_out_channels * nb_in_channels * KERNEL_SIZE);
+        std::vector<c_T> horizontal(nb_out_channels * nb_in_channels * KERNEL_SIZE);
+        bool b_separable = true;
+        for (uint32_t out_ch = 0; out_ch < nb_out_channels && b_separable; ++out_ch)
+            for (uint32_t c_in = 0 ; c_in < nb_in_channels && b_separable; ++c_in)
+            {
+                c_T k[KERNEL_SIZE * KERNEL_SIZE];
+                for (uint32_t ker_y = 0; ker_y < KERNEL_SIZE; ++ker_y)
+                    for (uint32_t ker_x = 0; ker_x < KERNEL_SIZE; ++ker_x)
+                        k[ker_y * KERNEL_SIZE + ker_x] = c_T(get_cptr<k_T>(kernel)[out_ch * kernel_stride0 + c_in * kernel_stride1 + ker_y * kernel_stride2 + ker_x]);
+                const uint32_t pair = out_ch * nb_in_channels + c_in;
+                b_separable = separate_kernel(k, vertical.data() + pair * KERNEL_SIZE, horizontal.data() + pair * KERNEL_SIZE);
+            }
+
+        if(b_separable)
+        {
+            //Jobs work on strips of output rows so that each filtered input row is reused by all the output rows it contributes to
+            const uint32_t strip_height = 16;
+            const uint32_t nb_strips = (out_y_end + strip_height - 1) / strip_height;
+            //Padded row m holds the input column m - padding_x, the zeros on both sides cover the padding
+            const uint32_t row_size = out_x_end + KERNEL_SIZE - 1;
+            const uint32_t row_end = W + padding_x;
+
+            const uint32_t nb_jobs = batch_end * nb_out_channels * nb_strips;
+#pragma omp parallel
+            {
+                std::vector<c_T> padded_row(row_size, c_T(0));
+                std::vector<c_T> filtered_row(out_x_end);
+                std::vector<c_T> acc_rows(strip_height * out_x_end);
+
+#pragma omp for schedule(static)
+                for (uint32_t job = 0 ; job < nb_jobs ; ++job)
+                {
+                    const uint32_t strip = job % nb_strips;
+                    const uint32_t out_ch = (job / nb_strips) % nb_out_channels;
+                    const uint32_t batch = job / (nb_strips * nb_out_channels);
+                    const int32_t y_begin = strip * strip_height;
+                    const int32_t y_end = std::min(y_begin + int32_t(strip_height), int32_t(out_y_end));
+
+                    std::fill(acc_rows.begin(), acc_rows.end(), c_T(0));
+                    for (uint32_t c_in = 0 ; c_in < nb_in_channels; ++c_in)
+                    {
+                        const uint32_t pair = out_ch * nb_in_channels + c_in;
+                        const c_T * const v = vertical.data() + pair * KERNEL_SIZE;
+                        const c_T * const h = horizontal.data() + pair * KERNEL_SIZE;
+                        //Zero kernels (channels not mixed by the filter) are skipped
+                        if(v[0] == 0 && v[1] == 0 && v[2] == 0)
+                            continue;
+                        const c_T h0 = h[0];
+                        const c_T h1 = h[1];
+                        const c_T h2 = h[2];
+
+                        const int32_t in_y_begin = std::max(y_begin - padding_y, 0);
+                        const int32_t in_y_end = std::min(y_end - padding_y + int32_t(KERNEL_SIZE) - 1, int32_t(H));
+                        for (int32_t in_y = in_y_begin; in_y < in_y_end; ++in_y)
+                        {
+                            const i_T * const in_ptr2 = get_cptr<i_T>(in) + batch * in_stride_B + c_in * in_stride_C + in_y * in_stride_H;
+                            for (uint32_t m = padding_x; m < row_end; ++m)
+                                padded_row[m] = c_T(in_ptr2[m - padding_x]);
+
+                            const c_T * __restrict__ const src = padded_row.data();
+                            c_T * __restrict__ const dst = filtered_row.data();
+                            for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+                                dst[out_x] = h0 * src[out_x] + h1 * src[out_x + 1] + h2 * src[out_x + 2];
+
+                            for (uint32_t ker_y = 0; ker_y < KERNEL_SIZE; ++ker_y)
+                            {
+                                const int32_t out_y = in_y + padding_y - int32_t(ker_y);
+                                if (out_y < y_begin || out_y >= y_end || v[ker_y] == 0)
+                                    continue;
+                                const c_T vk = v[ker_y];
+                                c_T * __restrict__ const acc = acc_rows.data() + (out_y - y_begin) * out_x_end;
+                                for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+                                    acc[out_x] += vk * dst[out_x];
+                            }
+                        }
+                    }
+
+                    const c_T bias = params->bias ? shift(c_T(get_cptr<k_T>(params->bias)[out_ch * bias_stride]), bias_reshift) : c_T(0);
+                    for (int32_t out_y = y_begin; out_y < y_end; ++out_y)
+                    {
+                        const c_T * const acc = acc_rows.data() + (out_y - y_begin) * out_x_end;
+                        o_T * const out_ptr2 = get_ptr<o_T>(out) + batch * out_stride_B + out_ch * out_stride_C + out_y * out_stride_H;
+                        for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+                        {
+                            const c_T value = acc[out_x] + bias;
+                            if(params->b_ReLU)
+                                out_ptr2[out_x] = value > 0 ? o_T(shift(value, out_shift)) : o_T(0);
+                            else
+                                out_ptr2[out_x] = o_T(shift(value, out_shift));
+                        }
+                    }
+                }
+            }
+
+            return GIGA_Success;
+        }
+    }
+
 #pragma omp parallel
     for (uint32_t batch = 0 ; batch < batch_end ; ++batch)
     {
@@ -230,8 +596,8 @@ GIGA_error _conv2d_impl(const GIGA_conv2d_t *params, const GIGA_tensor_t *in, GI
 
                                 const uint32_t in_offset = batch * in_stride_B
                                                            + c_in * in_stride_C
-                                                           + in_y_offset * in_stride_H
-                                                           + in_x_offset * in_stride_W;
+                                                           + (in_y_offset / upsampling) * in_stride_H
+                                                           + (in_x_offset / upsampling) * in_stride_W;
 
                                 const i_T * const in_ptr = get_cptr<i_T>(in) + in_offset;
 
@@ -265,6 +631,8 @@ GIGA_error giga_conv2d_(const GIGA_conv2d_t *params, const GIGA_tensor_t *in, GI
     if (!check_tensor_exists(in) || !check_tensor_exists(out) || !check_tensor_exists(params->kernel))
         RETURN_ERROR(GIGA_Unknown_tensor);
 
+    run_on_memory_zone_node(out);
+
     GIGA_error ret;
 #ifdef ENABLE_OPTIMIZATION
     GIGA_CALL_TEMPLATED_FUNC_ON_3_TENSORS_SIGNED_KERNELS(_conv2d_impl, in->type, out->type, params->kernel->type, params, in, out)
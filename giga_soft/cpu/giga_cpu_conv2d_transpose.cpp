@@ -0,0 +1,291 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \author Roland Brochard (roland.brochard@airbus.com)
+ * \date 15/01/2025
+ *
+ * Baseline CPU implementation of the GIGA API
+ *
+ */
+
+#include "giga_cpu.h"
+#include "utils.h"
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+/*Compilation options to define the operational domain of the implementation*/
+#define TRANSPOSE_STRIDE 2
+#define MIN_TRANSPOSE_KERNEL_SIZE 2
+#define MAX_TRANSPOSE_KERNEL_SIZE 4
+
+template<GIGA_data_type i_GT, GIGA_data_type o_GT, GIGA_data_type k_GT>
+GIGA_error _conv2d_transpose_impl(const GIGA_conv2d_transpose_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out)
+{
+    typedef typename GIGA_C_Type<i_GT>::CType i_T;
+    typedef typename GIGA_C_Type<o_GT>::CType o_T;
+    typedef typename GIGA_C_Type<k_GT>::CType k_T;
+
+    typedef typename GIGA_Compute_Type<o_GT>::CType c_T;
+
+    if(in->nb_dims != out->nb_dims) RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    if(in->nb_dims < 2)             RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+    uint32_t nb_batch = 1;
+
+    uint32_t batch_stride_in = 0;
+    uint32_t batch_stride_out = 0;
+    if(in->nb_dims == 4)
+    {
+        //batch dimension
+        if(in->dims[0] != out->dims[0])
+            RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+
+        nb_batch = in->dims[0];
+        batch_stride_in = in->strides[0];
+        batch_stride_out = out->strides[0];
+    }
+
+    const uint32_t nb_out_channels = out->nb_dims == 2 ? 1 : out->dims[out->nb_dims - 3];
+    const uint32_t nb_in_channels = in->nb_dims == 2 ? 1 : in->dims[in->nb_dims - 3];
+
+    const GIGA_tensor_t * __restrict__ kernel = params->kernel;
+    if(kernel->nb_dims != 4)
+        RETURN_ERROR(GIGA_Incorrect_Parameter);
+    //For the kernel, the dimensions are always Ci, Co, H, W (the layout of the transposed convolution);
+
+    //check tensor dimensions relative to the kernel
+    if(kernel->dims[0] != nb_in_channels)   RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    if(kernel->dims[1] != nb_out_channels)  RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    for(uint32_t i = 2; i < 4; ++i)
+    {
+        if(kernel->dims[i] < MIN_TRANSPOSE_KERNEL_SIZE || kernel->dims[i] > MAX_TRANSPOSE_KERNEL_SIZE)
+            RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    }
+
+    if(params->stride[0] != TRANSPOSE_STRIDE || params->stride[1] != TRANSPOSE_STRIDE) RETURN_ERROR(GIGA_Incorrect_Parameter);
+
+    const uint32_t kernel_H = kernel->dims[2];
+    const uint32_t kernel_W = kernel->dims[3];
+    for(uint32_t i = 0; i < 2; ++i)
+    {
+        if(params->padding[0][i] < 0 || uint32_t(params->padding[0][i]) >= kernel_H)  RETURN_ERROR(GIGA_Incorrect_Parameter);
+        if(params->padding[1][i] < 0 || uint32_t(params->padding[1][i]) >= kernel_W)  RETURN_ERROR(GIGA_Incorrect_Parameter);
+    }
+
+    uint32_t bias_dimension = 0;
+
+    if(params->bias != NULL)
+    {
+        bias_dimension = params->bias->nb_dims - 1;
+        if(!check_tensor_exists(params->bias)) RETURN_ERROR(GIGA_Incorrect_Parameter);
+
+        if(kernel->type != params->bias->type) RETURN_ERROR(GIGA_Incorrect_Parameter);
+
+        if(!(params->bias->nb_dims == 1 || (params->bias->nb_dims == 2 && params->bias->dims[0] == 1)))
+            RETURN_ERROR(GIGA_Incorrect_Parameter);
+
+        if(params->bias->dims[bias_dimension] != nb_out_channels) RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    }
+
+    //Check H,W dimensions depending on the padding parameter
+    //The width dimension always immediately follows the height dimension
+    const uint32_t H_dim_in = in->nb_dims - 2;
+    const uint32_t W_dim_in = H_dim_in + 1;
+
+    const uint32_t H_dim_out = out->nb_dims - 2;
+    const uint32_t W_dim_out = H_dim_out + 1;
+
+    const uint32_t H = in->dims[H_dim_in];
+    const uint32_t W = in->dims[W_dim_in];
+
+    //check dimensions: the full output is cropped by the padding
+    if(out->dims[H_dim_out] != (H - 1) * TRANSPOSE_STRIDE + kernel_H - params->padding[0][0] - params->padding[0][1])
+        RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    if(out->dims[W_dim_out] != (W - 1) * TRANSPOSE_STRIDE + kernel_W - params->padding[1][0] - params->padding[1][1])
+        RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+
+    const uint32_t in_stride_C = (in->nb_dims == 2) ? 1 : in->strides[in->nb_dims - 3] / sizeof(i_T);
+    const uint32_t out_stride_C = (out->nb_dims == 2) ? 1 : out->strides[out->nb_dims - 3] / sizeof(o_T);
+
+    const int out_shift = int(out->fp_shift) - (int(in->fp_shift) + int(params->kernel->fp_shift)) ;
+    const int bias_reshift = (params->bias != nullptr) ? -int(params->bias->fp_shift) + (int(in->fp_shift) + int(params->kernel->fp_shift)) : 0;
+
+    const uint32_t bias_stride = params->bias ? params->bias->strides[bias_dimension] / sizeof(k_T) : 0;
+
+    const uint32_t out_y_end = out->dims[H_dim_out];
+    const uint32_t out_x_end = out->dims[W_dim_out];
+
+    const uint32_t out_stride_B = batch_stride_out / sizeof(o_T);
+    const uint32_t out_stride_H = out->strides[H_dim_out] / sizeof(o_T);
+    const uint32_t out_stride_W = out->strides[W_dim_out] / sizeof(o_T);
+
+    const uint32_t in_stride_B = batch_stride_in / sizeof(i_T);
+    const uint32_t in_stride_H = in->strides[H_dim_in] / sizeof(i_T);
+    const uint32_t in_stride_W = in->strides[W_dim_in] / sizeof(i_T);
+
+    const uint32_t kernel_stride0 = kernel->strides[0] / sizeof(k_T);
+    const uint32_t kernel_stride1 = kernel->strides[1] / sizeof(k_T);
+    const uint32_t kernel_stride2 = kernel->strides[2] / sizeof(k_T);
+    const uint32_t kernel_stride3 = kernel->strides[3] / sizeof(k_T);
+
+    const uint32_t padding_y = params->padding[0][0];
+    const uint32_t padding_x = params->padding[1][0];
+
+#ifdef ENABLE_OPTIMIZATION
+    // Assume out_stride_W == 1
+    // Assume in_stride_W == 1
+    //Sub-pixel phase decomposition: the output pixel at position t of the full output only receives the kernel taps k with the parity of t,
+    //from the input pixels (t - k) / 2. Each output row is therefore the sum of ceil(K / 2) input rows, and within a row, the outputs of each
+    //phase are a small 1d convolution of the input row. Those are accumulated into contiguous per-phase buffers and interleaved at the end.
+    const uint32_t q_begin = padding_x / 2;
+    const uint32_t q_end = (padding_x + out_x_end - 1) / 2 + 1;
+    const uint32_t nb_q = q_end - q_begin;
+
+    const uint32_t nb_jobs = nb_batch * nb_out_channels * out_y_end;
+#pragma omp parallel
+    {
+        std::vector<c_T> phase_rows(2 * nb_q);
+        std::vector<c_T> in_row(W);
+
+#pragma omp for schedule(static)
+        for (uint32_t job = 0 ; job < nb_jobs ; ++job)
+        {
+            const uint32_t out_y = job % out_y_end;
+            const uint32_t out_ch = (job / out_y_end) % nb_out_channels;
+            const uint32_t batch = job / (out_y_end * nb_out_channels);
+
+            const i_T * const in_ptr0 = get_cptr<i_T>(in) + batch * in_stride_B;
+            const k_T * const k_ptr0 = get_cptr<k_T>(kernel) + out_ch * kernel_stride1;
+
+            std::fill(phase_rows.begin(), phase_rows.end(), c_T(0));
+
+            const uint32_t t_y = out_y + padding_y;
+            for (uint32_t c_in = 0 ; c_in < nb_in_channels; ++c_in)
+            {
+                const i_T * const in_ptr1 = in_ptr0 + c_in * in_stride_C;
+                const k_T * const k_ptr1 = k_ptr0 + c_in * kernel_stride0;
+                for (uint32_t ker_y = t_y & 1; ker_y < kernel_H; ker_y += TRANSPOSE_STRIDE)
+                {
+                    const uint32_t in_y = (t_y - ker_y) / TRANSPOSE_STRIDE;
+                    if (ker_y > t_y || in_y >= H)
+                        continue;
+
+                    //Input rows are converted once and reused by all the taps of the row
+                    const i_T * const in_ptr2 = in_ptr1 + in_y * in_stride_H;
+                    const c_T * row_ptr = reinterpret_cast<const c_T *>(in_ptr2);
+                    if (!std::is_same<i_T, c_T>::value)
+                    {
+                        for (uint32_t x = 0; x < W; ++x)
+                            in_row[x] = c_T(in_ptr2[x]);
+                        row_ptr = in_row.data();
+                    }
+                    for (uint32_t phase = 0; phase < 2; ++phase)
+                    {
+                        c_T * const acc_ptr = phase_rows.data() + phase * nb_q;
+                        for (uint32_t ker_x = phase, tap = 0; ker_x < kernel_W; ker_x += TRANSPOSE_STRIDE, ++tap)
+                        {
+                            const c_T k = c_T(k_ptr1[ker_y * kernel_stride2 + ker_x * kernel_stride3]);
+                            //in_x = q - tap must be inside the input
+                            const uint32_t q0 = std::max(q_begin, tap);
+                            const uint32_t q1 = std::min(q_end, W + tap);
+                            for (uint32_t q = q0; q < q1; ++q)
+                                acc_ptr[q - q_begin] += k * row_ptr[q - tap];
+                        }
+                    }
+                }
+            }
+
+            const c_T bias = params->bias ? shift(c_T(get_cptr<k_T>(params->bias)[out_ch * bias_stride]), bias_reshift) : c_T(0);
+            o_T * const out_ptr2 = get_ptr<o_T>(out) + batch * out_stride_B + out_ch * out_stride_C + out_y * out_stride_H;
+            for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+            {
+                const uint32_t t_x = out_x + padding_x;
+                const c_T acc = phase_rows[(t_x & 1) * nb_q + t_x / 2 - q_begin] + bias;
+                if(params->b_ReLU)
+                    out_ptr2[out_x] = acc > 0 ? o_T(shift(acc, out_shift)) : o_T(0);
+                else
+                    out_ptr2[out_x] = o_T(shift(acc, out_shift));
+            }
+        }
+    }
+#else       // Reference implementation
+    for (uint32_t batch = 0 ; batch < nb_batch ; ++batch)
+    {
+        for (uint32_t out_ch = 0; out_ch < nb_out_channels ; ++out_ch)
+        {
+            c_T bias = c_T(0);
+            if(params->bias != NULL)
+            {
+                const k_T * const bias_ptr = get_cptr<k_T>(params->bias) + out_ch * bias_stride;
+                bias = *bias_ptr;
+            }
+
+            for (uint32_t out_y = 0 ; out_y < out_y_end ; ++out_y)
+            {
+                for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+                {
+                    const uint32_t out_offset = batch * out_stride_B + out_ch * out_stride_C + out_y * out_stride_H + out_x * out_stride_W;
+                    o_T * const out_ptr = get_ptr<o_T>(out) + out_offset;
+                    c_T acc = 0;
+
+                    for(uint32_t ker_y = 0; ker_y < kernel_H ; ++ker_y)
+                    {
+                        //Position in the full output relative to the kernel tap, it must fall on an input pixel
+                        const int32_t t_y = int32_t(out_y + padding_y) - int32_t(ker_y);
+                        if (t_y < 0 || t_y % TRANSPOSE_STRIDE != 0 || uint32_t(t_y / TRANSPOSE_STRIDE) >= H)
+                            continue;
+                        const uint32_t in_y = t_y / TRANSPOSE_STRIDE;
+                        for(uint32_t ker_x = 0 ; ker_x < kernel_W ; ++ker_x)
+                        {
+                            const int32_t t_x = int32_t(out_x + padding_x) - int32_t(ker_x);
+                            if (t_x < 0 || t_x % TRANSPOSE_STRIDE != 0 || uint32_t(t_x / TRANSPOSE_STRIDE) >= W)
+                                continue;
+                            const uint32_t in_x = t_x / TRANSPOSE_STRIDE;
+                            for (uint32_t c_in = 0 ; c_in < nb_in_channels; ++c_in)
+                            {
+                                const uint32_t in_offset = batch * in_stride_B
+                                                           + c_in * in_stride_C
+                                                           + in_y * in_stride_H
+                                                           + in_x * in_stride_W;
+
+                                const i_T * const in_ptr = get_cptr<i_T>(in) + in_offset;
+
+                                const uint32_t k_offset =  c_in * kernel_stride0
+                                                           + out_ch * kernel_stride1
+                                                           + ker_y * kernel_stride2
+                                                           + ker_x * kernel_stride3;
+
+                                const k_T * const k_ptr = get_cptr<k_T>(kernel) + k_offset;
+                                acc += c_T(*k_ptr) * c_T(*in_ptr);
+                            }
+                        }
+                    }
+
+                    acc += shift(bias, bias_reshift);
+                    if(params->b_ReLU)
+                        *out_ptr = acc > 0 ? o_T(shift(acc, out_shift)) : o_T(0);
+                    else
+                        *out_ptr = o_T(shift(acc, out_shift));
+                }
+            }
+        }
+    }
+#endif
+
+    return GIGA_Success;
+}
+
+GIGA_error giga_conv2d_transpose_(const GIGA_conv2d_transpose_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line)
+{
+    if (!check_tensor_exists(in) || !check_tensor_exists(out) || !check_tensor_exists(params->kernel))
+        RETURN_ERROR(GIGA_Unknown_tensor);
+
+    run_on_memory_zone_node(out);
+
+    GIGA_error ret;
+#ifdef ENABLE_OPTIMIZATION
+    GIGA_CALL_TEMPLATED_FUNC_ON_3_TENSORS_SIGNED_KERNELS(_conv2d_transpose_impl, in->type, out->type, params->kernel->type, params, in, out)
+#else
+    GIGA_CALL_TEMPLATED_FUNC_ON_3_TENSORS(_conv2d_transpose_impl, in->type, out->type, params->kernel->type, params, in, out)
+#endif
+    RETURN_ERROR(ret);
+}
@@ -135,6 +135,8 @@ GIGA_error giga_dense_(const GIGA_dense_t *params, const GIGA_tensor_t *in, GIGA
     if (!check_tensor_exists(in) || !check_tensor_exists(out) || !check_tensor_exists(params->kernel))
         RETURN_ERROR(GIGA_Unknown_tensor);
 
+    run_on_memory_zone_node(out);
+
     GIGA_error ret;
 #ifdef ENABLE_OPTIMIZATION
     GIGA_CALL_TEMPLATED_FUNC_ON_3_TENSORS_SIGNED_KERNELS(_dense_impl, in->type, out->type, params->kernel->type, params, in, out)
@@ -0,0 +1,267 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \author Roland Brochard (roland.brochard@airbus.com)
+ * \date 15/01/2025
+ *
+ * Baseline CPU implementation of the GIGA API
+ *
+ * Generic engine for elementwise operations: walks several tensors with broadcastable shapes, each with its own strides.
+ *
+ */
+
+#ifndef GIGA_CPU_ELEMENTWISE_H_cf946b1898a7cd9018657b776ea6dbc9
+#define GIGA_CPU_ELEMENTWISE_H_cf946b1898a7cd9018657b776ea6dbc9
+
+#include "giga_cpu.h"
+#include "utils.h"
+#include <algorithm>
+#include <cstdint>
+
+/*Compilation options to define the operational domain of the implementation*/
+#define ELEMENTWISE_CHUNK_SIZE          16384   // Maximum number of elements given to a kernel in one call
+#define ELEMENTWISE_PARALLEL_THRESHOLD  65536   // Below this number of elements, everything runs on the calling thread
+
+/* NumPy style broadcasting: dimensions are aligned on the right, an operand dimension must either be equal to
+ * the output dimension or be 1, missing leading dimensions count as 1.
+ */
+inline GIGA_error check_broadcast(const GIGA_tensor_t *operand, const GIGA_tensor_t *out)
+{
+    if(operand->nb_dims > out->nb_dims)
+        return GIGA_Inconsistent_Number_Of_Dimensions;
+
+    const uint32_t dim_offset = out->nb_dims - operand->nb_dims;
+    for(uint32_t dim = 0; dim < operand->nb_dims; ++dim)
+    {
+        if(operand->dims[dim] != 1 && operand->dims[dim] != out->dims[dim + dim_offset])
+            return GIGA_Inconsistent_Tensor_Sizes;
+    }
+    return GIGA_Success;
+}
+
+/* Strides in bytes of an operand expressed along the dimensions of the output, broadcast dimensions get a 0 stride.
+ * The operand must have been checked with check_broadcast.
+ */
+inline void broadcast_strides(const GIGA_tensor_t *operand, const GIGA_tensor_t *out, int64_t strides[4])
+{
+    const uint32_t dim_offset = out->nb_dims - operand->nb_dims;
+    for(uint32_t dim = 0; dim < 4; ++dim)
+        strides[dim] = 0;
+    for(uint32_t dim = 0; dim < operand->nb_dims; ++dim)
+    {
+        if(operand->dims[dim] == out->dims[dim + dim_offset])
+            strides[dim + dim_offset] = operand->strides[dim];
+    }
+}
+
+/* Iteration space of an elementwise operation on N tensors, operand 0 being the output and the others being
+ * broadcastable to it.
+ * Dimensions of size 1 are dropped and dimensions contiguous in all tensors are merged, so the innermost
+ * dimension is as long as possible: a fully contiguous operation becomes a single dimension. A broadcast
+ * operand has a 0 stride along the dimensions it is repeated on.
+ */
+template<uint32_t N>
+struct Elementwise_layout
+{
+    uint32_t nb_dims;
+    uint32_t dims[4];
+    int64_t strides[N][4];  // In bytes
+
+    inline Elementwise_layout(const GIGA_tensor_t * const (&tensors)[N])
+    {
+        const GIGA_tensor_t * const out = tensors[0];
+
+        int64_t full_strides[N][4];
+        for(uint32_t k = 0; k < N; ++k)
+            broadcast_strides(tensors[k], out, full_strides[k]);
+
+        nb_dims = 0;
+        for(uint32_t dim = 0; dim < out->nb_dims; ++dim)
+        {
+            if(out->dims[dim] == 1)
+                continue;
+
+            // Merge with the previous (outer) dimension when it directly follows this one in memory for all tensors
+            bool b_merge = nb_dims > 0;
+            for(uint32_t k = 0; k < N && b_merge; ++k)
+                b_merge = strides[k][nb_dims - 1] == full_strides[k][dim] * out->dims[dim];
+
+            if(b_merge)
+            {
+                dims[nb_dims - 1] *= out->dims[dim];
+                for(uint32_t k = 0; k < N; ++k)
+                    strides[k][nb_dims - 1] = full_strides[k][dim];
+            }
+            else
+            {
+                dims[nb_dims] = out->dims[dim];
+                for(uint32_t k = 0; k < N; ++k)
+                    strides[k][nb_dims] = full_strides[k][dim];
+                ++nb_dims;
+            }
+        }
+
+        // Scalar case
+        if(nb_dims == 0)
+        {
+            nb_dims = 1;
+            dims[0] = 1;
+            for(uint32_t k = 0; k < N; ++k)
+                strides[k][0] = 0;
+        }
+    }
+};
+
+/* Runs kernel(n, ptrs, strides) over the whole layout, ptrs being the addresses of the first of n elements
+ * and strides the innermost strides in bytes of each tensor. The innermost dimension is cut in chunks and
+ * chunks are distributed among threads for large tensors.
+ */
+template<uint32_t N, class Kernel>
+inline void elementwise_run(const Elementwise_layout<N> &layout, char * const (&base)[N], const Kernel &kernel)
+{
+    const uint32_t inner_dim = layout.nb_dims - 1;
+    const uint32_t inner_size = layout.dims[inner_dim];
+
+    uint64_t nb_rows = 1;
+    for(uint32_t dim = 0; dim < inner_dim; ++dim)
+        nb_rows *= layout.dims[dim];
+
+    int64_t inner_strides[N];
+    for(uint32_t k = 0; k < N; ++k)
+        inner_strides[k] = layout.strides[k][inner_dim];
+
+    const uint32_t chunk_size = std::min<uint32_t>(inner_size, ELEMENTWISE_CHUNK_SIZE);
+    const uint32_t nb_chunks = (inner_size + chunk_size - 1) / chunk_size;
+    const int64_t nb_tasks = int64_t(nb_rows * nb_chunks);
+#ifdef ENABLE_OPTIMIZATION
+    const uint64_t nb_elements = nb_rows * inner_size;
+#pragma omp parallel for schedule(static) if(nb_elements >= ELEMENTWISE_PARALLEL_THRESHOLD)
+#endif
+    for(int64_t task = 0; task < nb_tasks; ++task)
+    {
+        const uint32_t begin = uint32_t(task % nb_chunks) * chunk_size;
+        const uint32_t n = std::min<uint32_t>(chunk_size, inner_size - begin);
+
+        char *ptrs[N];
+        for(uint32_t k = 0; k < N; ++k)
+            ptrs[k] = base[k] + begin * inner_strides[k];
+
+        uint64_t row = uint64_t(task / nb_chunks);
+        for(int32_t dim = int32_t(inner_dim) - 1; dim >= 0 && row; --dim)
+        {
+            const uint64_t idx = row % layout.dims[dim];
+            row /= layout.dims[dim];
+            for(uint32_t k = 0; k < N; ++k)
+                ptrs[k] += idx * layout.strides[k][dim];
+        }
+
+        kernel(n, ptrs, inner_strides);
+    }
+}
+
+/* out = op(a, b) with broadcasting, values being converted to v_T before calling op.
+ * Besides the fully contiguous case, runs where one operand is repeated (per channel or per pixel operands) get their own loops.
+ */
+template<typename v_T, typename o_T, typename a_T, typename b_T, class Op>
+inline void elementwise_binary_run(const GIGA_tensor_t *a, const GIGA_tensor_t *b, GIGA_tensor_t *out, const Op &op)
+{
+    const GIGA_tensor_t * const tensors[3] = {out, a, b};
+    const Elementwise_layout<3> layout(tensors);
+    char * const base[3] = {get_ptr<char>(out), (char*)get_cptr<char>(a), (char*)get_cptr<char>(b)};
+    elementwise_run(layout, base, [&](const uint32_t n, char * const *ptrs, const int64_t *strides)
+    {
+        o_T * const out_ptr = (o_T*)ptrs[0];
+        const a_T * const a_ptr = (const a_T*)ptrs[1];
+        const b_T * const b_ptr = (const b_T*)ptrs[2];
+        const bool b_out_contiguous = strides[0] == sizeof(o_T);
+        if(b_out_contiguous && strides[1] == sizeof(a_T) && strides[2] == sizeof(b_T))
+        {
+#ifdef ENABLE_OPTIMIZATION
+#pragma omp simd
+#endif
+            for(uint32_t i = 0; i < n; ++i)
+                out_ptr[i] = saturate_cast<o_T>(op(v_T(a_ptr[i]), v_T(b_ptr[i])));
+        }
+        else if(b_out_contiguous && strides[1] == sizeof(a_T) && strides[2] == 0)
+        {
+            const v_T b_value = v_T(*b_ptr);
+#ifdef ENABLE_OPTIMIZATION
+#pragma omp simd
+#endif
+            for(uint32_t i = 0; i < n; ++i)
+                out_ptr[i] = saturate_cast<o_T>(op(v_T(a_ptr[i]), b_value));
+        }
+        else if(b_out_contiguous && strides[1] == 0 && strides[2] == sizeof(b_T))
+        {
+            const v_T a_value = v_T(*a_ptr);
+#ifdef ENABLE_OPTIMIZATION
+#pragma omp simd
+#endif
+            for(uint32_t i = 0; i < n; ++i)
+                out_ptr[i] = saturate_cast<o_T>(op(a_value, v_T(b_ptr[i])));
+        }
+        else
+        {
+            const int64_t out_stride = strides[0] / int64_t(sizeof(o_T));
+            const int64_t a_stride = strides[1] / int64_t(sizeof(a_T));
+            const int64_t b_stride = strides[2] / int64_t(sizeof(b_T));
+            for(uint32_t i = 0; i < n; ++i)
+                out_ptr[i * out_stride] = saturate_cast<o_T>(op(v_T(a_ptr[i * a_stride]), v_T(b_ptr[i * b_stride])));
+        }
+    });
+}
+
+/* Reference version of elementwise_binary_run: a plain walk over the 4 dimensions of the output */
+template<typename v_T, typename o_T, typename a_T, typename b_T, class Op>
+inline void elementwise_binary_reference(const GIGA_tensor_t *a, const GIGA_tensor_t *b, GIGA_tensor_t *out, const Op &op)
+{
+    uint32_t dims[4] = {1, 1, 1, 1};
+    int64_t a_strides[4];
+    int64_t b_strides[4];
+    int64_t out_strides[4] = {0, 0, 0, 0};
+    broadcast_strides(a, out, a_strides);
+    broadcast_strides(b, out, b_strides);
+    for(uint32_t i = 0; i < out->nb_dims; ++i)
+    {
+        dims[i] = out->dims[i];
+        out_strides[i] = out->strides[i];
+    }
+
+    char * const out_ptr = get_ptr<char>(out);
+    const char * const a_ptr = get_cptr<char>(a);
+    const char * const b_ptr = get_cptr<char>(b);
+    for(uint32_t i0 = 0; i0 < dims[0]; ++i0)
+        for(uint32_t i1 = 0; i1 < dims[1]; ++i1)
+            for(uint32_t i2 = 0; i2 < dims[2]; ++i2)
+                for(uint32_t i3 = 0; i3 < dims[3]; ++i3)
+                {
+                    const a_T a_value = *(const a_T*)(a_ptr + i0 * a_strides[0] + i1 * a_strides[1] + i2 * a_strides[2] + i3 * a_strides[3]);
+                    const b_T b_value = *(const b_T*)(b_ptr + i0 * b_strides[0] + i1 * b_strides[1] + i2 * b_strides[2] + i3 * b_strides[3]);
+                    *(o_T*)(out_ptr + i0 * out_strides[0] + i1 * out_strides[1] + i2 * out_strides[2] + i3 * out_strides[3])
+                        = saturate_cast<o_T>(op(v_T(a_value), v_T(b_value)));
+                }
+}
+
+/* Checks that a and b can be broadcast together and that out has the broadcast shape */
+inline GIGA_error check_binary_broadcast(const GIGA_tensor_t *a, const GIGA_tensor_t *b, const GIGA_tensor_t *out)
+{
+    if(std::max(a->nb_dims, b->nb_dims) != out->nb_dims)
+        return GIGA_Inconsistent_Number_Of_Dimensions;
+
+    GIGA_error error;
+    if((error = check_broadcast(a, out)) != GIGA_Success)  return error;
+    if((error = check_broadcast(b, out)) != GIGA_Success)  return error;
+
+    // The output cannot be larger than its inputs
+    for(uint32_t dim = 0; dim < out->nb_dims; ++dim)
+    {
+        const int32_t a_dim = int32_t(dim) - int32_t(out->nb_dims - a->nb_dims);
+        const int32_t b_dim = int32_t(dim) - int32_t(out->nb_dims - b->nb_dims);
+        const uint32_t a_size = a_dim >= 0 ? a->dims[a_dim] : 1;
+        const uint32_t b_size = b_dim >= 0 ? b->dims[b_dim] : 1;
+        if(out->dims[dim] != std::max(a_size, b_size))
+            return GIGA_Inconsistent_Tensor_Sizes;
+    }
+    return GIGA_Success;
+}
+
+#endif // GIGA_CPU_ELEMENTWISE_H_cf946b1898a7cd9018657b776ea6dbc9
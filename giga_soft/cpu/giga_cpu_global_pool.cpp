@@ -0,0 +1,145 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \author Roland Brochard (roland.brochard@airbus.com)
+ * \date 15/01/2025
+ *
+ * Baseline CPU implementation of the GIGA API
+ *
+ */
+
+#include "giga_cpu.h"
+#include "utils.h"
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+template<GIGA_data_type i_GT>
+GIGA_error _global_pool_impl(const GIGA_global_pool_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out)
+{
+    typedef typename GIGA_C_Type<i_GT>::CType i_T;
+
+    typedef typename GIGA_Compute_Type<i_GT>::CType c_T;
+    // Sums of fixed point values are accumulated in 64 bits so that large feature maps never overflow
+    typedef typename std::conditional<std::is_integral<c_T>::value, int64_t, c_T>::type a_T;
+
+    const GIGA_pool_mode mode = params->mode;
+    if(mode != GIGA_Pool_Average && mode != GIGA_Pool_Max)  RETURN_ERROR(GIGA_Incorrect_Parameter);
+
+    if(in->type != out->type)   RETURN_ERROR(GIGA_Inconsistent_Tensor_Types);
+    if(in->nb_dims < 2)         RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+
+    //The output either keeps H and W with a size of 1 or drops them
+    const bool b_keep_dims = out->nb_dims == in->nb_dims;
+    if(!b_keep_dims && (out->nb_dims == 0 || out->nb_dims + 2 != in->nb_dims))
+        RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+
+    //Batch and channel dimensions are left untouched
+    for(uint32_t i = 0; i + 2 < in->nb_dims; ++i)
+    {
+        if(in->dims[i] != out->dims[i])
+            RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    }
+    if(b_keep_dims && (out->dims[in->nb_dims - 2] != 1 || out->dims[in->nb_dims - 1] != 1))
+        RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+
+    const uint32_t nb_batch = in->nb_dims == 4 ? in->dims[0] : 1;
+    const uint32_t nb_channels = in->nb_dims == 2 ? 1 : in->dims[in->nb_dims - 3];
+
+    //The width dimension always immediately follows the height dimension
+    const uint32_t H_dim = in->nb_dims - 2;
+    const uint32_t W_dim = H_dim + 1;
+
+    const uint32_t H = in->dims[H_dim];
+    const uint32_t W = in->dims[W_dim];
+
+    const uint32_t in_stride_B = in->nb_dims == 4 ? in->strides[0] / sizeof(i_T) : 0;
+    const uint32_t in_stride_C = in->nb_dims == 2 ? 0 : in->strides[in->nb_dims - 3] / sizeof(i_T);
+    const uint32_t in_stride_H = in->strides[H_dim] / sizeof(i_T);
+    const uint32_t in_stride_W = in->strides[W_dim] / sizeof(i_T);
+
+    const uint32_t out_stride_B = in->nb_dims == 4 ? out->strides[0] / sizeof(i_T) : 0;
+    const uint32_t out_stride_C = in->nb_dims == 2 ? 0 : out->strides[in->nb_dims - 3] / sizeof(i_T);
+
+    //Fixed point values are written in the representation of the output
+    const int out_shift = is_float(in->type) ? 0 : int(out->fp_shift) - int(in->fp_shift);
+    const bool b_average = mode == GIGA_Pool_Average;
+    const uint32_t count = H * W;
+
+    const i_T * const in_ptr0 = get_cptr<i_T>(in);
+    i_T * const out_ptr0 = get_ptr<i_T>(out);
+
+#ifdef ENABLE_OPTIMIZATION
+    // Assume in_stride_W == 1
+    //Each row is reduced in 32 bits so that the inner loop vectorizes, rows are then accumulated in a_T
+    typedef typename std::conditional<std::is_integral<c_T>::value, int32_t, c_T>::type v_T;
+
+    const uint32_t nb_jobs = nb_batch * nb_channels;
+#pragma omp parallel for schedule(static)
+    for(uint32_t job = 0; job < nb_jobs; ++job)
+    {
+        const uint32_t channel = job % nb_channels;
+        const uint32_t batch = job / nb_channels;
+        const i_T * const in_ptr1 = in_ptr0 + batch * in_stride_B + channel * in_stride_C;
+
+        a_T acc = b_average ? a_T(0) : std::numeric_limits<a_T>::lowest();
+        for(uint32_t y = 0; y < H; ++y)
+        {
+            const i_T * const in_ptr2 = in_ptr1 + y * in_stride_H;
+            if(b_average)
+            {
+                v_T sum = v_T(0);
+                for(uint32_t x = 0; x < W; ++x)
+                    sum += v_T(in_ptr2[x]);
+                acc += a_T(sum);
+            }
+            else
+            {
+                v_T max = std::numeric_limits<v_T>::lowest();
+                for(uint32_t x = 0; x < W; ++x)
+                    max = std::max(max, v_T(in_ptr2[x]));
+                acc = std::max(acc, a_T(max));
+            }
+        }
+
+        out_ptr0[batch * out_stride_B + channel * out_stride_C] = b_average ? pool_average<i_T, a_T>(acc, count, out_shift)
+                                                                            : pool_max<i_T, a_T>(acc, out_shift);
+    }
+#else
+    for(uint32_t batch = 0; batch < nb_batch; ++batch)
+    {
+        for(uint32_t channel = 0; channel < nb_channels; ++channel)
+        {
+            a_T acc = b_average ? a_T(0) : std::numeric_limits<a_T>::lowest();
+            for(uint32_t y = 0; y < H; ++y)
+            {
+                for(uint32_t x = 0; x < W; ++x)
+                {
+                    const a_T value = a_T(in_ptr0[batch * in_stride_B + channel * in_stride_C + y * in_stride_H + x * in_stride_W]);
+                    acc = b_average ? acc + value : std::max(acc, value);
+                }
+            }
+
+            i_T * const out_ptr = out_ptr0 + batch * out_stride_B + channel * out_stride_C;
+            if(b_average)
+                *out_ptr = pool_average<i_T, a_T>(acc, count, out_shift);
+            else
+                *out_ptr = pool_max<i_T, a_T>(acc, out_shift);
+        }
+    }
+#endif
+
+    return GIGA_Success;
+}
+
+GIGA_error giga_global_pool_(const GIGA_global_pool_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line)
+{
+    if (!check_tensor_exists(in) || !check_tensor_exists(out))
+        RETURN_ERROR(GIGA_Unknown_tensor);
+
+    run_on_memory_zone_node(out);
+
+    GIGA_error ret;
+    GIGA_CALL_TEMPLATED_FUNC_ON_TENSOR(_global_pool_impl, in->type, params, in, out)
+
+    RETURN_ERROR(ret);
+}
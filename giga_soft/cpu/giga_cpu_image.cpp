@@ -0,0 +1,184 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \author Roland Brochard (roland.brochard@airbus.com)
+ * \date 15/01/2025
+ *
+ * Baseline CPU implementation of the GIGA API
+ *
+ */
+
+#include "giga_cpu.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Converts a normalized value already scaled to the tensor representation, saturating then rounding half away from zero to the nearest fixed point value
+template<typename T>
+inline T round_cast(float value)
+{
+    const float saturated = std::min(std::max(value, float(std::numeric_limits<T>::min())), float(std::numeric_limits<T>::max()));
+    return T(saturated + std::copysign(0.5f, saturated));
+}
+
+template<>
+inline float round_cast<float>(float value)
+{
+    return value;
+}
+
+template<>
+inline half round_cast<half>(float value)
+{
+    return half(value);
+}
+
+#ifdef ENABLE_OPTIMIZATION
+//Normalizes one interleaved image row, scale and offset are repeated for each pixel so that the loop is contiguous and vectorizes
+template<typename s_T, typename o_T>
+inline void _image_row(const s_T * __restrict__ src, o_T * __restrict__ dst, const float * __restrict__ scale, const float * __restrict__ offset, const uint32_t size)
+{
+    for(uint32_t i = 0; i < size; ++i)
+        dst[i] = round_cast<o_T>(float(src[i]) * scale[i] + offset[i]);
+}
+
+//Writes one row of a channel plane from a normalized interleaved row, the number of channels is known at compile time for common images
+template<uint32_t NB_CHANNELS, typename o_T>
+inline void _image_plane_row(const o_T * __restrict__ src, o_T * __restrict__ dst, const uint32_t W, const uint32_t nb_channels)
+{
+    const uint32_t stride = NB_CHANNELS ? NB_CHANNELS : nb_channels;
+    for(uint32_t x = 0; x < W; ++x)
+        dst[x] = src[x * stride];
+}
+#endif
+
+template<GIGA_data_type o_GT, typename s_T>
+GIGA_error _copy_image_impl(const s_T *src_ptr0, const GIGA_image_t *image, GIGA_tensor_t *tensor)
+{
+    typedef typename GIGA_C_Type<o_GT>::CType o_T;
+
+    if(tensor->nb_dims != 3 && tensor->nb_dims != 4)    RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+
+    const uint32_t nb_images = tensor->nb_dims == 4 ? tensor->dims[0] : 1;
+    const uint32_t C_dim = tensor->nb_dims - 3;
+    const uint32_t nb_channels = tensor->dims[C_dim];
+    const uint32_t H = tensor->dims[C_dim + 1];
+    const uint32_t W = tensor->dims[C_dim + 2];
+
+    //Rows of the images may be padded
+    const size_t row_size = size_t(W) * nb_channels * sizeof(s_T);
+    const size_t row_stride = image->row_stride ? image->row_stride : row_size;
+    if(row_stride < row_size || row_stride % sizeof(s_T) != 0)  RETURN_ERROR(GIGA_Incorrect_Parameter);
+    const size_t src_stride_H = row_stride / sizeof(s_T);
+    const size_t src_stride_N = H * src_stride_H;
+
+    const uint32_t dst_stride_N = tensor->nb_dims == 4 ? tensor->strides[0] / sizeof(o_T) : 0;
+    const uint32_t dst_stride_C = tensor->strides[C_dim] / sizeof(o_T);
+    const uint32_t dst_stride_H = tensor->strides[C_dim + 1] / sizeof(o_T);
+    const uint32_t dst_stride_W = tensor->strides[C_dim + 2] / sizeof(o_T);
+
+    //The normalization and the fixed point scale of the tensor are folded into one multiply-add per sample
+    const float fp_scale = is_float(tensor->type) ? 1.f : float(1 << tensor->fp_shift);
+    std::vector<float> scale(nb_channels);
+    std::vector<float> offset(nb_channels);
+    for(uint32_t c = 0; c < nb_channels; ++c)
+    {
+        const float deviation = image->std ? image->std[c] : 1.f;
+        if(deviation == 0.f)
+            RETURN_ERROR(GIGA_Incorrect_Parameter);
+        scale[c] = fp_scale / deviation;
+        offset[c] = -(image->mean ? image->mean[c] : 0.f) * scale[c];
+    }
+
+    o_T * const dst_ptr0 = get_ptr<o_T>(tensor);
+
+#ifdef ENABLE_OPTIMIZATION
+    //Tensor rows are contiguous (the last stride is the element size), views included
+    if(dst_stride_W != 1)   RETURN_ERROR(GIGA_Incorrect_Parameter);
+
+    //Strided loads of narrow samples do not vectorize: each image row is first normalized in its interleaved order, then split into the channel planes
+    const uint32_t nb_row_samples = W * nb_channels;
+    std::vector<float> row_scale(nb_row_samples);
+    std::vector<float> row_offset(nb_row_samples);
+    for(uint32_t i = 0; i < nb_row_samples; ++i)
+    {
+        row_scale[i] = scale[i % nb_channels];
+        row_offset[i] = offset[i % nb_channels];
+    }
+
+    const uint32_t nb_jobs = nb_images * H;
+#pragma omp parallel
+    {
+        std::vector<o_T> row(nb_channels > 1 ? nb_row_samples : 0);
+
+#pragma omp for schedule(static)
+        for(uint32_t job = 0; job < nb_jobs; ++job)
+        {
+            const uint32_t y = job % H;
+            const uint32_t n = job / H;
+            const s_T * const src_row = src_ptr0 + n * src_stride_N + y * src_stride_H;
+            o_T * const dst_row = dst_ptr0 + n * dst_stride_N + y * dst_stride_H;
+            //A single channel image is already planar
+            if(nb_channels == 1)
+            {
+                _image_row(src_row, dst_row, row_scale.data(), row_offset.data(), nb_row_samples);
+                continue;
+            }
+
+            _image_row(src_row, row.data(), row_scale.data(), row_offset.data(), nb_row_samples);
+            for(uint32_t c = 0; c < nb_channels; ++c)
+            {
+                const o_T * const src = row.data() + c;
+                o_T * const dst = dst_row + c * dst_stride_C;
+                switch(nb_channels)
+                {
+                case 3:     _image_plane_row<3>(src, dst, W, nb_channels);    break;
+                case 4:     _image_plane_row<4>(src, dst, W, nb_channels);    break;
+                default:    _image_plane_row<0>(src, dst, W, nb_channels);    break;
+                }
+            }
+        }
+    }
+#else
+    for(uint32_t n = 0; n < nb_images; ++n)
+    {
+        for(uint32_t c = 0; c < nb_channels; ++c)
+        {
+            for(uint32_t y = 0; y < H; ++y)
+            {
+                for(uint32_t x = 0; x < W; ++x)
+                {
+                    const float sample = float(src_ptr0[n * src_stride_N + y * src_stride_H + x * nb_channels + c]);
+                    dst_ptr0[n * dst_stride_N + c * dst_stride_C + y * dst_stride_H + x * dst_stride_W] = round_cast<o_T>(sample * scale[c] + offset[c]);
+                }
+            }
+        }
+    }
+#endif
+
+    return GIGA_Success;
+}
+
+GIGA_error giga_copy_image_to_tensor_(const void *user_ptr, const GIGA_image_t *image, GIGA_tensor_t *tensor, const char *file, int line)
+{
+    if (!check_tensor_exists(tensor))
+        RETURN_ERROR(GIGA_Unknown_tensor);
+
+    run_on_memory_zone_node(tensor);
+
+    GIGA_error ret;
+    switch(image->type)
+    {
+    case GIGA_UFixed8:
+        GIGA_CALL_TEMPLATED_FUNC_ON_TENSOR(_copy_image_impl, tensor->type, static_cast<const uint8_t*>(user_ptr), image, tensor)
+        break;
+    case GIGA_UFixed16:
+        GIGA_CALL_TEMPLATED_FUNC_ON_TENSOR(_copy_image_impl, tensor->type, static_cast<const uint16_t*>(user_ptr), image, tensor)
+        break;
+    default:
+        ret = GIGA_Unimplemented_Type;
+    }
+
+    RETURN_ERROR(ret);
+}
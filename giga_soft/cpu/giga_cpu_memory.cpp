@@ -13,14 +13,32 @@
 
 #include <new>
 #include <vector>
+#include <map>
+#include <set>
+#include <mutex>
+#include <atomic>
 #include <iostream>
 #include <sstream>
+#include <string>
 #include <unistd.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include <fstream>
 #include <cstring>
-#ifndef GIGA_CPU_MEMORY
 #include <cstdlib>
+#include <type_traits>
+#include <limits>
+#include <cmath>
+#ifdef ENABLE_OPTIMIZATION
+#include <immintrin.h>
+#include <omp.h>
 #endif
 #include "utils.h"
+#include "giga_cpu_elementwise.h"
 
 class ignore
 {
@@ -29,90 +47,578 @@ public:
     const ignore &operator<<(const T &) const { return *this; }
 };
 
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#define MAX_NUMA_NODES 1024
+
+// Reads the cores of a NUMA node from sysfs (cpulist format, e.g. "0-15,32-47")
+static bool get_numa_node_cpus(int numa_node, cpu_set_t *cpus)
+{
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist");
+    std::string cpulist;
+    if (!std::getline(file, cpulist))
+        return false;
+
+    CPU_ZERO(cpus);
+    std::stringstream ranges(cpulist);
+    std::string range;
+    while(std::getline(ranges, range, ','))
+    {
+        const int first = atoi(range.c_str());
+        const size_t dash = range.find('-');
+        const int last = dash == std::string::npos ? first : atoi(range.c_str() + dash + 1);
+        for(int cpu = first ; cpu <= last && cpu < CPU_SETSIZE ; ++cpu)
+            CPU_SET(cpu, cpus);
+    }
+    return CPU_COUNT(cpus) > 0;
+}
+
+/* Memory zones are mapped directly from the system: they start on a page boundary, pages are zeroed on first touch instead of
+ * being filled when the zone is created and large zones are backed by huge pages to reduce TLB misses of the processing kernels */
 class MemoryPool
 {
 public :
     MemoryPool() :
-        nb_tensors(0) {}
+        nb_tensors(0),
+        m_data(nullptr),
+        m_size(0),
+        m_mapped_size(0),
+        m_numa_node(-1) {}
+
+    MemoryPool(MemoryPool &&pool) :
+        nb_tensors(pool.nb_tensors.load()),
+        m_data(pool.m_data),
+        m_size(pool.m_size),
+        m_mapped_size(pool.m_mapped_size),
+        m_numa_node(pool.m_numa_node),
+        m_cpus(pool.m_cpus),
+        m_path(std::move(pool.m_path)),
+        m_free_ranges(std::move(pool.m_free_ranges)),
+        m_free_sizes(std::move(pool.m_free_sizes)),
+        m_range_users(std::move(pool.m_range_users))
+    {
+        pool.m_data = nullptr;
+        pool.m_size = 0;
+        pool.m_mapped_size = 0;
+    }
+
+    MemoryPool(const MemoryPool &) = delete;
+    MemoryPool &operator=(const MemoryPool &) = delete;
+
+    ~MemoryPool()
+    {
+        if (m_data)
+            munmap(m_data, m_mapped_size);
+    }
+
+    // b_hugetlb requests pages from the huge page pool of the system (MAP_HUGETLB), transparent huge pages are used otherwise or if it is empty.
+    // When numa_node >= 0, pages are bound to this NUMA node.
+    bool allocate(size_t size, bool b_hugetlb, int numa_node)
+    {
+        if (numa_node >= 0)
+        {
+            if (numa_node >= MAX_NUMA_NODES || !get_numa_node_cpus(numa_node, &m_cpus))
+                return false;
+            m_numa_node = numa_node;
+        }
+
+        if (size == 0)
+            return true;
+
+        void *data = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        if (b_hugetlb)
+        {
+            m_mapped_size = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+            data = mmap(nullptr, m_mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+#endif
+        if (data == MAP_FAILED)
+        {
+            m_mapped_size = size;
+            data = mmap(nullptr, m_mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (data == MAP_FAILED)
+            {
+                m_mapped_size = 0;
+                return false;
+            }
+#ifdef MADV_HUGEPAGE
+            if (size >= HUGE_PAGE_SIZE)
+                madvise(data, m_mapped_size, MADV_HUGEPAGE);
+#endif
+        }
+
+        m_data = (uint8_t*)data;
+        m_size = size;
+        add_free_range(0, m_size);
+
+        // Pages are not touched yet, binding the mapping places all of them on the node
+        if (m_numa_node >= 0)
+        {
+            unsigned long node_mask[MAX_NUMA_NODES / (8 * sizeof(unsigned long))] = {};
+            node_mask[m_numa_node / (8 * sizeof(unsigned long))] = 1UL << (m_numa_node % (8 * sizeof(unsigned long)));
+            if (syscall(SYS_mbind, m_data, m_mapped_size, MPOL_BIND, node_mask, MAX_NUMA_NODES + 1, 0) != 0)
+                return false;
+        }
+        return true;
+    }
+
+    // Maps a file (typically a blob of weights) so that tensors read it in place. The mapping is private: pages are shared with the page cache,
+    // and so with other processes mapping the same file, until they are written to, and writes are never carried to the file.
+    // The file has no free ranges: automatic offsets would place tensors over the weights
+    bool map_file(const char *path)
+    {
+        const int fd = open(path, O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        void *data = MAP_FAILED;
+        if (file_stat.st_size > 0)
+            data = mmap(nullptr, file_stat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (file_stat.st_size > 0 && data == MAP_FAILED)
+            return false;
+
+        m_path = path;
+        if (file_stat.st_size > 0)
+        {
+            m_data = (uint8_t*)data;
+            m_size = file_stat.st_size;
+            m_mapped_size = m_size;
+        }
+        return true;
+    }
+
+    // Commits all the pages of the zone now instead of on first touch. Pages of a mapped file are only read, so that they stay shared.
+    void prefault()
+    {
+        const size_t page_size = sysconf(_SC_PAGESIZE);
+        volatile uint8_t * const data = m_data;
+        for(size_t i = 0 ; i < m_size ; i += page_size)
+        {
+            if (m_path.empty())
+                data[i] = 0;
+            else
+                (void)data[i];
+        }
+    }
+
+    // Best fit allocation of a range of the zone (the smallest free range large enough, the first one for equal sizes)
+    bool allocate_range(size_t size, size_t *offset)
+    {
+        const auto best_fit = m_free_sizes.lower_bound(std::make_pair(size, size_t(0)));
+        if (best_fit == m_free_sizes.end())
+            return false;
+
+        *offset = best_fit->second;
+        const size_t free_size = best_fit->first;
+        remove_free_range(*offset);
+        if (free_size > size)
+            add_free_range(*offset + size, free_size - size);
+        m_range_users[*offset] = 1;
+        return true;
+    }
+
+    // Adds a user (a view of its tensor) to an allocated range
+    void use_range(size_t offset)
+    {
+        ++m_range_users[offset];
+    }
+
+    // Removes a user of an allocated range, the last one gives the range back to the free ranges, merging it with its neighbours
+    void release_range(size_t offset, size_t size)
+    {
+        const auto users = m_range_users.find(offset);
+        if (--users->second > 0)
+            return;
+        m_range_users.erase(users);
+
+        const auto next = m_free_ranges.find(offset + size);
+        if (next != m_free_ranges.end())
+        {
+            size += next->second;
+            remove_free_range(next->first);
+        }
+
+        const auto previous = m_free_ranges.lower_bound(offset);
+        if (previous != m_free_ranges.begin() && std::prev(previous)->first + std::prev(previous)->second == offset)
+        {
+            offset = std::prev(previous)->first;
+            size += std::prev(previous)->second;
+            remove_free_range(offset);
+        }
+
+        add_free_range(offset, size);
+    }
+
+    // Removes a range used by a tensor allocated at an explicit offset from the free ranges, so that automatic offsets never overlap it
+    void reserve_range(size_t offset, size_t size)
+    {
+        const size_t end = offset + size;
+        auto range = m_free_ranges.lower_bound(offset);
+        if (range != m_free_ranges.begin() && std::prev(range)->first + std::prev(range)->second > offset)
+            --range;
+
+        while(range != m_free_ranges.end() && range->first < end)
+        {
+            const size_t free_offset = range->first;
+            const size_t free_end = free_offset + range->second;
+            ++range;
+            remove_free_range(free_offset);
+            if (free_offset < offset)
+                add_free_range(free_offset, offset - free_offset);
+            if (free_end > end)
+                add_free_range(end, free_end - end);
+        }
+    }
+
+    size_t size() const {   return m_size;   }
+
+    uint8_t *ptr()      {   return m_data;   }
 
-    size_t size() const {   return m_data.size();   }
+    const std::string &path() const {   return m_path;   }
 
-    uint8_t *ptr()      {   return m_data.data();   }
+    int numa_node() const   {   return m_numa_node;   }
+
+    const cpu_set_t &cpus() const   {   return m_cpus;   }
 
 public:
-    uint64_t nb_tensors;
-    std::vector<uint8_t> m_data;
+    std::atomic<uint64_t> nb_tensors;
+
+private:
+    uint8_t *m_data;
+    size_t m_size;
+    size_t m_mapped_size;
+    int m_numa_node;
+    cpu_set_t m_cpus;
+    std::string m_path;     // Mapped file if any
+
+    // Free ranges for automatic offsets, indexed by offset (to merge neighbours) and by size (for best fit lookups)
+    std::map<size_t, size_t> m_free_ranges;
+    std::set<std::pair<size_t, size_t>> m_free_sizes;
+    // Number of tensors and views using each allocated range, indexed by offset
+    std::map<size_t, uint32_t> m_range_users;
+
+    void add_free_range(size_t offset, size_t size)
+    {
+        m_free_ranges[offset] = size;
+        m_free_sizes.emplace(size, offset);
+    }
+
+    void remove_free_range(size_t offset)
+    {
+        const auto range = m_free_ranges.find(offset);
+        m_free_sizes.erase(std::make_pair(range->second, offset));
+        m_free_ranges.erase(range);
+    }
 };
 
-namespace
+/* Tensor metadata is taken from a slab instead of the heap: views are created and released per frame, this keeps malloc out of the processing.
+ * Slots are allocated by blocks which are never freed, so that a released slot can always be read by a concurrent allocation, and released
+ * slots are kept in a lock-free stack whose head is tagged with a counter to detect concurrent updates (ABA) */
+class TensorDataSlab
 {
-    static uint64_t current_tensor_id = 1;
-    static std::vector<MemoryPool> * s_memory_zones = nullptr;
+public:
+    Tensor_data_t *allocate()
+    {
+        uint64_t head = m_free_head.load(std::memory_order_acquire);
+        while(uint32_t(head) != NO_SLOT)
+        {
+            Slot &slot = get_slot(uint32_t(head));
+            const uint64_t next_head = ((head >> 32) + 1) << 32 | slot.next.load(std::memory_order_relaxed);
+            if (m_free_head.compare_exchange_weak(head, next_head, std::memory_order_acquire, std::memory_order_acquire))
+            {
+                slot.data = Tensor_data_t();
+                return &slot.data;
+            }
+        }
 
-    std::vector<MemoryPool> &GetMemoryZoneCollection()
+        // No released slot, take a new one
+        const uint32_t index = m_nb_slots.fetch_add(1, std::memory_order_relaxed);
+        if (index >= BLOCK_SIZE * MAX_BLOCKS)
+        {
+            m_nb_slots.fetch_sub(1, std::memory_order_relaxed);
+            throw std::bad_alloc();
+        }
+
+        std::atomic<Slot*> &block = m_blocks[index / BLOCK_SIZE];
+        if (block.load(std::memory_order_acquire) == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(m_blocks_mutex);
+            if (block.load(std::memory_order_relaxed) == nullptr)
+            {
+                Slot *slots = new Slot[BLOCK_SIZE];
+                for(uint32_t i = 0 ; i < BLOCK_SIZE ; ++i)
+                    slots[i].index = index / BLOCK_SIZE * BLOCK_SIZE + i;
+                block.store(slots, std::memory_order_release);
+            }
+        }
+        return &get_slot(index).data;
+    }
+
+    void release(Tensor_data_t *data)
     {
-        if (s_memory_zones == nullptr)
+        // data is the first member of its slot
+        Slot &slot = *reinterpret_cast<Slot*>(data);
+        slot.data.is_allocated = false;
+
+        uint64_t head = m_free_head.load(std::memory_order_relaxed);
+        uint64_t next_head;
+        do
         {
-            s_memory_zones = new std::vector<MemoryPool>();
+            slot.next.store(uint32_t(head), std::memory_order_relaxed);
+            next_head = ((head >> 32) + 1) << 32 | slot.index;
+        } while(!m_free_head.compare_exchange_weak(head, next_head, std::memory_order_release, std::memory_order_relaxed));
+    }
 
-            // Expected format is a list of ';' separated sizes expressed in bytes, KB (K suffix), MB (M suffix) or GB (G suffix)
-            const char *_GIGA_CPU_MEMORY = nullptr;
-            // Allow overriding this with a define
+private:
+    static const uint32_t NO_SLOT = 0xFFFFFFFF;
+    static const uint32_t BLOCK_SIZE = 4096;
+    static const uint32_t MAX_BLOCKS = 1024;    // Up to 4M tensors and views
+
+    struct Slot
+    {
+        Tensor_data_t data;
+        uint32_t index;
+        std::atomic<uint32_t> next;
+    };
+
+    Slot &get_slot(uint32_t index)
+    {
+        return m_blocks[index / BLOCK_SIZE].load(std::memory_order_acquire)[index % BLOCK_SIZE];
+    }
+
+    std::atomic<uint64_t> m_free_head{NO_SLOT};     // Index of the first released slot in the low 32 bits, update counter in the high 32 bits
+    std::atomic<uint32_t> m_nb_slots{0};
+    std::atomic<Slot*> m_blocks[MAX_BLOCKS] = {};
+    std::mutex m_blocks_mutex;
+};
+
+namespace
+{
+    static std::atomic<uint64_t> current_tensor_id{1};
+    static TensorDataSlab s_tensor_data_slab;
+    // Protects the free ranges of memory zones
+    static std::mutex s_allocation_mutex;
+    // Alignment required for the offset of tensors in memory zones, zones themselves are page aligned
+    static size_t s_alignment = 64;
+    // Memory zone id of tensors wrapping user buffers, which belong to no memory zone
+    static const uint64_t s_imported_zone_id = ~uint64_t(0);
+
+    std::vector<MemoryPool> *CreateMemoryZoneCollection()
+    {
+        std::vector<MemoryPool> *memory_zones = new std::vector<MemoryPool>();
+
+        // Expected format is a list of ';' separated sizes expressed in bytes, KB (K suffix), MB (M suffix) or GB (G suffix),
+        // each optionally followed by '@' and the NUMA node the zone is bound to (e.g. "2G@0;2G@1"),
+        // or of files prefixed with "file:" which are mapped as zones (e.g. "128M;file:/opt/models/net.bin")
+        const char *_GIGA_CPU_MEMORY = nullptr;
+        // Allow overriding this with a define
 #ifdef GIGA_CPU_MEMORY
-            _GIGA_CPU_MEMORY = GIGA_CPU_MEMORY;
+        _GIGA_CPU_MEMORY = GIGA_CPU_MEMORY;
 #else
-            _GIGA_CPU_MEMORY = getenv("GIGA_CPU_MEMORY");
+        _GIGA_CPU_MEMORY = getenv("GIGA_CPU_MEMORY");
 #endif
-            if (!_GIGA_CPU_MEMORY)
-                _GIGA_CPU_MEMORY = "128M";      // Default is a single pool of 128MB
+        if (!_GIGA_CPU_MEMORY)
+            _GIGA_CPU_MEMORY = "128M";      // Default is a single pool of 128MB
 
-            int nb_zones = 1;
-            for(const char *ptr = _GIGA_CPU_MEMORY ; *ptr ; ++ptr)
-                nb_zones += *ptr == ';';
-            s_memory_zones->reserve(nb_zones);
+        // Power of two alignment of tensor offsets in bytes, 64 (cache line) by default
+        const char *_GIGA_CPU_ALIGNMENT = nullptr;
+#ifdef GIGA_CPU_ALIGNMENT
+        _GIGA_CPU_ALIGNMENT = GIGA_CPU_ALIGNMENT;
+#else
+        _GIGA_CPU_ALIGNMENT = getenv("GIGA_CPU_ALIGNMENT");
+#endif
+        if (_GIGA_CPU_ALIGNMENT)
+        {
+            const size_t alignment = strtoul(_GIGA_CPU_ALIGNMENT, nullptr, 10);
+            if (alignment > 0 && (alignment & (alignment - 1)) == 0)
+                s_alignment = alignment;
+        }
 
-            size_t zone_size = 0;
-            for(const char *ptr = _GIGA_CPU_MEMORY ; *ptr ; ++ptr)
+        // Set to 1 to back memory zones with pages from the huge page pool of the system instead of transparent huge pages
+        const char *_GIGA_CPU_HUGE_PAGES = nullptr;
+#ifdef GIGA_CPU_HUGE_PAGES
+        _GIGA_CPU_HUGE_PAGES = GIGA_CPU_HUGE_PAGES;
+#else
+        _GIGA_CPU_HUGE_PAGES = getenv("GIGA_CPU_HUGE_PAGES");
+#endif
+        const bool b_hugetlb = _GIGA_CPU_HUGE_PAGES && strcmp(_GIGA_CPU_HUGE_PAGES, "1") == 0;
+
+        // Set to 1 to commit all pages when zones are created instead of on first touch
+        const char *_GIGA_CPU_PREFAULT = nullptr;
+#ifdef GIGA_CPU_PREFAULT
+        _GIGA_CPU_PREFAULT = GIGA_CPU_PREFAULT;
+#else
+        _GIGA_CPU_PREFAULT = getenv("GIGA_CPU_PREFAULT");
+#endif
+        const bool b_prefault = _GIGA_CPU_PREFAULT && strcmp(_GIGA_CPU_PREFAULT, "1") == 0;
+
+        size_t nb_zones = 1;
+        for(const char *ptr = _GIGA_CPU_MEMORY ; *ptr ; ++ptr)
+            nb_zones += *ptr == ';';
+        memory_zones->reserve(nb_zones);
+
+        std::stringstream zones(_GIGA_CPU_MEMORY);
+        std::string zone;
+        while(memory_zones->size() < nb_zones)
+        {
+            // An empty string is read past the last ';'
+            std::getline(zones, zone, ';');
+            memory_zones->emplace_back();
+            MemoryPool &pool = memory_zones->back();
+
+            bool b_success;
+            if (zone.compare(0, 5, "file:") == 0)
+                b_success = pool.map_file(zone.c_str() + 5);
+            else
             {
-                if (*ptr == ';')
+                size_t zone_size = 0;
+                int numa_node = -1;
+                for(const char c : zone)
                 {
-                    s_memory_zones->emplace_back();
-                    s_memory_zones->back().m_data.resize(zone_size);
-                    zone_size = 0;
+                    if (c == '@')
+                        numa_node = 0;
+                    else if (numa_node >= 0 && c >= '0' && c <= '9')
+                        numa_node = numa_node * 10 + (c - '0');
+                    else if (c == 'G')
+                        zone_size *= 1024 * 1024 * 1024;
+                    else if (c == 'M')
+                        zone_size *= 1024 * 1024;
+                    else if (c == 'K')
+                        zone_size *= 1024;
+                    else if (c >= '0' && c <= '9')
+                        zone_size = zone_size * 10 + (c - '0');
                 }
-                else if (*ptr == 'G')
-                    zone_size *= 1024 * 1024 * 1024;
-                else if (*ptr == 'M')
-                    zone_size *= 1024 * 1024;
-                else if (*ptr == 'K')
-                    zone_size *= 1024;
-                else if (*ptr >= '0' && *ptr <= '9')
-                    zone_size = zone_size * 10 + (*ptr - '0');
-            }
-            if (zone_size > 0 || s_memory_zones->size() < nb_zones)
-            {
-                s_memory_zones->emplace_back();
-                s_memory_zones->back().m_data.resize(zone_size);
+                b_success = pool.allocate(zone_size, b_hugetlb, numa_node);
             }
+            if (!b_success)
+                std::cerr << "Error mapping memory pool \"" << zone << "\"" << std::endl;
+            else if (b_prefault)
+                pool.prefault();
+        }
 
-            std::stringstream out;
-            out << s_memory_zones->size() << " memory pools:" << std::endl;
-            for(const auto &pool : *s_memory_zones)
-                out << "    " << pool.size() << " bytes" << std::endl;
+        std::stringstream out;
+        out << memory_zones->size() << " memory pools:" << std::endl;
+        for(const auto &pool : *memory_zones)
+        {
+            out << "    " << pool.size() << " bytes";
+            if (pool.numa_node() >= 0)
+                out << " on NUMA node " << pool.numa_node();
+            if (!pool.path().empty())
+                out << " mapped from " << pool.path();
             out << std::endl;
-            const std::string &buf = out.str();
-            ignore() << write(0, buf.data(), buf.size());
         }
+        out << std::endl;
+        const std::string &buf = out.str();
+        ignore() << write(2, buf.data(), buf.size());
+        return memory_zones;
+    }
+
+    // Zones are created on first use (or by giga_initialize_device) instead of when the library is loaded, so that processes which
+    // never run inference do not pay for them. Initialization of a local static is thread safe.
+    std::vector<MemoryPool> &GetMemoryZoneCollection()
+    {
+        static std::vector<MemoryPool> * const s_memory_zones = CreateMemoryZoneCollection();
         return *s_memory_zones;
     }
+}
 
-    void on_init() __attribute__((constructor));
+void create_memory_zones()
+{
+    GetMemoryZoneCollection();
+}
 
-    void on_init()
+#ifdef ENABLE_OPTIMIZATION
+namespace
+{
+    // NUMA node a calling thread and its OpenMP team are bound to, with the affinity and the number of threads they had before
+    struct Thread_binding
     {
-        // Make sure this is allocated on load
-        GetMemoryZoneCollection();
+        Thread_binding() : numa_node(-1), nb_threads(omp_get_max_threads())
+        {
+            if (sched_getaffinity(0, sizeof(cpu_set_t), &default_cpus) != 0)
+                CPU_ZERO(&default_cpus);
+        }
+
+        int numa_node;
+        int nb_threads;
+        cpu_set_t default_cpus;
+    };
+}
+#endif
+
+void run_on_memory_zone_node(const GIGA_tensor_t *tensor)
+{
+#ifdef ENABLE_OPTIMIZATION
+    static thread_local Thread_binding s_binding;
+
+    const uint64_t zone_id = ((const Tensor_data_t*)tensor->data)->memory_zone_id;
+    const std::vector<MemoryPool> &memory_zones = GetMemoryZoneCollection();
+    if (zone_id == s_imported_zone_id || zone_id >= memory_zones.size())
+        return;
+
+    const MemoryPool &memory_pool = memory_zones[zone_id];
+    if (memory_pool.numa_node() == s_binding.numa_node)
+        return;
+
+    // CPUs of the node the threads are allowed to run on
+    std::vector<int> cpus;
+    if (memory_pool.numa_node() >= 0)
+    {
+        for (int cpu = 0 ; cpu < CPU_SETSIZE ; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &memory_pool.cpus()) && CPU_ISSET(cpu, &s_binding.default_cpus))
+                cpus.push_back(cpu);
+        }
+    }
+    s_binding.numa_node = memory_pool.numa_node();
+
+    // Zones without a node (or a node out of reach) give the threads back their number and affinity
+    if (cpus.empty())
+    {
+        omp_set_num_threads(s_binding.nb_threads);
+#pragma omp parallel
+        {
+            if (omp_get_thread_num() != 0)
+                sched_setaffinity(0, sizeof(cpu_set_t), &s_binding.default_cpus);
+        }
+        return;
+    }
+
+    // One thread per CPU of the node, the workers pinned to their CPU. The calling thread (thread 0 of the team) belongs to the application
+    // and keeps its affinity. Threads of the OpenMP team are kept by the runtime for the next parallel regions of the caller, so they only
+    // have to be bound once
+    omp_set_num_threads(int(cpus.size()));
+#pragma omp parallel
+    {
+        const int thread = omp_get_thread_num();
+        if (thread != 0)
+        {
+            cpu_set_t thread_cpus;
+            CPU_ZERO(&thread_cpus);
+            CPU_SET(cpus[thread % cpus.size()], &thread_cpus);
+            sched_setaffinity(0, sizeof(cpu_set_t), &thread_cpus);
+        }
     }
+#else
+    // The reference implementation runs on the calling thread, which is left where the application put it
+    (void)tensor;
+#endif
+}
+
+// Strides of a row major tensor with no holes
+static void set_row_major_strides(GIGA_tensor_t *tensor)
+{
+    tensor->strides[tensor->nb_dims - 1] = element_size_in_bits(tensor->type) / 8;
+    for(int32_t i = int32_t(tensor->nb_dims) - 2 ; i >= 0 ; --i)
+        tensor->strides[i] = tensor->strides[i + 1] * tensor->dims[i + 1];
 }
 
 GIGA_error giga_allocate_tensor_(GIGA_tensor_t *tensor, const GIGA_allocate_t *params, const char *file, int line)
@@ -125,24 +631,46 @@ GIGA_error giga_allocate_tensor_(GIGA_tensor_t *tensor, const GIGA_allocate_t *p
 
     MemoryPool &memory_pool = memory_zones[params->memory_zone_id];
 
-    const size_t element_size = element_size_in_bits(tensor->type) / 8;
+    const bool b_auto_offset = params->offset == GIGA_AUTO_OFFSET;
+    if (!b_auto_offset && params->offset % s_alignment != 0)
+        RETURN_ERROR(GIGA_Bad_Memory_Alignment);
 
-    // Row major
-    tensor->strides[tensor->nb_dims - 1] = element_size;
-    for(int32_t i = int32_t(tensor->nb_dims) - 2 ; i >= 0 ; --i)
-        tensor->strides[i] = tensor->strides[i + 1] * tensor->dims[i + 1];
+    set_row_major_strides(tensor);
 
     try
     {
-        tensor->data = new Tensor_data_t();
+        tensor->data = s_tensor_data_slab.allocate();
         Tensor_data_t * typed_data = (Tensor_data_t *)(tensor->data);
         const size_t buffer_size = tensor->strides[0] * tensor->dims[0];
+        // Ranges are rounded to the alignment so that all free ranges stay aligned
+        const size_t range_size = std::max((buffer_size + s_alignment - 1) & ~(s_alignment - 1), s_alignment);
 
-        if (params->offset + buffer_size > memory_pool.size())
-            RETURN_ERROR(GIGA_Out_Of_Device_Memory);
+        size_t offset = params->offset;
+        {
+            std::lock_guard<std::mutex> lock(s_allocation_mutex);
+            if (b_auto_offset)
+            {
+                if (!memory_pool.allocate_range(range_size, &offset))
+                {
+                    s_tensor_data_slab.release(typed_data);
+                    RETURN_ERROR(GIGA_Out_Of_Device_Memory);
+                }
+                typed_data->range_offset = offset;
+                typed_data->range_size = range_size;
+            }
+            else
+            {
+                if (offset + buffer_size > memory_pool.size())
+                {
+                    s_tensor_data_slab.release(typed_data);
+                    RETURN_ERROR(GIGA_Out_Of_Device_Memory);
+                }
+                memory_pool.reserve_range(offset, range_size);
+            }
+        }
 
         typed_data->data_ptr = memory_pool.ptr();
-        typed_data->data_start = (char*)typed_data->data_ptr + params->offset;
+        typed_data->data_start = (char*)typed_data->data_ptr + offset;
         typed_data->memory_zone_id = params->memory_zone_id;
         typed_data->is_allocated = true;
         typed_data->id = current_tensor_id++;
@@ -158,6 +686,53 @@ GIGA_error giga_allocate_tensor_(GIGA_tensor_t *tensor, const GIGA_allocate_t *p
     return GIGA_Success;
 }
 
+GIGA_error giga_import_tensor_(GIGA_tensor_t *tensor, void *user_ptr, const char *file, int line)
+{
+    if(tensor->nb_dims > 4 || tensor->nb_dims < 1) return GIGA_Inconsistent_Number_Of_Dimensions;
+
+    if (user_ptr == nullptr)
+        RETURN_ERROR(GIGA_Incorrect_Parameter);
+
+    const uint32_t element_size = element_size_in_bits(tensor->type) / 8;
+    if (element_size == 0)
+        RETURN_ERROR(GIGA_Unimplemented_Type);
+
+    bool b_default_strides = true;
+    for(uint32_t i = 0 ; i < tensor->nb_dims ; ++i)
+        b_default_strides &= tensor->strides[i] == 0;
+    if (b_default_strides)
+        set_row_major_strides(tensor);
+
+    // Operations read rows with a unit stride and index elements with strides divided by the element size
+    if (tensor->strides[tensor->nb_dims - 1] != element_size)
+        RETURN_ERROR(GIGA_Incorrect_Parameter);
+    if ((uintptr_t)user_ptr % element_size != 0)
+        RETURN_ERROR(GIGA_Bad_Memory_Alignment);
+    for(uint32_t i = 0 ; i < tensor->nb_dims ; ++i)
+    {
+        if (tensor->strides[i] % element_size != 0)
+            RETURN_ERROR(GIGA_Bad_Memory_Alignment);
+    }
+
+    try
+    {
+        tensor->data = s_tensor_data_slab.allocate();
+        Tensor_data_t * typed_data = (Tensor_data_t *)(tensor->data);
+        typed_data->data_ptr = user_ptr;
+        typed_data->data_start = user_ptr;
+        typed_data->memory_zone_id = s_imported_zone_id;
+        typed_data->is_allocated = true;
+        typed_data->id = current_tensor_id++;
+    }
+    catch(const std::bad_alloc &e)
+    {
+        std::cerr << e.what() << std::endl;
+        RETURN_ERROR(GIGA_Bad_Alloc);
+    }
+
+    return GIGA_Success;
+}
+
 GIGA_error giga_map_tensor_(GIGA_tensor_t *tensor, void **ptr, GIGA_memory_flag flags, const char *file, int line)
 {
     if (!check_tensor_exists(tensor))
@@ -195,26 +770,41 @@ GIGA_error giga_release_tensor_(GIGA_tensor_t *tensor, const char *file, int lin
     if(data_ptr->is_allocated == false)
         RETURN_ERROR(GIGA_Unknown_tensor);
 
+    // A tensor allocated at an automatic offset and its views share its range, which is released with the last of them
+    if (data_ptr->range_size > 0)
+    {
+        std::lock_guard<std::mutex> lock(s_allocation_mutex);
+        memory_zones[data_ptr->memory_zone_id].release_range(data_ptr->range_offset, data_ptr->range_size);
+    }
+
     if(data_ptr->view_of != 0)
     {
-        delete data_ptr;
+        s_tensor_data_slab.release(data_ptr);
         data_ptr = nullptr;
         return GIGA_Success;
     }
 
+    // The buffer of an imported tensor belongs to the user
     auto zone_id = data_ptr->memory_zone_id;
+    if (zone_id == s_imported_zone_id)
+    {
+        s_tensor_data_slab.release(data_ptr);
+        data_ptr = nullptr;
+        return GIGA_Success;
+    }
+
     if (zone_id >= memory_zones.size())
         RETURN_ERROR(GIGA_Unknown_tensor);
 
     if (memory_zones[zone_id].nb_tensors > 1)
     {
         --memory_zones[zone_id].nb_tensors;
-        delete data_ptr;
+        s_tensor_data_slab.release(data_ptr);
         data_ptr = nullptr;
         return GIGA_Success;
     }
 
-    delete data_ptr;
+    s_tensor_data_slab.release(data_ptr);
     data_ptr = nullptr;
     return GIGA_Success;
 }
@@ -254,16 +844,24 @@ GIGA_error giga_view_(const GIGA_view_t *params, const GIGA_tensor_t *in, GIGA_t
     if (in->nb_dims != out->nb_dims)    RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
 
     Tensor_data_t * data_in = (Tensor_data_t*)in->data;
-    out->data = new Tensor_data_t;
+    out->data = s_tensor_data_slab.allocate();
     Tensor_data_t * data_out = (Tensor_data_t*) out->data;
     data_out->id = current_tensor_id++;
     data_out->memory_zone_id = data_in->memory_zone_id;
 
-    auto & memory_zones = GetMemoryZoneCollection();
-    memory_zones[data_out->memory_zone_id].nb_tensors++;
+    if (data_out->memory_zone_id != s_imported_zone_id)
+        GetMemoryZoneCollection()[data_out->memory_zone_id].nb_tensors++;
 
     //TODO need more checks
 
+    if (data_in->range_size > 0)
+    {
+        std::lock_guard<std::mutex> lock(s_allocation_mutex);
+        GetMemoryZoneCollection()[data_in->memory_zone_id].use_range(data_in->range_offset);
+        data_out->range_offset = data_in->range_offset;
+        data_out->range_size = data_in->range_size;
+    }
+
     data_out->data_ptr = data_in->data_ptr;
     data_out->data_start = (uint8_t*)data_in->data_start;
     for(uint32_t dim = 0; dim < in->nb_dims; ++dim)
@@ -278,110 +876,257 @@ GIGA_error giga_view_(const GIGA_view_t *params, const GIGA_tensor_t *in, GIGA_t
     return GIGA_Success;
 }
 
+// Conversions between the user and tensor representations: f scales floating point values to fixed point values (and conversely) and fp_shift shifts
+// fixed point values. Fixed point results are rounded to the nearest value and saturated.
+
 // from float
 template<class T>   inline T cast_to(float x, int32_t fp_shift, float f);
 
-template<>  inline float    cast_to<   float>(float x, int32_t fp_shift, float f)   {   return x;       }
-template<>  inline half     cast_to<    half>(float x, int32_t fp_shift, float f)   {   return x;       }
-template<>  inline uint8_t  cast_to< uint8_t>(float x, int32_t fp_shift, float f)   {   return x * f;   }
-template<>  inline uint16_t cast_to<uint16_t>(float x, int32_t fp_shift, float f)   {   return x * f;   }
-template<>  inline int8_t   cast_to<  int8_t>(float x, int32_t fp_shift, float f)   {   return x * f;   }
-template<>  inline int16_t  cast_to< int16_t>(float x, int32_t fp_shift, float f)   {   return x * f;   }
+template<>  inline float    cast_to<   float>(float x, int32_t fp_shift, float f)   {   return x;                                                      }
+template<>  inline half     cast_to<    half>(float x, int32_t fp_shift, float f)   {   return x;                                                      }
+template<>  inline uint8_t  cast_to< uint8_t>(float x, int32_t fp_shift, float f)   {   return saturate_cast<uint8_t>(std::nearbyint(x * f));          }
+template<>  inline uint16_t cast_to<uint16_t>(float x, int32_t fp_shift, float f)   {   return saturate_cast<uint16_t>(std::nearbyint(x * f));         }
+template<>  inline int8_t   cast_to<  int8_t>(float x, int32_t fp_shift, float f)   {   return saturate_cast<int8_t>(std::nearbyint(x * f));           }
+template<>  inline int16_t  cast_to< int16_t>(float x, int32_t fp_shift, float f)   {   return saturate_cast<int16_t>(std::nearbyint(x * f));          }
 
 // from half
 template<class T>   inline T cast_to(half x, int32_t fp_shift, float f);
 
-template<>  inline float    cast_to<   float>(half x, int32_t fp_shift, float f)    {   return x;       }
-template<>  inline half     cast_to<    half>(half x, int32_t fp_shift, float f)    {   return x;       }
-template<>  inline uint8_t  cast_to< uint8_t>(half x, int32_t fp_shift, float f)    {   return x * f;   }
-template<>  inline uint16_t cast_to<uint16_t>(half x, int32_t fp_shift, float f)    {   return x * f;   }
-template<>  inline int8_t   cast_to<  int8_t>(half x, int32_t fp_shift, float f)    {   return x * f;   }
-template<>  inline int16_t  cast_to< int16_t>(half x, int32_t fp_shift, float f)    {   return x * f;   }
+template<>  inline float    cast_to<   float>(half x, int32_t fp_shift, float f)    {   return x;                                                      }
+template<>  inline half     cast_to<    half>(half x, int32_t fp_shift, float f)    {   return x;                                                      }
+template<>  inline uint8_t  cast_to< uint8_t>(half x, int32_t fp_shift, float f)    {   return saturate_cast<uint8_t>(std::nearbyint(x * f));          }
+template<>  inline uint16_t cast_to<uint16_t>(half x, int32_t fp_shift, float f)    {   return saturate_cast<uint16_t>(std::nearbyint(x * f));         }
+template<>  inline int8_t   cast_to<  int8_t>(half x, int32_t fp_shift, float f)    {   return saturate_cast<int8_t>(std::nearbyint(x * f));           }
+template<>  inline int16_t  cast_to< int16_t>(half x, int32_t fp_shift, float f)    {   return saturate_cast<int16_t>(std::nearbyint(x * f));          }
 
 // from uint8
 template<class T>   inline T cast_to(uint8_t x, int32_t fp_shift, float f);
 
-template<>  inline float    cast_to<   float>(uint8_t x, int32_t fp_shift, float f) {   return x * f;   }
-template<>  inline half     cast_to<    half>(uint8_t x, int32_t fp_shift, float f) {   return x * f;   }
-template<>  inline uint8_t  cast_to< uint8_t>(uint8_t x, int32_t fp_shift, float f) {   return shift<uint32_t>(x, fp_shift);    }
-template<>  inline uint16_t cast_to<uint16_t>(uint8_t x, int32_t fp_shift, float f) {   return shift<uint32_t>(x, fp_shift);    }
-template<>  inline int8_t   cast_to<  int8_t>(uint8_t x, int32_t fp_shift, float f) {   return shift< int32_t>(x, fp_shift);    }
-template<>  inline int16_t  cast_to< int16_t>(uint8_t x, int32_t fp_shift, float f) {   return shift< int32_t>(x, fp_shift);    }
+template<>  inline float    cast_to<   float>(uint8_t x, int32_t fp_shift, float f) {   return x * f;                                                  }
+template<>  inline half     cast_to<    half>(uint8_t x, int32_t fp_shift, float f) {   return x * f;                                                  }
+template<>  inline uint8_t  cast_to< uint8_t>(uint8_t x, int32_t fp_shift, float f) {   return saturate_cast<uint8_t>(shift<int32_t>(x, fp_shift));    }
+template<>  inline uint16_t cast_to<uint16_t>(uint8_t x, int32_t fp_shift, float f) {   return saturate_cast<uint16_t>(shift<int32_t>(x, fp_shift));   }
+template<>  inline int8_t   cast_to<  int8_t>(uint8_t x, int32_t fp_shift, float f) {   return saturate_cast<int8_t>(shift<int32_t>(x, fp_shift));     }
+template<>  inline int16_t  cast_to< int16_t>(uint8_t x, int32_t fp_shift, float f) {   return saturate_cast<int16_t>(shift<int32_t>(x, fp_shift));    }
 
 // from uint16
 template<class T>   inline T cast_to(uint16_t x, int32_t fp_shift, float f);
 
-template<>  inline float    cast_to<   float>(uint16_t x, int32_t fp_shift, float f)    {   return x * f;   }
-template<>  inline half     cast_to<    half>(uint16_t x, int32_t fp_shift, float f)    {   return x * f;   }
-template<>  inline uint8_t  cast_to< uint8_t>(uint16_t x, int32_t fp_shift, float f)    {   return shift<uint32_t>(x, fp_shift);    }
-template<>  inline uint16_t cast_to<uint16_t>(uint16_t x, int32_t fp_shift, float f)    {   return shift<uint32_t>(x, fp_shift);    }
-template<>  inline int8_t   cast_to<  int8_t>(uint16_t x, int32_t fp_shift, float f)    {   return shift<int32_t>(x, fp_shift);     }
-template<>  inline int16_t  cast_to< int16_t>(uint16_t x, int32_t fp_shift, float f)    {   return shift<int32_t>(x, fp_shift);     }
+template<>  inline float    cast_to<   float>(uint16_t x, int32_t fp_shift, float f)    {   return x * f;                                                  }
+template<>  inline half     cast_to<    half>(uint16_t x, int32_t fp_shift, float f)    {   return x * f;                                                  }
+template<>  inline uint8_t  cast_to< uint8_t>(uint16_t x, int32_t fp_shift, float f)    {   return saturate_cast<uint8_t>(shift<int32_t>(x, fp_shift));    }
+template<>  inline uint16_t cast_to<uint16_t>(uint16_t x, int32_t fp_shift, float f)    {   return saturate_cast<uint16_t>(shift<int32_t>(x, fp_shift));   }
+template<>  inline int8_t   cast_to<  int8_t>(uint16_t x, int32_t fp_shift, float f)    {   return saturate_cast<int8_t>(shift<int32_t>(x, fp_shift));     }
+template<>  inline int16_t  cast_to< int16_t>(uint16_t x, int32_t fp_shift, float f)    {   return saturate_cast<int16_t>(shift<int32_t>(x, fp_shift));    }
 
 // from int8
 template<class T>   inline T cast_to(int8_t x, int32_t fp_shift, float f);
 
-template<>  inline float    cast_to<   float>(int8_t x, int32_t fp_shift, float f)  {   return x * f;   }
-template<>  inline half     cast_to<    half>(int8_t x, int32_t fp_shift, float f)  {   return x * f;   }
-template<>  inline uint8_t  cast_to< uint8_t>(int8_t x, int32_t fp_shift, float f)  {   return shift<uint32_t>(x, fp_shift);    }
-template<>  inline uint16_t cast_to<uint16_t>(int8_t x, int32_t fp_shift, float f)  {   return shift<uint32_t>(x, fp_shift);    }
-template<>  inline int8_t   cast_to<  int8_t>(int8_t x, int32_t fp_shift, float f)  {   return shift<int32_t>(x, fp_shift);     }
-template<>  inline int16_t  cast_to< int16_t>(int8_t x, int32_t fp_shift, float f)  {   return shift<int32_t>(x, fp_shift);     }
+template<>  inline float    cast_to<   float>(int8_t x, int32_t fp_shift, float f)  {   return x * f;                                                  }
+template<>  inline half     cast_to<    half>(int8_t x, int32_t fp_shift, float f)  {   return x * f;                                                  }
+template<>  inline uint8_t  cast_to< uint8_t>(int8_t x, int32_t fp_shift, float f)  {   return saturate_cast<uint8_t>(shift<int32_t>(x, fp_shift));    }
+template<>  inline uint16_t cast_to<uint16_t>(int8_t x, int32_t fp_shift, float f)  {   return saturate_cast<uint16_t>(shift<int32_t>(x, fp_shift));   }
+template<>  inline int8_t   cast_to<  int8_t>(int8_t x, int32_t fp_shift, float f)  {   return saturate_cast<int8_t>(shift<int32_t>(x, fp_shift));     }
+template<>  inline int16_t  cast_to< int16_t>(int8_t x, int32_t fp_shift, float f)  {   return saturate_cast<int16_t>(shift<int32_t>(x, fp_shift));    }
 
 // from int16
 template<class T>   inline T cast_to(int16_t x, int32_t fp_shift, float f);
 
-template<>  inline float    cast_to<   float>(int16_t x, int32_t fp_shift, float f) {   return x * f;   }
-template<>  inline half     cast_to<    half>(int16_t x, int32_t fp_shift, float f) {   return x * f;   }
-template<>  inline uint8_t  cast_to< uint8_t>(int16_t x, int32_t fp_shift, float f) {   return shift<uint32_t>(x, fp_shift);    }
-template<>  inline uint16_t cast_to<uint16_t>(int16_t x, int32_t fp_shift, float f) {   return shift<uint32_t>(x, fp_shift);    }
-template<>  inline int8_t   cast_to<  int8_t>(int16_t x, int32_t fp_shift, float f) {   return shift<int32_t>(x, fp_shift);     }
-template<>  inline int16_t  cast_to< int16_t>(int16_t x, int32_t fp_shift, float f) {   return shift<int32_t>(x, fp_shift);     }
+template<>  inline float    cast_to<   float>(int16_t x, int32_t fp_shift, float f) {   return x * f;                                                  }
+template<>  inline half     cast_to<    half>(int16_t x, int32_t fp_shift, float f) {   return x * f;                                                  }
+template<>  inline uint8_t  cast_to< uint8_t>(int16_t x, int32_t fp_shift, float f) {   return saturate_cast<uint8_t>(shift<int32_t>(x, fp_shift));    }
+template<>  inline uint16_t cast_to<uint16_t>(int16_t x, int32_t fp_shift, float f) {   return saturate_cast<uint16_t>(shift<int32_t>(x, fp_shift));   }
+template<>  inline int8_t   cast_to<  int8_t>(int16_t x, int32_t fp_shift, float f) {   return saturate_cast<int8_t>(shift<int32_t>(x, fp_shift));     }
+template<>  inline int16_t  cast_to< int16_t>(int16_t x, int32_t fp_shift, float f) {   return saturate_cast<int16_t>(shift<int32_t>(x, fp_shift));    }
 
-GIGA_error giga_copy_to_tensor_(const void *user_ptr, GIGA_data_type source_type, uint32_t fp_shift, GIGA_tensor_t *tensor, const char *file, int line)
+#ifdef ENABLE_OPTIMIZATION
+#define CONVERSION_BLOCK_SIZE       size_t(1024)
+
+#ifdef __AVX2__
+// Scales, saturates then rounds to the nearest (even) value 8 floats, the saturated values being exactly representable in the target type
+inline __m256i scale_round_8(const float *src, __m256 f, __m256 lower, __m256 upper)
 {
-#define FALLTHROUGH
+    return _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src), f), lower), upper));
+}
 
-    GIGA_error error;
+// Converts floats to fixed point values with saturating packs, returns the number of values converted (the last ones are left to the caller)
+template<class D>
+inline size_t float_to_fixed_block(const float *src, D *dst, size_t n, float f)
+{
+    const __m256 vf = _mm256_set1_ps(f);
+    const __m256 lower = _mm256_set1_ps(float(std::numeric_limits<D>::min()));
+    const __m256 upper = _mm256_set1_ps(float(std::numeric_limits<D>::max()));
+    size_t i = 0;
+    if constexpr (sizeof(D) == 2)
+    {
+        for(; i + 16 <= n ; i += 16)
+        {
+            const __m256i a = scale_round_8(src + i, vf, lower, upper);
+            const __m256i b = scale_round_8(src + i + 8, vf, lower, upper);
+            // Packs work on 128 bits lanes, the permutation restores the order of values
+            const __m256i packed = std::is_signed<D>::value ? _mm256_packs_epi32(a, b) : _mm256_packus_epi32(a, b);
+            _mm256_storeu_si256((__m256i*)(dst + i), _mm256_permute4x64_epi64(packed, 0xD8));
+        }
+    }
+    else
+    {
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        for(; i + 32 <= n ; i += 32)
+        {
+            const __m256i ab = _mm256_packs_epi32(scale_round_8(src + i, vf, lower, upper), scale_round_8(src + i + 8, vf, lower, upper));
+            const __m256i cd = _mm256_packs_epi32(scale_round_8(src + i + 16, vf, lower, upper), scale_round_8(src + i + 24, vf, lower, upper));
+            const __m256i packed = std::is_signed<D>::value ? _mm256_packs_epi16(ab, cd) : _mm256_packus_epi16(ab, cd);
+            _mm256_storeu_si256((__m256i*)(dst + i), _mm256_permutevar8x32_epi32(packed, order));
+        }
+    }
+    return i;
+}
+#endif
+
+// Converts a block of values with loops that vectorize: half precision values go through a float buffer and fixed point shifts are
+// written as a multiplication and an arithmetic right shift
+template<class D, class S>
+inline void convert_block(D * __restrict__ dst, const S * __restrict__ src, size_t n, int32_t fp_shift, float f)
+{
+    if constexpr (std::is_integral<S>::value && std::is_integral<D>::value)
+    {
+        const Fixed_point_shift<int32_t> shift_value(fp_shift);
+        for(size_t i = 0 ; i < n ; ++i)
+            dst[i] = saturate_cast<D>(shift_value(int32_t(src[i])));
+    }
+    else if constexpr (std::is_same<S, half>::value && std::is_same<D, float>::value)
+        giga_float_from_half_n(dst, src, n);
+    else if constexpr (std::is_same<S, float>::value && std::is_same<D, half>::value)
+        giga_half_from_float_n(dst, src, n);
+    else if constexpr (std::is_same<S, half>::value)
+    {
+        float buffer[CONVERSION_BLOCK_SIZE];
+        giga_float_from_half_n(buffer, src, n);
+        convert_block(dst, buffer, n, fp_shift, f);
+    }
+    else if constexpr (std::is_same<D, half>::value)
+    {
+        float buffer[CONVERSION_BLOCK_SIZE];
+        convert_block(buffer, src, n, fp_shift, f);
+        giga_half_from_float_n(dst, buffer, n);
+    }
+    else
+    {
+        size_t i = 0;
+#ifdef __AVX2__
+        if constexpr (std::is_same<S, float>::value && std::is_integral<D>::value)
+            i = float_to_fixed_block(src, dst, n, f);
+#endif
+        for(; i < n ; ++i)
+            dst[i] = cast_to<D>(src[i], fp_shift, f);
+    }
+}
+#endif
+
+// Converts a run of n values, both runs being contiguous in the common case
+template<class D, class S>
+inline void convert_run(char *dst, const char *src, uint32_t n, int64_t dst_stride, int64_t src_stride, int32_t fp_shift, float f)
+{
+#ifdef ENABLE_OPTIMIZATION
+    if(dst_stride == int64_t(sizeof(D)) && src_stride == int64_t(sizeof(S)))
+    {
+        for(size_t first = 0 ; first < n ; first += CONVERSION_BLOCK_SIZE)
+            convert_block((D*)dst + first, (const S*)src + first, std::min(CONVERSION_BLOCK_SIZE, n - first), fp_shift, f);
+        return;
+    }
+#endif
+    for(uint32_t i = 0 ; i < n ; ++i)
+        *(D*)(dst + i * dst_stride) = cast_to<D>(*(const S*)(src + i * src_stride), fp_shift, f);
+}
+
+// Copies a run of n values of element_size bytes without conversion
+inline void copy_run(char *dst, const char *src, uint32_t n, int64_t dst_stride, int64_t src_stride, size_t element_size)
+{
+    if(dst_stride == int64_t(element_size) && src_stride == int64_t(element_size))
+    {
+        memcpy(dst, src, n * element_size);
+        return;
+    }
+    for(uint32_t i = 0 ; i < n ; ++i)
+        memcpy(dst + i * dst_stride, src + i * src_stride, element_size);
+}
+
+// Layout of a user buffer holding the values of tensor in row major order with no holes
+inline GIGA_tensor_t user_buffer_layout(const GIGA_tensor_t *tensor, GIGA_data_type type)
+{
+    GIGA_tensor_t user = *tensor;
+    user.type = type;
+    uint32_t stride = element_size_in_bits(type) / 8;
+    for(int32_t dim = int32_t(tensor->nb_dims) - 1 ; dim >= 0 ; --dim)
+    {
+        user.strides[dim] = stride;
+        stride *= tensor->dims[dim];
+    }
+    return user;
+}
+
+/* Walks the elements of dst and src (tensors with the same dimensions) and calls run(dst_ptr, src_ptr, n, dst_stride, src_stride)
+ * on runs of their innermost dimension. The optimized version relies on the elementwise engine: dimensions contiguous in both are
+ * merged so that a copy between contiguous layouts is a single run, the runs being cut in chunks split across threads.
+ */
+template<class Run>
+inline void copy_runs(char *dst_ptr, const GIGA_tensor_t *dst, const char *src_ptr, const GIGA_tensor_t *src, const Run &run)
+{
+#ifdef ENABLE_OPTIMIZATION
+    const GIGA_tensor_t * const tensors[2] = {dst, src};
+    const Elementwise_layout<2> layout(tensors);
+    char * const base[2] = {dst_ptr, (char*)src_ptr};
+    elementwise_run(layout, base, [&](const uint32_t n, char * const *ptrs, const int64_t *strides)
+    {
+        run(ptrs[0], ptrs[1], n, strides[0], strides[1]);
+    });
+#else
     uint32_t dims[4] = {1, 1, 1, 1};
-    uint32_t strides[4] = {0, 0, 0, 0};
-\
-    switch(tensor->nb_dims)
-    {
-    case 4:
-        dims[3] = tensor->dims[3];
-        strides[3] = tensor->strides[3];
-        FALLTHROUGH
-    case 3:
-        dims[2] = tensor->dims[2];
-        strides[2] = tensor->strides[2];
-        FALLTHROUGH
-    case 2:
-        dims[1] = tensor->dims[1];
-        strides[1] = tensor->strides[1];
-        FALLTHROUGH
-    case 1:
-        dims[0] = tensor->dims[0];
-        strides[0] = tensor->strides[0];
-        break;
+    int64_t dst_strides[4] = {0, 0, 0, 0};
+    int64_t src_strides[4] = {0, 0, 0, 0};
+    const uint32_t dim_offset = 4 - dst->nb_dims;
+    for(uint32_t i = 0 ; i < dst->nb_dims ; ++i)
+    {
+        dims[i + dim_offset] = dst->dims[i];
+        dst_strides[i + dim_offset] = dst->strides[i];
+        src_strides[i + dim_offset] = src->strides[i];
     }
 
+    for(uint32_t i0 = 0 ; i0 < dims[0] ; ++i0)
+        for(uint32_t i1 = 0 ; i1 < dims[1] ; ++i1)
+            for(uint32_t i2 = 0 ; i2 < dims[2] ; ++i2)
+                run(dst_ptr + i0 * dst_strides[0] + i1 * dst_strides[1] + i2 * dst_strides[2],
+                    src_ptr + i0 * src_strides[0] + i1 * src_strides[1] + i2 * src_strides[2],
+                    dims[3], dst_strides[3], src_strides[3]);
+#endif
+}
+
+GIGA_error giga_copy_to_tensor_(const void *user_ptr, GIGA_data_type source_type, uint32_t fp_shift, GIGA_tensor_t *tensor, const char *file, int line)
+{
+    // The tensor may be a view or have padded rows, its strides are honored
+    const GIGA_tensor_t user = user_buffer_layout(tensor, source_type);
+
     const bool b_tensor_is_float = tensor->type == GIGA_Float32 || tensor->type == GIGA_Float16;
 
     const auto &impl_for_types = [&](const auto *src, auto *dst)
     {
-        typedef typename std::remove_reference<decltype(*dst)>::type T;
+        typedef typename std::remove_const<typename std::remove_reference<decltype(*src)>::type>::type S;
+        typedef typename std::remove_reference<decltype(*dst)>::type D;
         const int delta_fp_shift = (b_tensor_is_float ? 0 : tensor->fp_shift) - int(fp_shift);
         const float f = b_tensor_is_float ? 1.f / (1 << -delta_fp_shift) : float(1 << delta_fp_shift);
-        const size_t tensor_size = dims[0] * dims[1] * dims[2] * dims[3];
-        for(size_t i = 0 ; i < tensor_size ; ++i)
-            dst[i] = cast_to<T>(src[i], delta_fp_shift, f);
+        copy_runs((char*)dst, tensor, (const char*)src, &user, [=](char *dst_run, const char *src_run, uint32_t n, int64_t dst_stride, int64_t src_stride)
+        {
+            convert_run<D, S>(dst_run, src_run, n, dst_stride, src_stride, delta_fp_shift, f);
+        });
     };
 
     if (source_type == tensor->type && fp_shift == tensor->fp_shift)    // Simple copy
     {
-        const size_t tensor_size = element_size_in_bits(tensor->type) / 8 * dims[0] * dims[1] * dims[2] * dims[3];
-        memcpy(get_ptr<uint8_t>(tensor), user_ptr, tensor_size);
+        const size_t element_size = element_size_in_bits(tensor->type) / 8;
+        copy_runs(get_ptr<char>(tensor), tensor, (const char*)user_ptr, &user, [=](char *dst_run, const char *src_run, uint32_t n, int64_t dst_stride, int64_t src_stride)
+        {
+            copy_run(dst_run, src_run, n, dst_stride, src_stride, element_size);
+        });
         return GIGA_Success;
     }
 
@@ -419,46 +1164,29 @@ GIGA_error giga_copy_to_tensor_(const void *user_ptr, GIGA_data_type source_type
 
 GIGA_error giga_copy_from_tensor_(void *user_ptr, GIGA_data_type target_type, uint32_t fp_shift, const GIGA_tensor_t *tensor, const char *file, int line)
 {
-    GIGA_error error;
-    uint32_t dims[4] = {1, 1, 1, 1};
-    uint32_t strides[4] = {0, 0, 0, 0};
-\
-    switch(tensor->nb_dims)
-    {
-    case 4:
-        dims[3] = tensor->dims[3];
-        strides[3] = tensor->strides[3];
-        FALLTHROUGH
-    case 3:
-        dims[2] = tensor->dims[2];
-        strides[2] = tensor->strides[2];
-        FALLTHROUGH
-    case 2:
-        dims[1] = tensor->dims[1];
-        strides[1] = tensor->strides[1];
-        FALLTHROUGH
-    case 1:
-        dims[0] = tensor->dims[0];
-        strides[0] = tensor->strides[0];
-        break;
-    }
+    const GIGA_tensor_t user = user_buffer_layout(tensor, target_type);
 
     const bool b_target_is_float = target_type == GIGA_Float32 || target_type == GIGA_Float16;
 
     const auto &impl_for_types = [&](auto *dst, const auto *src)
     {
-        typedef typename std::remove_reference<decltype(*dst)>::type T;
+        typedef typename std::remove_const<typename std::remove_reference<decltype(*src)>::type>::type S;
+        typedef typename std::remove_reference<decltype(*dst)>::type D;
         const int delta_fp_shift = (b_target_is_float ? 0 : int(fp_shift)) - int(tensor->fp_shift);
         const float f = b_target_is_float ? 1.f / (1 << -delta_fp_shift) : float(1 << delta_fp_shift);
-        const size_t tensor_size = dims[0] * dims[1] * dims[2] * dims[3];
-        for(size_t i = 0 ; i < tensor_size ; ++i)
-            dst[i] = cast_to<T>(src[i], delta_fp_shift, f);
+        copy_runs((char*)dst, &user, (const char*)src, tensor, [=](char *dst_run, const char *src_run, uint32_t n, int64_t dst_stride, int64_t src_stride)
+        {
+            convert_run<D, S>(dst_run, src_run, n, dst_stride, src_stride, delta_fp_shift, f);
+        });
     };
 
     if (target_type == tensor->type && fp_shift == tensor->fp_shift)    // Simple copy
     {
-        const size_t tensor_size = element_size_in_bits(tensor->type) / 8 * dims[0] * dims[1] * dims[2] * dims[3];
-        memcpy(user_ptr, get_cptr<uint8_t>(tensor), tensor_size);
+        const size_t element_size = element_size_in_bits(tensor->type) / 8;
+        copy_runs((char*)user_ptr, &user, get_cptr<char>(tensor), tensor, [=](char *dst_run, const char *src_run, uint32_t n, int64_t dst_stride, int64_t src_stride)
+        {
+            copy_run(dst_run, src_run, n, dst_stride, src_stride, element_size);
+        });
         return GIGA_Success;
     }
 
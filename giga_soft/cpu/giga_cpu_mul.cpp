@@ -0,0 +1,70 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \author Roland Brochard (roland.brochard@airbus.com)
+ * \date 15/01/2025
+ *
+ * Baseline CPU implementation of the GIGA API
+ *
+ */
+
+#include "giga_cpu.h"
+#include "utils.h"
+#include "giga_cpu_elementwise.h"
+#include <type_traits>
+
+template<GIGA_data_type a_GT, GIGA_data_type b_GT,  GIGA_data_type o_GT>
+GIGA_error _mul_impl(const GIGA_mul_t * params, const GIGA_tensor_t *a, const GIGA_tensor_t *b, GIGA_tensor_t *out)
+{
+    typedef typename GIGA_C_Type<a_GT>::CType a_T;
+    typedef typename GIGA_C_Type<b_GT>::CType b_T;
+    typedef typename GIGA_C_Type<o_GT>::CType o_T;
+
+    typedef typename GIGA_Compute_Type<o_GT>::CType c_T;
+
+    //Computation of shifts in the fixed-point case. The product has a shift of a_shift + b_shift, it is brought back to the output representation
+    const int out_shift = int(out->fp_shift) - (int(a->fp_shift) + int(b->fp_shift));
+
+    const GIGA_error error = check_binary_broadcast(a, b, out);
+    if(error != GIGA_Success)
+        RETURN_ERROR(error);
+
+#ifdef ENABLE_OPTIMIZATION
+    const auto mul = [=](auto zero)
+    {
+        typedef decltype(zero) v_T;
+        const Fixed_point_shift<v_T> product_shift(out_shift);
+
+        elementwise_binary_run<v_T, o_T, a_T, b_T>(a, b, out, [=](const v_T a_value, const v_T b_value)
+        {
+            return product_shift(a_value * b_value);
+        });
+    };
+    if(fixed_point_product_fits_32_bits<o_T>(out_shift))
+        mul(Fixed_point_sum_type<o_T, c_T>());
+    else
+        mul(c_T());
+#else
+    elementwise_binary_reference<c_T, o_T, a_T, b_T>(a, b, out, [=](const c_T a_value, const c_T b_value)
+    {
+        return shift(c_T(a_value * b_value), out_shift);
+    });
+#endif
+
+    return GIGA_Success;
+}
+
+GIGA_error giga_mul_(const GIGA_mul_t * params, const GIGA_tensor_t *a, const GIGA_tensor_t *b, GIGA_tensor_t *out, const char *file, int line)
+{
+    if (!check_tensor_exists(a) || !check_tensor_exists(b) || !check_tensor_exists(out))
+        RETURN_ERROR(GIGA_Unknown_tensor);
+
+    run_on_memory_zone_node(out);
+
+    GIGA_error ret;
+#ifdef ENABLE_OPTIMIZATION
+    GIGA_CALL_TEMPLATED_FUNC_ON_3_TENSORS_SAME_TYPE(_mul_impl, a->type, b->type, out->type, params, a, b, out)
+#else
+    GIGA_CALL_TEMPLATED_FUNC_ON_3_TENSORS(_mul_impl, a->type, b->type, out->type, params, a, b, out)
+#endif
+    RETURN_ERROR(ret);
+}
@@ -0,0 +1,186 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \author Roland Brochard (roland.brochard@airbus.com)
+ * \date 15/01/2025
+ *
+ * Baseline CPU implementation of the GIGA API
+ *
+ */
+
+#include "giga_cpu.h"
+#include "utils.h"
+
+/*
+ * Space to depth and depth to space move the same values between a "space" tensor (C, H * b, W * b) and a "depth" tensor (C * b^2, H, W):
+ * space[c][h * b + i][w * b + j] = depth[depth_channel(c, i, j)][h][w]
+ * Both operations are implemented by the same function, only the direction of the copy changes.
+ */
+template<GIGA_data_type i_GT>
+GIGA_error _pixel_shuffle_impl(uint32_t block_size, GIGA_depth_order order, bool b_to_depth, const GIGA_tensor_t *in, GIGA_tensor_t *out)
+{
+    typedef typename GIGA_C_Type<i_GT>::CType i_T;
+
+    if(block_size < 1)                                                  RETURN_ERROR(GIGA_Incorrect_Parameter);
+    if(order != GIGA_Depth_Channel_Major && order != GIGA_Depth_Block_Major) RETURN_ERROR(GIGA_Incorrect_Parameter);
+
+    //Values are only moved, they must keep the same representation
+    if(in->type != out->type || in->fp_shift != out->fp_shift)  RETURN_ERROR(GIGA_Inconsistent_Tensor_Types);
+    if(in->nb_dims != out->nb_dims)                             RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+    if(in->nb_dims != 3 && in->nb_dims != 4)                    RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+
+    const GIGA_tensor_t * const space = b_to_depth ? in : out;
+    const GIGA_tensor_t * const depth = b_to_depth ? out : in;
+
+    const uint32_t C_dim = in->nb_dims - 3;
+    const uint32_t H_dim = C_dim + 1;
+    const uint32_t W_dim = C_dim + 2;
+
+    const uint32_t nb_batch = in->nb_dims == 4 ? in->dims[0] : 1;
+    if(in->nb_dims == 4 && out->dims[0] != nb_batch)
+        RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+
+    const uint32_t nb_channels = space->dims[C_dim];
+    const uint32_t H = depth->dims[H_dim];
+    const uint32_t W = depth->dims[W_dim];
+    const uint32_t block_area = block_size * block_size;
+
+    //check dimensions
+    if(depth->dims[C_dim] != nb_channels * block_area)  RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    if(space->dims[H_dim] != H * block_size)            RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    if(space->dims[W_dim] != W * block_size)            RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+
+    const uint32_t space_stride_B = in->nb_dims == 4 ? space->strides[0] / sizeof(i_T) : 0;
+    const uint32_t space_stride_C = space->strides[C_dim] / sizeof(i_T);
+    const uint32_t space_stride_H = space->strides[H_dim] / sizeof(i_T);
+    const uint32_t space_stride_W = space->strides[W_dim] / sizeof(i_T);
+
+    const uint32_t depth_stride_B = in->nb_dims == 4 ? depth->strides[0] / sizeof(i_T) : 0;
+    const uint32_t depth_stride_C = depth->strides[C_dim] / sizeof(i_T);
+    const uint32_t depth_stride_H = depth->strides[H_dim] / sizeof(i_T);
+    const uint32_t depth_stride_W = depth->strides[W_dim] / sizeof(i_T);
+
+    //Distance between the depth channels of consecutive block pixels and of consecutive space channels
+    const uint32_t depth_channel_step_j = order == GIGA_Depth_Channel_Major ? 1 : nb_channels;
+    const uint32_t depth_channel_step_i = block_size * depth_channel_step_j;
+    const uint32_t depth_channel_step_c = order == GIGA_Depth_Channel_Major ? block_area : 1;
+
+    i_T * const space_ptr0 = b_to_depth ? const_cast<i_T*>(get_cptr<i_T>(in)) : get_ptr<i_T>(out);
+    i_T * const depth_ptr0 = b_to_depth ? get_ptr<i_T>(out) : const_cast<i_T*>(get_cptr<i_T>(in));
+
+#ifdef ENABLE_OPTIMIZATION
+    // Assume space_stride_W == 1
+    // Assume depth_stride_W == 1
+    //Each job moves one row of the space tensor to/from the block_size rows of the depth tensor it interleaves
+    const uint32_t nb_jobs = nb_batch * nb_channels * H * block_size;
+#pragma omp parallel for schedule(static)
+    for(uint32_t job = 0; job < nb_jobs; ++job)
+    {
+        const uint32_t i = job % block_size;
+        const uint32_t y = (job / block_size) % H;
+        const uint32_t channel = (job / (block_size * H)) % nb_channels;
+        const uint32_t batch = job / (block_size * H * nb_channels);
+
+        i_T * const space_row = space_ptr0 + batch * space_stride_B + channel * space_stride_C + (y * block_size + i) * space_stride_H;
+        i_T * const depth_row0 = depth_ptr0 + batch * depth_stride_B + (channel * depth_channel_step_c + i * depth_channel_step_i) * depth_stride_C
+                                 + y * depth_stride_H;
+
+        if(block_size == 2)
+        {
+            //Most common case (pixel shuffle x2, stride 2 stems): two streams (de)interleaved by contiguous loops
+            i_T * __restrict__ const s = space_row;
+            i_T * __restrict__ const d0 = depth_row0;
+            i_T * __restrict__ const d1 = depth_row0 + depth_channel_step_j * depth_stride_C;
+            if(b_to_depth)
+            {
+                for(uint32_t x = 0; x < W; ++x)
+                {
+                    d0[x] = s[2 * x];
+                    d1[x] = s[2 * x + 1];
+                }
+            }
+            else
+            {
+                for(uint32_t x = 0; x < W; ++x)
+                {
+                    s[2 * x] = d0[x];
+                    s[2 * x + 1] = d1[x];
+                }
+            }
+        }
+        else
+        {
+            for(uint32_t j = 0; j < block_size; ++j)
+            {
+                i_T * __restrict__ const s = space_row + j;
+                i_T * __restrict__ const d = depth_row0 + j * depth_channel_step_j * depth_stride_C;
+                if(b_to_depth)
+                {
+                    for(uint32_t x = 0; x < W; ++x)
+                        d[x] = s[x * block_size];
+                }
+                else
+                {
+                    for(uint32_t x = 0; x < W; ++x)
+                        s[x * block_size] = d[x];
+                }
+            }
+        }
+    }
+#else
+    for(uint32_t batch = 0; batch < nb_batch; ++batch)
+    {
+        for(uint32_t channel = 0; channel < nb_channels; ++channel)
+        {
+            for(uint32_t y = 0; y < H; ++y)
+            {
+                for(uint32_t i = 0; i < block_size; ++i)
+                {
+                    for(uint32_t x = 0; x < W; ++x)
+                    {
+                        for(uint32_t j = 0; j < block_size; ++j)
+                        {
+                            const uint32_t depth_channel = channel * depth_channel_step_c + i * depth_channel_step_i + j * depth_channel_step_j;
+                            i_T * const space_value = space_ptr0 + batch * space_stride_B + channel * space_stride_C
+                                                      + (y * block_size + i) * space_stride_H + (x * block_size + j) * space_stride_W;
+                            i_T * const depth_value = depth_ptr0 + batch * depth_stride_B + depth_channel * depth_stride_C
+                                                      + y * depth_stride_H + x * depth_stride_W;
+                            if(b_to_depth)
+                                *depth_value = *space_value;
+                            else
+                                *space_value = *depth_value;
+                        }
+                    }
+                }
+            }
+        }
+    }
+#endif
+
+    return GIGA_Success;
+}
+
+GIGA_error giga_space_to_depth_(const GIGA_space_to_depth_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line)
+{
+    if (!check_tensor_exists(in) || !check_tensor_exists(out))
+        RETURN_ERROR(GIGA_Unknown_tensor);
+
+    run_on_memory_zone_node(out);
+
+    GIGA_error ret;
+    GIGA_CALL_TEMPLATED_FUNC_ON_TENSOR(_pixel_shuffle_impl, in->type, params->block_size, params->order, true, in, out)
+
+    RETURN_ERROR(ret);
+}
+
+GIGA_error giga_depth_to_space_(const GIGA_depth_to_space_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line)
+{
+    if (!check_tensor_exists(in) || !check_tensor_exists(out))
+        RETURN_ERROR(GIGA_Unknown_tensor);
+
+    run_on_memory_zone_node(out);
+
+    GIGA_error ret;
+    GIGA_CALL_TEMPLATED_FUNC_ON_TENSOR(_pixel_shuffle_impl, in->type, params->block_size, params->order, false, in, out)
+
+    RETURN_ERROR(ret);
+}
@@ -0,0 +1,232 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \author Roland Brochard (roland.brochard@airbus.com)
+ * \date 15/01/2025
+ *
+ * Baseline CPU implementation of the GIGA API
+ *
+ */
+
+#include "giga_cpu.h"
+#include "utils.h"
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/*Compilation options to define the operational domain of the implementation*/
+#define MAX_POOL_KERNEL_SIZE 3
+#define MAX_POOL_STRIDE 2
+
+template<GIGA_data_type i_GT>
+GIGA_error _pool2d_impl(const GIGA_pool2d_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out)
+{
+    typedef typename GIGA_C_Type<i_GT>::CType i_T;
+
+    typedef typename GIGA_Compute_Type<i_GT>::CType c_T;
+    // Sums of fixed point values are accumulated in 64 bits so that the output shift never overflows
+    typedef typename std::conditional<std::is_integral<c_T>::value, int64_t, c_T>::type a_T;
+
+    const GIGA_pool_mode mode = params->mode;
+    if(mode != GIGA_Pool_Average && mode != GIGA_Pool_Max)  RETURN_ERROR(GIGA_Incorrect_Parameter);
+
+    const uint32_t kernel_y = params->kernel_size[0];
+    const uint32_t kernel_x = params->kernel_size[1];
+    const uint32_t stride_y = params->stride[0];
+    const uint32_t stride_x = params->stride[1];
+    if(kernel_y < 1 || kernel_y > MAX_POOL_KERNEL_SIZE)   RETURN_ERROR(GIGA_Incorrect_Parameter);
+    if(kernel_x < 1 || kernel_x > MAX_POOL_KERNEL_SIZE)   RETURN_ERROR(GIGA_Incorrect_Parameter);
+    if(stride_y < 1 || stride_y > MAX_POOL_STRIDE)        RETURN_ERROR(GIGA_Incorrect_Parameter);
+    if(stride_x < 1 || stride_x > MAX_POOL_STRIDE)        RETURN_ERROR(GIGA_Incorrect_Parameter);
+
+    //Padding must leave at least one input pixel in each window
+    for(uint32_t i = 0; i < 2; ++i)
+    {
+        if(params->padding[0][i] < 0 || uint32_t(params->padding[0][i]) >= kernel_y)  RETURN_ERROR(GIGA_Incorrect_Parameter);
+        if(params->padding[1][i] < 0 || uint32_t(params->padding[1][i]) >= kernel_x)  RETURN_ERROR(GIGA_Incorrect_Parameter);
+    }
+
+    if(in->type != out->type)       RETURN_ERROR(GIGA_Inconsistent_Tensor_Types);
+    if(in->nb_dims != out->nb_dims) RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+    if(in->nb_dims < 2)             RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+
+    //Batch and channel dimensions are left untouched
+    for(uint32_t i = 0; i + 2 < in->nb_dims; ++i)
+    {
+        if(in->dims[i] != out->dims[i])
+            RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    }
+
+    const uint32_t nb_batch = in->nb_dims == 4 ? in->dims[0] : 1;
+    const uint32_t nb_channels = in->nb_dims == 2 ? 1 : in->dims[in->nb_dims - 3];
+
+    //The width dimension always immediately follows the height dimension
+    const uint32_t H_dim = in->nb_dims - 2;
+    const uint32_t W_dim = H_dim + 1;
+
+    const uint32_t H = in->dims[H_dim];
+    const uint32_t W = in->dims[W_dim];
+    const int32_t padding_top = params->padding[0][0];
+    const int32_t padding_left = params->padding[1][0];
+
+    //check dimensions
+    if(out->dims[H_dim] != (H + params->padding[0][0] + params->padding[0][1] - kernel_y) / stride_y + 1)
+        RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    if(out->dims[W_dim] != (W + params->padding[1][0] + params->padding[1][1] - kernel_x) / stride_x + 1)
+        RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+
+    const uint32_t out_y_end = out->dims[H_dim];
+    const uint32_t out_x_end = out->dims[W_dim];
+
+    const uint32_t in_stride_B = in->nb_dims == 4 ? in->strides[0] / sizeof(i_T) : 0;
+    const uint32_t in_stride_C = in->nb_dims == 2 ? 0 : in->strides[in->nb_dims - 3] / sizeof(i_T);
+    const uint32_t in_stride_H = in->strides[H_dim] / sizeof(i_T);
+    const uint32_t in_stride_W = in->strides[W_dim] / sizeof(i_T);
+
+    const uint32_t out_stride_B = out->nb_dims == 4 ? out->strides[0] / sizeof(i_T) : 0;
+    const uint32_t out_stride_C = out->nb_dims == 2 ? 0 : out->strides[out->nb_dims - 3] / sizeof(i_T);
+    const uint32_t out_stride_H = out->strides[H_dim] / sizeof(i_T);
+    const uint32_t out_stride_W = out->strides[W_dim] / sizeof(i_T);
+
+    //Fixed point values are written in the representation of the output
+    const int out_shift = is_float(in->type) ? 0 : int(out->fp_shift) - int(in->fp_shift);
+    const bool b_average = mode == GIGA_Pool_Average;
+    const bool b_exclude_padding = params->b_exclude_padding;
+
+    const i_T * const in_ptr0 = get_cptr<i_T>(in);
+    i_T * const out_ptr0 = get_ptr<i_T>(out);
+
+#ifdef ENABLE_OPTIMIZATION
+    // Assume in_stride_W == 1
+    // Assume out_stride_W == 1
+    //Pooling is separable: the rows of a window are reduced into a padded row buffer with contiguous loops, then windows are reduced along W.
+    //Padding holds the neutral element of the reduction so that only the number of valid pixels depends on the position.
+    const uint32_t padded_W = padding_left + W + params->padding[1][1];
+    const a_T neutral = b_average ? a_T(0) : std::numeric_limits<a_T>::lowest();
+
+    std::vector<uint32_t> col_counts(out_x_end);
+    for(uint32_t out_x = 0; out_x < out_x_end; ++out_x)
+    {
+        const int32_t x0 = int32_t(out_x * stride_x) - padding_left;
+        col_counts[out_x] = std::min<int32_t>(x0 + kernel_x, W) - std::max<int32_t>(x0, 0);
+    }
+
+    const uint32_t nb_jobs = nb_batch * nb_channels * out_y_end;
+#pragma omp parallel
+    {
+        std::vector<a_T> row(padded_W, neutral);
+        a_T * const row_ptr = row.data() + padding_left;
+
+#pragma omp for schedule(static)
+        for(uint32_t job = 0; job < nb_jobs; ++job)
+        {
+            const uint32_t out_y = job % out_y_end;
+            const uint32_t channel = (job / out_y_end) % nb_channels;
+            const uint32_t batch = job / (out_y_end * nb_channels);
+            const i_T * const in_ptr1 = in_ptr0 + batch * in_stride_B + channel * in_stride_C;
+
+            const int32_t y0 = int32_t(out_y * stride_y) - padding_top;
+            const uint32_t y_begin = std::max<int32_t>(y0, 0);
+            const uint32_t y_end = std::min<int32_t>(y0 + kernel_y, H);
+
+            const i_T * in_ptr2 = in_ptr1 + y_begin * in_stride_H;
+            for(uint32_t x = 0; x < W; ++x)
+                row_ptr[x] = a_T(in_ptr2[x]);
+            for(uint32_t y = y_begin + 1; y < y_end; ++y)
+            {
+                in_ptr2 = in_ptr1 + y * in_stride_H;
+                if(b_average)
+                {
+                    for(uint32_t x = 0; x < W; ++x)
+                        row_ptr[x] += a_T(in_ptr2[x]);
+                }
+                else
+                {
+                    for(uint32_t x = 0; x < W; ++x)
+                        row_ptr[x] = std::max(row_ptr[x], a_T(in_ptr2[x]));
+                }
+            }
+
+            i_T * const out_ptr1 = out_ptr0 + batch * out_stride_B + channel * out_stride_C + out_y * out_stride_H;
+            const a_T * const window_ptr = row.data();
+            if(b_average)
+            {
+                const uint32_t nb_rows = b_exclude_padding ? y_end - y_begin : kernel_y;
+                for(uint32_t out_x = 0; out_x < out_x_end; ++out_x)
+                {
+                    const a_T * const w = window_ptr + out_x * stride_x;
+                    a_T sum = w[0];
+                    for(uint32_t k = 1; k < kernel_x; ++k)
+                        sum += w[k];
+                    const uint32_t count = nb_rows * (b_exclude_padding ? col_counts[out_x] : kernel_x);
+                    out_ptr1[out_x] = pool_average<i_T, a_T>(sum, count, out_shift);
+                }
+            }
+            else
+            {
+                for(uint32_t out_x = 0; out_x < out_x_end; ++out_x)
+                {
+                    const a_T * const w = window_ptr + out_x * stride_x;
+                    a_T max = w[0];
+                    for(uint32_t k = 1; k < kernel_x; ++k)
+                        max = std::max(max, w[k]);
+                    out_ptr1[out_x] = pool_max<i_T, a_T>(max, out_shift);
+                }
+            }
+        }
+    }
+#else
+    for(uint32_t batch = 0; batch < nb_batch; ++batch)
+    {
+        for(uint32_t channel = 0; channel < nb_channels; ++channel)
+        {
+            for(uint32_t out_y = 0; out_y < out_y_end; ++out_y)
+            {
+                for(uint32_t out_x = 0; out_x < out_x_end; ++out_x)
+                {
+                    a_T acc = b_average ? a_T(0) : std::numeric_limits<a_T>::lowest();
+                    uint32_t count = 0;
+                    for(uint32_t ker_y = 0; ker_y < kernel_y; ++ker_y)
+                    {
+                        const uint32_t in_y = out_y * stride_y - padding_top + ker_y;
+                        if(in_y >= H)
+                            continue;
+                        for(uint32_t ker_x = 0; ker_x < kernel_x; ++ker_x)
+                        {
+                            /*Boundary checking */
+                            const uint32_t in_x = out_x * stride_x - padding_left + ker_x;
+                            if(in_x >= W)
+                                continue;
+
+                            const a_T value = a_T(in_ptr0[batch * in_stride_B + channel * in_stride_C + in_y * in_stride_H + in_x * in_stride_W]);
+                            acc = b_average ? acc + value : std::max(acc, value);
+                            ++count;
+                        }
+                    }
+
+                    i_T * const out_ptr = out_ptr0 + batch * out_stride_B + channel * out_stride_C + out_y * out_stride_H + out_x * out_stride_W;
+                    if(b_average)
+                        *out_ptr = pool_average<i_T, a_T>(acc, b_exclude_padding ? count : kernel_y * kernel_x, out_shift);
+                    else
+                        *out_ptr = pool_max<i_T, a_T>(acc, out_shift);
+                }
+            }
+        }
+    }
+#endif
+
+    return GIGA_Success;
+}
+
+GIGA_error giga_pool2d_(const GIGA_pool2d_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line)
+{
+    if (!check_tensor_exists(in) || !check_tensor_exists(out))
+        RETURN_ERROR(GIGA_Unknown_tensor);
+
+    run_on_memory_zone_node(out);
+
+    GIGA_error ret;
+    GIGA_CALL_TEMPLATED_FUNC_ON_TENSOR(_pool2d_impl, in->type, params, in, out)
+
+    RETURN_ERROR(ret);
+}
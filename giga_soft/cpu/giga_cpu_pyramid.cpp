@@ -0,0 +1,296 @@
+/*!
+ * (C) 2025 Airbus copyright all rights reserved
+ * \author Roland Brochard (roland.brochard@airbus.com)
+ * \date 15/01/2025
+ *
+ * Baseline CPU implementation of the GIGA API
+ *
+ */
+
+#include "giga_cpu.h"
+#include "utils.h"
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+//Taps of the separable filters, the window of the output pixel x starts at the input pixel 2 * x + filter_begin
+static const uint32_t filter_size[2] = {2, 5};
+static const int32_t filter_begin[2] = {0, -2};
+static const uint32_t filter_taps[2][5] = {{1, 1, 0, 0, 0}, {1, 4, 6, 4, 1}};
+static const uint32_t filter_norm[2] = {4, 256};
+static const int filter_norm_shift[2] = {2, 8};
+
+template<typename i_T>
+struct Pyramid_level
+{
+    const i_T *ptr;
+    uint32_t H;
+    uint32_t W;
+    uint32_t stride_B;
+    uint32_t stride_C;
+    uint32_t stride_H;
+    uint32_t stride_W;
+    int fp_shift;
+};
+
+#ifdef ENABLE_OPTIMIZATION
+//Same as pool_average() for a power of 2 norm: written as a multiplication and a rounded arithmetic right shift so that loops using it vectorize
+template<typename i_T, typename a_T>
+struct Pyramid_normalize
+{
+    inline Pyramid_normalize(int norm_shift, int out_shift)
+        : mul(out_shift > norm_shift ? a_T(1) << (out_shift - norm_shift) : a_T(1)),
+          rshift(norm_shift > out_shift ? norm_shift - out_shift : 0),
+          half(rshift > 0 ? a_T(1) << (rshift - 1) : a_T(0))  {}
+
+    inline i_T operator()(a_T sum) const
+    {
+        //Round half away from zero
+        const a_T value = sum * mul;
+        const a_T q = ((value >= 0 ? value : -value) + half) >> rshift;
+        return saturate_cast<i_T>(value >= 0 ? q : -q);
+    }
+
+    a_T mul;
+    int rshift;
+    a_T half;
+};
+
+template<>
+struct Pyramid_normalize<float, float>
+{
+    inline Pyramid_normalize(int norm_shift, int out_shift) : scale(1.f / float(1 << norm_shift))  {}
+
+    inline float operator()(float sum) const
+    {
+        return sum * scale;
+    }
+
+    float scale;
+};
+
+template<>
+struct Pyramid_normalize<half, float>
+{
+    inline Pyramid_normalize(int norm_shift, int out_shift) : scale(1.f / float(1 << norm_shift))  {}
+
+    inline half operator()(float sum) const
+    {
+        return half(sum * scale);
+    }
+
+    float scale;
+};
+
+//Computes the output row y from the source plane: rows are filtered along H into the padded buffer v with contiguous loops, then along W.
+//even and odd are buffers of dst_W + 2 elements starting at index -1.
+template<typename i_T, typename v_T, typename a_T>
+void _pyramid_row(const uint32_t filter, const i_T * const src, const uint32_t src_stride_H, const uint32_t src_H, const uint32_t src_W,
+                  const uint32_t y, i_T * const dst, const uint32_t dst_W, const int out_shift, v_T * const v, v_T * const even, v_T * const odd)
+{
+    const i_T *s[5];
+    for(uint32_t k = 0; k < filter_size[filter]; ++k)
+    {
+        const int32_t src_y = std::min(std::max(int32_t(2 * y) + filter_begin[filter] + int32_t(k), 0), int32_t(src_H) - 1);
+        s[k] = src + src_y * src_stride_H;
+    }
+
+    if(filter == GIGA_Pyramid_Box)
+    {
+        for(uint32_t x = 0; x < src_W; ++x)
+            v[x] = v_T(s[0][x]) + v_T(s[1][x]);
+    }
+    else
+    {
+        for(uint32_t x = 0; x < src_W; ++x)
+            v[x] = v_T(s[0][x]) + v_T(4) * v_T(s[1][x]) + v_T(6) * v_T(s[2][x]) + v_T(4) * v_T(s[3][x]) + v_T(s[4][x]);
+    }
+    //Border pixels are replicated
+    v[-2] = v[-1] = v[0];
+    v[src_W] = v[src_W + 1] = v[src_W - 1];
+
+    //The filtered row is split into its even and odd columns so that windows are read with a unit stride
+    for(int32_t x = -1; x < int32_t(dst_W); ++x)
+    {
+        even[x] = v[2 * x];
+        odd[x] = v[2 * x + 1];
+    }
+    even[dst_W] = v[2 * dst_W];
+
+    const Pyramid_normalize<i_T, a_T> normalize(filter_norm_shift[filter], out_shift);
+    if(filter == GIGA_Pyramid_Box)
+    {
+        for(uint32_t x = 0; x < dst_W; ++x)
+            dst[x] = normalize(a_T(even[x] + odd[x]));
+    }
+    else
+    {
+        const v_T * const even_prev = even - 1;
+        const v_T * const odd_prev = odd - 1;
+        const v_T * const even_next = even + 1;
+        for(uint32_t x = 0; x < dst_W; ++x)
+            dst[x] = normalize(a_T(even_prev[x] + v_T(4) * odd_prev[x] + v_T(6) * even[x] + v_T(4) * odd[x] + even_next[x]));
+    }
+}
+#endif
+
+template<GIGA_data_type i_GT>
+GIGA_error _pyramid_impl(const GIGA_pyramid_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out)
+{
+    typedef typename GIGA_C_Type<i_GT>::CType i_T;
+
+    typedef typename GIGA_Compute_Type<i_GT>::CType c_T;
+    // Sums of fixed point values are accumulated in 64 bits so that the output shift never overflows
+    typedef typename std::conditional<std::is_integral<c_T>::value, int64_t, c_T>::type a_T;
+
+    const uint32_t filter = params->filter;
+    if(filter != GIGA_Pyramid_Box && filter != GIGA_Pyramid_Gaussian)  RETURN_ERROR(GIGA_Incorrect_Parameter);
+
+    const uint32_t nb_levels = params->nb_levels;
+    if(nb_levels < 1)           RETURN_ERROR(GIGA_Incorrect_Parameter);
+    if(in->nb_dims < 2)         RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+
+    //The width dimension always immediately follows the height dimension
+    const uint32_t H_dim = in->nb_dims - 2;
+    const uint32_t W_dim = H_dim + 1;
+
+    const uint32_t nb_batch = in->nb_dims == 4 ? in->dims[0] : 1;
+    const uint32_t nb_channels = in->nb_dims == 2 ? 1 : in->dims[in->nb_dims - 3];
+
+    //Level 0 is the input, level i is out[i - 1]
+    std::vector<Pyramid_level<i_T> > levels(nb_levels + 1);
+    for(uint32_t level = 0; level <= nb_levels; ++level)
+    {
+        const GIGA_tensor_t * const t = level == 0 ? in : out + level - 1;
+        if(level > 0)
+        {
+            if(!check_tensor_exists(t))         RETURN_ERROR(GIGA_Unknown_tensor);
+            if(t->type != in->type)             RETURN_ERROR(GIGA_Inconsistent_Tensor_Types);
+            if(t->nb_dims != in->nb_dims)       RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+
+            //Batch and channel dimensions are left untouched
+            for(uint32_t i = 0; i < H_dim; ++i)
+            {
+                if(t->dims[i] != in->dims[i])
+                    RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+            }
+            if(t->dims[H_dim] != (levels[level - 1].H + 1) / 2) RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+            if(t->dims[W_dim] != (levels[level - 1].W + 1) / 2) RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+        }
+
+        Pyramid_level<i_T> &l = levels[level];
+        l.ptr = get_cptr<i_T>(t);
+        l.H = t->dims[H_dim];
+        l.W = t->dims[W_dim];
+        l.stride_B = in->nb_dims == 4 ? t->strides[0] / sizeof(i_T) : 0;
+        l.stride_C = in->nb_dims == 2 ? 0 : t->strides[in->nb_dims - 3] / sizeof(i_T);
+        l.stride_H = t->strides[H_dim] / sizeof(i_T);
+        l.stride_W = t->strides[W_dim] / sizeof(i_T);
+        //Fixed point values are written in the representation of each level
+        l.fp_shift = is_float(in->type) ? 0 : int(t->fp_shift);
+    }
+
+#ifdef ENABLE_OPTIMIZATION
+    // Assume stride_W == 1 for all levels
+    //Levels are built in one streaming pass per channel: as soon as a row of a level is written, all the rows of the next levels
+    //it completes are computed while it is still in cache, instead of reading back each level from memory.
+    //Rows are filtered in 32 bits so that loops vectorize, the largest sum being 256 times the largest 16 bits value.
+    typedef typename std::conditional<std::is_integral<c_T>::value, int32_t, c_T>::type v_T;
+
+    const uint32_t last_tap = filter_begin[filter] + filter_size[filter] - 1;
+    const uint32_t nb_jobs = nb_batch * nb_channels;
+#pragma omp parallel
+    {
+        //Filtered rows with two replicated pixels on each side
+        std::vector<v_T> row(levels[0].W + 4);
+        v_T * const row_ptr = row.data() + 2;
+        std::vector<v_T> even(levels[1].W + 2);
+        std::vector<v_T> odd(levels[1].W + 2);
+        std::vector<const i_T*> planes(nb_levels + 1);
+        std::vector<uint32_t> nb_rows(nb_levels + 1);
+
+#pragma omp for schedule(static)
+        for(uint32_t job = 0; job < nb_jobs; ++job)
+        {
+            const uint32_t channel = job % nb_channels;
+            const uint32_t batch = job / nb_channels;
+            for(uint32_t level = 0; level <= nb_levels; ++level)
+            {
+                planes[level] = levels[level].ptr + batch * levels[level].stride_B + channel * levels[level].stride_C;
+                nb_rows[level] = 0;
+            }
+            nb_rows[0] = levels[0].H;
+
+            for(uint32_t y = 0; y < levels[1].H; ++y)
+            {
+                for(uint32_t level = 1; level <= nb_levels; ++level)
+                {
+                    const Pyramid_level<i_T> &src = levels[level - 1];
+                    const Pyramid_level<i_T> &dst = levels[level];
+                    //Compute all the rows whose window is available in the previous level
+                    while(nb_rows[level] < dst.H && std::min(2 * nb_rows[level] + last_tap, src.H - 1) < nb_rows[level - 1])
+                    {
+                        i_T * const dst_row = const_cast<i_T*>(planes[level]) + nb_rows[level] * dst.stride_H;
+                        _pyramid_row<i_T, v_T, a_T>(filter, planes[level - 1], src.stride_H, src.H, src.W,
+                                                    nb_rows[level], dst_row, dst.W, dst.fp_shift - src.fp_shift,
+                                                    row_ptr, even.data() + 1, odd.data() + 1);
+                        ++nb_rows[level];
+                        //The first level produces one row at a time so that the next levels follow it
+                        if(level == 1)
+                            break;
+                    }
+                }
+            }
+        }
+    }
+#else
+    for(uint32_t level = 1; level <= nb_levels; ++level)
+    {
+        const Pyramid_level<i_T> &src = levels[level - 1];
+        const Pyramid_level<i_T> &dst = levels[level];
+        const int out_shift = dst.fp_shift - src.fp_shift;
+        for(uint32_t batch = 0; batch < nb_batch; ++batch)
+        {
+            for(uint32_t channel = 0; channel < nb_channels; ++channel)
+            {
+                for(uint32_t y = 0; y < dst.H; ++y)
+                {
+                    for(uint32_t x = 0; x < dst.W; ++x)
+                    {
+                        a_T acc = a_T(0);
+                        for(uint32_t ker_y = 0; ker_y < filter_size[filter]; ++ker_y)
+                        {
+                            //Border pixels are replicated
+                            const int32_t src_y = std::min(std::max(int32_t(2 * y) + filter_begin[filter] + int32_t(ker_y), 0), int32_t(src.H) - 1);
+                            for(uint32_t ker_x = 0; ker_x < filter_size[filter]; ++ker_x)
+                            {
+                                const int32_t src_x = std::min(std::max(int32_t(2 * x) + filter_begin[filter] + int32_t(ker_x), 0), int32_t(src.W) - 1);
+                                const a_T value = a_T(src.ptr[batch * src.stride_B + channel * src.stride_C + src_y * src.stride_H + src_x * src.stride_W]);
+                                acc += a_T(filter_taps[filter][ker_y] * filter_taps[filter][ker_x]) * value;
+                            }
+                        }
+
+                        i_T * const out_ptr = const_cast<i_T*>(dst.ptr) + batch * dst.stride_B + channel * dst.stride_C + y * dst.stride_H + x * dst.stride_W;
+                        *out_ptr = pool_average<i_T, a_T>(acc, filter_norm[filter], out_shift);
+                    }
+                }
+            }
+        }
+    }
+#endif
+
+    return GIGA_Success;
+}
+
+GIGA_error giga_pyramid_(const GIGA_pyramid_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out, const char *file, int line)
+{
+    if (!check_tensor_exists(in) || out == NULL)
+        RETURN_ERROR(GIGA_Unknown_tensor);
+
+    run_on_memory_zone_node(out);
+
+    GIGA_error ret;
+    GIGA_CALL_TEMPLATED_FUNC_ON_TENSOR(_pyramid_impl, in->type, params, in, out)
+
+    RETURN_ERROR(ret);
+}
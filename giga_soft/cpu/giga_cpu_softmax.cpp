@@ -11,8 +11,186 @@
 #include "utils.h"
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
+/*Compilation options to define the operational domain of the implementation*/
+#define SOFTMAX_TILE_SIZE 128   // Number of pixels processed together when softmaxing along the channel dimension
+#define SOFTMAX_MAX_FP_SHIFT 15 // Largest input fp_shift supported by the fixed point path (one exp table per shift)
+
+/* Exponential lookup tables for the fixed point softmax.
+ * The input is always processed as d = max - x >= 0 (in input units, at most 16 bits), exp(-d / 2^fp_shift) is then
+ * the product of the high byte and low byte tables. Values are stored in Q16 so exp(0) = 65536.
+ */
+struct Softmax_exp_table
+{
+    uint32_t lo[256];   // exp(-d / 2^fp_shift) for d in [0, 255]
+    uint32_t hi[256];   // exp(-256 * d / 2^fp_shift) for d in [0, 255]
+
+    template<typename i_T>
+    inline uint32_t exp(uint32_t d) const
+    {
+        // 8 bits inputs never need the high byte table
+        if (sizeof(i_T) == 1)
+            return lo[d];
+        return uint32_t((uint64_t(hi[d >> 8]) * lo[d & 0xFFU] + 0x8000U) >> 16);
+    }
+};
+
+static const Softmax_exp_table &get_softmax_exp_table(uint32_t fp_shift)
+{
+    // Built once for all shifts, function local statics are initialized in a thread safe way
+    static const std::array<Softmax_exp_table, SOFTMAX_MAX_FP_SHIFT + 1> tables = []()
+    {
+        std::array<Softmax_exp_table, SOFTMAX_MAX_FP_SHIFT + 1> tables;
+        for(uint32_t s = 0; s <= SOFTMAX_MAX_FP_SHIFT; ++s)
+        {
+            const double scale = 1.0 / double(1U << s);
+            for(uint32_t d = 0; d < 256; ++d)
+            {
+                tables[s].lo[d] = uint32_t(std::lround(std::exp(-double(d) * scale) * 65536.0));
+                tables[s].hi[d] = uint32_t(std::lround(std::exp(-double(d * 256) * scale) * 65536.0));
+            }
+        }
+        return tables;
+    }();
+    return tables[fp_shift];
+}
+
+/* Softmax for fixed point input and output tensors, without leaving the integer domain.
+ * Exponentials come from the lookup tables, normalization is done with a 48 bits reciprocal of the sum.
+ */
+template<GIGA_data_type i_GT, GIGA_data_type o_GT>
+GIGA_error _softmax_fixed_impl(const GIGA_tensor_t *in, GIGA_tensor_t *out)
+{
+    typedef typename GIGA_C_Type<i_GT>::CType i_T;
+    typedef typename GIGA_C_Type<o_GT>::CType o_T;
+
+    if(in->fp_shift > SOFTMAX_MAX_FP_SHIFT)    RETURN_ERROR(GIGA_Incorrect_Parameter);
+    if(out->fp_shift > 16)                      RETURN_ERROR(GIGA_Incorrect_Parameter);
+
+    const Softmax_exp_table &exp_table = get_softmax_exp_table(in->fp_shift);
+    const uint32_t norm_shift = 48 - out->fp_shift;
+    const uint64_t norm_round = uint64_t(1) << (norm_shift - 1);
+    const uint64_t o_max = uint64_t(std::numeric_limits<o_T>::max());
+
+    //Everything is seen as a NCHW tensor, missing dimensions are of size 1
+    const uint32_t C_dim = in->nb_dims == 1 ? 0 : 1;
+    const uint32_t H_dim = in->nb_dims == 4 ? 2 : C_dim;
+    const uint32_t W_dim = in->nb_dims >= 3 ? in->nb_dims - 1 : C_dim;
+    const uint32_t batch_end = in->nb_dims == 1 ? 1 : in->dims[0];
+    const uint32_t nb_channels = in->dims[C_dim];
+    const uint32_t y_end = in->nb_dims == 4 ? in->dims[H_dim] : 1;
+    const uint32_t x_end = in->nb_dims >= 3 ? in->dims[W_dim] : 1;
+
+    const uint32_t in_stride_B = in->nb_dims == 1 ? 0 : in->strides[0] / sizeof(i_T);
+    const uint32_t in_stride_C = in->strides[C_dim] / sizeof(i_T);
+    const uint32_t in_stride_H = in->strides[H_dim] / sizeof(i_T);
+    const uint32_t in_stride_W = in->strides[W_dim] / sizeof(i_T);
+    const uint32_t out_stride_B = out->nb_dims == 1 ? 0 : out->strides[0] / sizeof(o_T);
+    const uint32_t out_stride_C = out->strides[C_dim] / sizeof(o_T);
+    const uint32_t out_stride_H = out->strides[H_dim] / sizeof(o_T);
+    const uint32_t out_stride_W = out->strides[W_dim] / sizeof(o_T);
+
+    const i_T * const in_ptr0 = get_cptr<i_T>(in);
+    o_T * const out_ptr0 = get_ptr<o_T>(out);
+
+#ifdef ENABLE_OPTIMIZATION
+    // Assume in_stride_W == 1
+    // Assume out_stride_W == 1
+    const uint32_t nb_tiles = (x_end + SOFTMAX_TILE_SIZE - 1) / SOFTMAX_TILE_SIZE;
+    const uint32_t nb_jobs = batch_end * y_end * nb_tiles;
+#pragma omp parallel
+    {
+        std::vector<uint32_t> accs(SOFTMAX_TILE_SIZE * nb_channels);
+        int32_t max_values[SOFTMAX_TILE_SIZE];
+        uint64_t recips[SOFTMAX_TILE_SIZE];
+
+#pragma omp for schedule(static)
+        for(uint32_t job = 0; job < nb_jobs; ++job)
+        {
+            const uint32_t tile = job % nb_tiles;
+            const uint32_t y = (job / nb_tiles) % y_end;
+            const uint32_t batch = job / (nb_tiles * y_end);
+            const uint32_t x_begin = tile * SOFTMAX_TILE_SIZE;
+            const uint32_t tile_size = std::min<uint32_t>(SOFTMAX_TILE_SIZE, x_end - x_begin);
+            const i_T * const in_ptr1 = in_ptr0 + batch * in_stride_B + y * in_stride_H + x_begin;
+            o_T * const out_ptr1 = out_ptr0 + batch * out_stride_B + y * out_stride_H + x_begin;
+
+            //Find the maximum element, it is also what keeps exp arguments in the table range
+            for(uint32_t i = 0; i < tile_size; ++i)
+                max_values[i] = in_ptr1[i];
+            for(uint32_t c = 1; c < nb_channels; ++c)
+            {
+                const i_T * const in_ptr2 = in_ptr1 + c * in_stride_C;
+                for(uint32_t i = 0; i < tile_size; ++i)
+                    max_values[i] = std::max<int32_t>(max_values[i], in_ptr2[i]);
+            }
+
+            for(uint32_t i = 0; i < tile_size; ++i)
+                recips[i] = 0;
+            for(uint32_t c = 0; c < nb_channels; ++c)
+            {
+                const i_T * const in_ptr2 = in_ptr1 + c * in_stride_C;
+                uint32_t * const acc_ptr = accs.data() + c * SOFTMAX_TILE_SIZE;
+                for(uint32_t i = 0; i < tile_size; ++i)
+                {
+                    const uint32_t value = exp_table.exp<i_T>(uint32_t(max_values[i] - int32_t(in_ptr2[i])));
+                    acc_ptr[i] = value;
+                    recips[i] += value;
+                }
+            }
+
+            //The sum is at least 65536 (the max element) so the reciprocal keeps at least 16 significant bits
+            for(uint32_t i = 0; i < tile_size; ++i)
+                recips[i] = (uint64_t(1) << 48) / recips[i];
+            for(uint32_t c = 0; c < nb_channels; ++c)
+            {
+                o_T * const out_ptr2 = out_ptr1 + c * out_stride_C;
+                const uint32_t * const acc_ptr = accs.data() + c * SOFTMAX_TILE_SIZE;
+                for(uint32_t i = 0; i < tile_size; ++i)
+                    out_ptr2[i] = o_T(std::min<uint64_t>((acc_ptr[i] * recips[i] + norm_round) >> norm_shift, o_max));
+            }
+        }
+    }
+#else
+    std::vector<uint32_t> accs(nb_channels);
+    for(uint32_t batch = 0; batch < batch_end; ++batch)
+    {
+        for(uint32_t y = 0; y < y_end; ++y)
+        {
+            for(uint32_t x = 0; x < x_end; ++x)
+            {
+                const uint32_t in_offset = batch * in_stride_B + y * in_stride_H + x * in_stride_W;
+                const uint32_t out_offset = batch * out_stride_B + y * out_stride_H + x * out_stride_W;
+
+                //Find the maximum element, it is also what keeps exp arguments in the table range
+                int32_t max_value = in_ptr0[in_offset];
+                for(uint32_t c = 1; c < nb_channels; ++c)
+                    max_value = std::max<int32_t>(max_value, in_ptr0[in_offset + c * in_stride_C]);
+
+                uint64_t sum = 0;
+                for(uint32_t c = 0; c < nb_channels; ++c)
+                {
+                    const uint32_t value = exp_table.exp<i_T>(uint32_t(max_value - int32_t(in_ptr0[in_offset + c * in_stride_C])));
+                    accs[c] = value;
+                    sum += value;
+                }
+
+                //The sum is at least 65536 (the max element) so the reciprocal keeps at least 16 significant bits
+                const uint64_t recip = (uint64_t(1) << 48) / sum;
+                for(uint32_t c = 0; c < nb_channels; ++c)
+                    out_ptr0[out_offset + c * out_stride_C] = o_T(std::min<uint64_t>((accs[c] * recip + norm_round) >> norm_shift, o_max));
+            }
+        }
+    }
+#endif
+
+    return GIGA_Success;
+}
+
 template<GIGA_data_type i_GT, GIGA_data_type o_GT>
 GIGA_error _softmax_impl(const GIGA_softmax_t * params, const GIGA_tensor_t *in, GIGA_tensor_t *out)
 {
@@ -30,6 +208,10 @@ GIGA_error _softmax_impl(const GIGA_softmax_t * params, const GIGA_tensor_t *in,
             RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
     }
 
+    //Fixed point tensors never leave the integer domain
+    if constexpr (std::is_integral<i_T>::value && std::is_integral<o_T>::value)
+        return _softmax_fixed_impl<i_GT, o_GT>(in, out);
+
     //Didn't find an elegant way without making a disjunction of cases
     if(in->nb_dims == 1)
     {
@@ -106,7 +288,6 @@ GIGA_error _softmax_impl(const GIGA_softmax_t * params, const GIGA_tensor_t *in,
         //Typically the softmax will happen along the channels dimension for an image
         const uint32_t nb_elements = in->nb_dims == 3 ? in->dims[2] : in->dims[3]*in->dims[2];
 
-        std::vector<float> accs(in->dims[1]);
         const uint32_t batch_end = in->dims[0];
         const uint32_t in_i_end = in->dims[1];
         const uint32_t out_i_end = out->dims[1];
@@ -118,6 +299,66 @@ GIGA_error _softmax_impl(const GIGA_softmax_t * params, const GIGA_tensor_t *in,
         const uint32_t out_strideL = out->strides[out->nb_dims-1] / sizeof(o_T);
         const i_T * const in_ptr0 = get_cptr<i_T>(in);
         o_T * const out_ptr0 = get_ptr<o_T>(out);
+#ifdef ENABLE_OPTIMIZATION
+        // Assume in_strideL == 1 (and H, W contiguous)
+        // Assume out_strideL == 1 (and H, W contiguous)
+        // Channels are walked for a whole tile of pixels at once: each channel plane is read contiguously
+        // and the per pixel max and sum stay in registers/L1 instead of striding over full H x W planes.
+        const uint32_t nb_tiles = (nb_elements + SOFTMAX_TILE_SIZE - 1) / SOFTMAX_TILE_SIZE;
+        const uint32_t nb_jobs = batch_end * nb_tiles;
+#pragma omp parallel
+        {
+            std::vector<float> accs(SOFTMAX_TILE_SIZE * in_i_end);
+            float max_values[SOFTMAX_TILE_SIZE];
+            float sums[SOFTMAX_TILE_SIZE];
+
+#pragma omp for schedule(static)
+            for(uint32_t job = 0; job < nb_jobs; ++job)
+            {
+                const uint32_t batch = job / nb_tiles;
+                const uint32_t elt_begin = (job % nb_tiles) * SOFTMAX_TILE_SIZE;
+                const uint32_t tile_size = std::min<uint32_t>(SOFTMAX_TILE_SIZE, nb_elements - elt_begin);
+                const i_T * const in_ptr1 = in_ptr0 + batch * in_stride0 + elt_begin;
+                o_T * const out_ptr1 = out_ptr0 + batch * out_stride0 + elt_begin;
+
+                //Find the maximum element to ensure numerical stability
+                for(uint32_t i = 0; i < tile_size; ++i)
+                    max_values[i] = float(in_ptr1[i]);
+                for(uint32_t in_i = 1; in_i < in_i_end; ++in_i)
+                {
+                    const i_T * const in_ptr2 = in_ptr1 + in_i * in_stride1;
+                    for(uint32_t i = 0; i < tile_size; ++i)
+                        max_values[i] = std::max(max_values[i], float(in_ptr2[i]));
+                }
+
+                for(uint32_t i = 0; i < tile_size; ++i)
+                    sums[i] = 0.f;
+                for(uint32_t in_i = 0; in_i < in_i_end; ++in_i)
+                {
+                    const i_T * const in_ptr2 = in_ptr1 + in_i * in_stride1;
+                    float * const acc_ptr = accs.data() + in_i * SOFTMAX_TILE_SIZE;
+                    for(uint32_t i = 0; i < tile_size; ++i)
+                    {
+                        const float value = std::exp(float(in_ptr2[i]) - max_values[i]);
+                        acc_ptr[i] = value;
+                        sums[i] += value;
+                    }
+                }
+
+                //Divide by the sum to get the final softmax
+                for(uint32_t i = 0; i < tile_size; ++i)
+                    sums[i] = 1.f / sums[i];
+                for(uint32_t out_i = 0; out_i < out_i_end; ++out_i)
+                {
+                    o_T * const out_ptr2 = out_ptr1 + out_i * out_stride1;
+                    const float * const acc_ptr = accs.data() + out_i * SOFTMAX_TILE_SIZE;
+                    for(uint32_t i = 0; i < tile_size; ++i)
+                        out_ptr2[i] = o_T(acc_ptr[i] * sums[i]);
+                }
+            }
+        }
+#else
+        std::vector<float> accs(in->dims[1]);
         for(int32_t batch = 0; batch < batch_end; ++batch)
         {
             const uint32_t in_offset0 = batch * in_stride0;
@@ -152,6 +393,7 @@ GIGA_error _softmax_impl(const GIGA_softmax_t * params, const GIGA_tensor_t *in,
                 }
             }
         }
+#endif
     }
 
     return GIGA_Success;
@@ -162,6 +404,8 @@ GIGA_error giga_softmax_(const GIGA_softmax_t * params, const GIGA_tensor_t *in,
     if (!check_tensor_exists(in) || !check_tensor_exists(out))
         RETURN_ERROR(GIGA_Unknown_tensor);
 
+    run_on_memory_zone_node(out);
+
     GIGA_error ret;
 #ifdef ENABLE_OPTIMIZATION
     GIGA_CALL_TEMPLATED_FUNC_ON_2_TENSORS_SAME_TYPE(_softmax_impl, in->type, out->type, params, in, out)
@@ -9,13 +9,69 @@
 
 #include "giga_cpu.h"
 #include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+// Source taps of an output coordinate along one axis for bilinear interpolation
+struct Upsample_tap
+{
+    uint32_t i0;    // First source index
+    uint32_t i1;    // Second source index
+    float w;        // Weight of the second source index
+};
+
+static std::vector<Upsample_tap> _upsample_taps(const uint32_t in_size, const uint32_t out_size, const uint32_t factor, const GIGA_upsample_mode mode)
+{
+    std::vector<Upsample_tap> taps(out_size);
+    for(uint32_t o = 0; o < out_size; ++o)
+    {
+        //Half pixel centers by default, corners of input and output are aligned with GIGA_Upsample_Bilinear_Align_Corners
+        float src = mode == GIGA_Upsample_Bilinear_Align_Corners
+                    ? (out_size > 1 ? float(o) * float(in_size - 1) / float(out_size - 1) : 0.f)
+                    : (float(o) + 0.5f) / float(factor) - 0.5f;
+        src = std::max(src, 0.f);
+        const uint32_t i0 = std::min<uint32_t>(uint32_t(src), in_size - 1);
+        taps[o].i0 = i0;
+        taps[o].i1 = std::min<uint32_t>(i0 + 1, in_size - 1);
+        taps[o].w = i0 + 1 < in_size ? src - float(i0) : 0.f;
+    }
+    return taps;
+}
+
+// Interpolated values are rounded to the nearest integer for fixed point types
+template<typename T>
+inline T _interpolated_to_type(const float v)
+{
+    return T(std::floor(v + 0.5f));
+}
+
+template<>
+inline float _interpolated_to_type<float>(const float v)
+{
+    return v;
+}
+
+template<>
+inline half _interpolated_to_type<half>(const float v)
+{
+    return half(v);
+}
 
 template<GIGA_data_type i_GT>
 GIGA_error _giga_upsample_impl(const GIGA_upsample_t *params, const GIGA_tensor_t *in, GIGA_tensor_t *out)
 {
     typedef typename GIGA_C_Type<i_GT>::CType i_T;
 
-    if(params->factor != 2)         RETURN_ERROR(GIGA_Incorrect_Parameter);
+    typedef typename GIGA_Compute_Type<i_GT>::CType c_T;
+
+    const uint32_t factor = params->factor;
+    const GIGA_upsample_mode mode = params->mode;
+    if(factor == 0)                 RETURN_ERROR(GIGA_Incorrect_Parameter);
+    if(mode != GIGA_Upsample_Nearest
+       && mode != GIGA_Upsample_Bilinear
+       && mode != GIGA_Upsample_Bilinear_Align_Corners) RETURN_ERROR(GIGA_Incorrect_Parameter);
     if(in->nb_dims != out->nb_dims) RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
 
     if(in->nb_dims < 2) RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
@@ -68,45 +124,190 @@ GIGA_error _giga_upsample_impl(const GIGA_upsample_t *params, const GIGA_tensor_
     const uint32_t in_stride_W = in->strides[W_dim] / sizeof(i_T);
 
     //check dimensions
-    if(out->dims[H_dim] != in->dims[H_dim] * 2) RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
-    if(out->dims[W_dim] != in->dims[W_dim] * 2) RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    if(out->dims[H_dim] != in->dims[H_dim] * factor) RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+    if(out->dims[W_dim] != in->dims[W_dim] * factor) RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
 
-    //Actually perform upsampling
-    const uint32_t batch_end = nb_batch;
-#ifdef ENABLE_OPTIMIZATION
     const uint32_t in_y_end = in->dims[H_dim];
     const uint32_t in_x_end = in->dims[W_dim];
-    const uint32_t out_stride_H2 = out_stride_H * 2;
 
+    //The addend has the dimensions of the output, it may be the output itself
+    const GIGA_tensor_t * const addend = params->addend;
+    if(addend)
+    {
+        if(addend->type != in->type)            RETURN_ERROR(GIGA_Inconsistent_Tensor_Types);
+        if(addend->nb_dims != out->nb_dims)     RETURN_ERROR(GIGA_Inconsistent_Number_Of_Dimensions);
+        for(uint32_t i = 0; i < out->nb_dims; ++i)
+        {
+            if(addend->dims[i] != out->dims[i])
+                RETURN_ERROR(GIGA_Inconsistent_Tensor_Sizes);
+        }
+    }
+
+    const uint32_t addend_stride_B = addend && addend->nb_dims == 4 ? addend->strides[0] / sizeof(i_T) : 0;
+    const uint32_t addend_stride_C = addend && addend->nb_dims > 2 ? addend->strides[addend->nb_dims - 3] / sizeof(i_T) : 0;
+    const uint32_t addend_stride_H = addend ? addend->strides[H_dim] / sizeof(i_T) : 0;
+    const uint32_t addend_stride_W = addend ? addend->strides[W_dim] / sizeof(i_T) : 0;
+    const i_T * const addend_ptr0 = addend ? get_cptr<i_T>(addend) : nullptr;
+
+    //Computation of shifts in the fixed-point case, as in giga_add both terms are brought to the representation of the output
+    const int in_reshift = addend ? int(out->fp_shift) - int(in->fp_shift) : 0;
+    const int addend_reshift = addend ? int(out->fp_shift) - int(addend->fp_shift) : 0;
+
+    //Actually perform upsampling
+    const uint32_t batch_end = nb_batch;
+#ifdef ENABLE_OPTIMIZATION
     // Assume out_stride_W == 1
     // Assume in_stride_W == 1
+    // Assume addend_stride_W == 1
+
+    typedef Fixed_point_sum_type<i_T, c_T> v_T;
+    const bool b_sum_fits_32_bits = fixed_point_sum_fits_32_bits<i_T>(in_reshift, addend_reshift);
+    const Fixed_point_shift<v_T> in_shift(b_sum_fits_32_bits ? in_reshift : 0);
+    const Fixed_point_shift<v_T> addend_shift(b_sum_fits_32_bits ? addend_reshift : 0);
+    const Fixed_point_shift<c_T> in_wide_shift(in_reshift);
+    const Fixed_point_shift<c_T> addend_wide_shift(addend_reshift);
+    const auto accumulate = [=](const i_T value, const i_T addend_value)
+    {
+        return b_sum_fits_32_bits ? saturate_cast<i_T>(in_shift(v_T(value)) + addend_shift(v_T(addend_value)))
+                                  : saturate_cast<i_T>(in_wide_shift(c_T(value)) + addend_wide_shift(c_T(addend_value)));
+    };
+
+    if(mode == GIGA_Upsample_Nearest && addend)
+    {
+        //Each output element is written once, the upsampled tensor is never materialized: input rows are expanded along W
+        //in a per thread buffer, then added to the factor output rows that use them
+        const uint32_t nb_jobs = batch_end * nb_channels * in_y_end;
 #pragma omp parallel
-    for (uint32_t batch = 0 ; batch < batch_end ; ++batch)
+        {
+            std::vector<i_T> row(out_x_end);
+            i_T * const row_ptr = row.data();
+
+#pragma omp for schedule(static)
+            for (uint32_t job = 0 ; job < nb_jobs ; ++job)
+            {
+                const uint32_t in_y = job % in_y_end;
+                const uint32_t channel = (job / in_y_end) % nb_channels;
+                const uint32_t batch = job / (in_y_end * nb_channels);
+                const i_T * const in_ptr0 = get_cptr<i_T>(in) + batch * in_stride_B + channel * in_stride_C + in_y * in_stride_H;
+
+                for (uint32_t in_x = 0 ; in_x < in_x_end ; ++in_x)
+                {
+                    const i_T v = in_ptr0[in_x];
+                    for (uint32_t k = 0 ; k < factor ; ++k)
+                        row_ptr[in_x * factor + k] = v;
+                }
+
+                for (uint32_t k = 0 ; k < factor ; ++k)
+                {
+                    const uint32_t out_y = in_y * factor + k;
+                    i_T * const out_ptr0 = get_ptr<i_T>(out) + batch * out_stride_B + channel * out_stride_C + out_y * out_stride_H;
+                    const i_T * const addend_ptr1 = addend_ptr0 + batch * addend_stride_B + channel * addend_stride_C + out_y * addend_stride_H;
+                    for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+                        out_ptr0[out_x] = accumulate(row_ptr[out_x], addend_ptr1[out_x]);
+                }
+            }
+        }
+    }
+    else if(mode == GIGA_Upsample_Nearest)
     {
-        i_T * const out_ptr0 = get_ptr<i_T>(out) + batch * out_stride_B;
-        const i_T * const in_ptr0 = get_cptr<i_T>(in) + batch * in_stride_B;
-        for (uint32_t channel = 0; channel < nb_channels; ++channel)
+        const uint32_t nb_jobs = batch_end * nb_channels * in_y_end;
+#pragma omp parallel for schedule(static)
+        for (uint32_t job = 0 ; job < nb_jobs ; ++job)
+        {
+            const uint32_t in_y = job % in_y_end;
+            const uint32_t channel = (job / in_y_end) % nb_channels;
+            const uint32_t batch = job / (in_y_end * nb_channels);
+            i_T * const out_ptr0 = get_ptr<i_T>(out) + batch * out_stride_B + channel * out_stride_C + in_y * factor * out_stride_H;
+            const i_T * const in_ptr0 = get_cptr<i_T>(in) + batch * in_stride_B + channel * in_stride_C + in_y * in_stride_H;
+
+            //The first output row is expanded along W, the others are copies of it
+            if(factor == 2)
+            {
+                for (uint32_t in_x = 0 ; in_x < in_x_end ; ++in_x)
+                {
+                    const i_T v = in_ptr0[in_x];
+                    out_ptr0[2 * in_x] = v;
+                    out_ptr0[2 * in_x + 1] = v;
+                }
+            }
+            else
+            {
+                for (uint32_t in_x = 0 ; in_x < in_x_end ; ++in_x)
+                {
+                    const i_T v = in_ptr0[in_x];
+                    for (uint32_t k = 0 ; k < factor ; ++k)
+                        out_ptr0[in_x * factor + k] = v;
+                }
+            }
+            for (uint32_t k = 1 ; k < factor ; ++k)
+                std::copy_n(out_ptr0, out_x_end, out_ptr0 + k * out_stride_H);
+        }
+    }
+    else
+    {
+        const std::vector<Upsample_tap> y_taps = _upsample_taps(in_y_end, out_y_end, factor, mode);
+        const std::vector<Upsample_tap> x_taps = _upsample_taps(in_x_end, out_x_end, factor, mode);
+        const uint32_t nb_jobs = batch_end * nb_channels * out_y_end;
+
+        //Separable interpolation: input rows are interpolated along W once and reused by all output rows between them
+#pragma omp parallel
         {
-            i_T * const out_ptr1 = out_ptr0 + channel * out_stride_C;
-            const i_T * const in_ptr1 = in_ptr0 + channel * in_stride_C;
-#pragma omp for
-            for (uint32_t in_y = 0 ; in_y < in_y_end ; ++in_y)
+            std::vector<float> rows(2 * out_x_end);
+            float * const row0 = rows.data();
+            float * const row1 = row0 + out_x_end;
+            const i_T * row0_src = nullptr;
+            const i_T * row1_src = nullptr;
+
+#pragma omp for schedule(static)
+            for (uint32_t job = 0 ; job < nb_jobs ; ++job)
             {
-                i_T * out0_ptr2 = out_ptr1 + in_y * out_stride_H2;
-                i_T * out1_ptr2 = out0_ptr2 + out_stride_H;
-                const i_T * in_ptr2 = in_ptr1 + in_y * in_stride_H;
-                for (uint32_t in_x = 0 ; in_x < in_x_end ; ++in_x, out0_ptr2 += 2, out1_ptr2 += 2, ++in_ptr2)
+                const uint32_t out_y = job % out_y_end;
+                const uint32_t channel = (job / out_y_end) % nb_channels;
+                const uint32_t batch = job / (out_y_end * nb_channels);
+                const Upsample_tap y_tap = y_taps[out_y];
+                const i_T * const in_ptr0 = get_cptr<i_T>(in) + batch * in_stride_B + channel * in_stride_C;
+                const i_T * const src0 = in_ptr0 + y_tap.i0 * in_stride_H;
+                const i_T * const src1 = in_ptr0 + y_tap.i1 * in_stride_H;
+
+                if(src0 != row0_src)
+                {
+                    for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+                    {
+                        const Upsample_tap &x_tap = x_taps[out_x];
+                        row0[out_x] = float(src0[x_tap.i0]) * (1.f - x_tap.w) + float(src0[x_tap.i1]) * x_tap.w;
+                    }
+                    row0_src = src0;
+                }
+                if(src1 != row1_src)
                 {
-                    const i_T v = *in_ptr2;
-                    out0_ptr2[0] = v;
-                    out0_ptr2[1] = v;
-                    out1_ptr2[0] = v;
-                    out1_ptr2[1] = v;
+                    for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+                    {
+                        const Upsample_tap &x_tap = x_taps[out_x];
+                        row1[out_x] = float(src1[x_tap.i0]) * (1.f - x_tap.w) + float(src1[x_tap.i1]) * x_tap.w;
+                    }
+                    row1_src = src1;
+                }
+
+                i_T * const out_ptr1 = get_ptr<i_T>(out) + batch * out_stride_B + channel * out_stride_C + out_y * out_stride_H;
+                const float wy = y_tap.w;
+                if(addend)
+                {
+                    const i_T * const addend_ptr1 = addend_ptr0 + batch * addend_stride_B + channel * addend_stride_C + out_y * addend_stride_H;
+                    for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+                        out_ptr1[out_x] = accumulate(_interpolated_to_type<i_T>(row0[out_x] * (1.f - wy) + row1[out_x] * wy), addend_ptr1[out_x]);
+                }
+                else
+                {
+                    for (uint32_t out_x = 0 ; out_x < out_x_end ; ++out_x)
+                        out_ptr1[out_x] = _interpolated_to_type<i_T>(row0[out_x] * (1.f - wy) + row1[out_x] * wy);
                 }
             }
         }
     }
 #else
+    const std::vector<Upsample_tap> y_taps = _upsample_taps(in_y_end, out_y_end, factor, mode);
+    const std::vector<Upsample_tap> x_taps = _upsample_taps(in_x_end, out_x_end, factor, mode);
+
     for (uint32_t batch = 0 ; batch < batch_end ; ++batch)
     {
         for (uint32_t channel = 0; channel < nb_channels; ++channel)
@@ -119,14 +320,32 @@ GIGA_error _giga_upsample_impl(const GIGA_upsample_t *params, const GIGA_tensor_
 
                     i_T * const out_ptr = get_ptr<i_T>(out) + out_offset;
 
-                    const uint32_t in_offset = batch * in_stride_B
-                                               + channel * in_stride_C
-                                               + (out_y / 2) * in_stride_H
-                                               + (out_x / 2) * in_stride_W;
+                    const i_T * const in_ptr = get_cptr<i_T>(in) + batch * in_stride_B + channel * in_stride_C;
 
-                    const i_T * const in_ptr = get_cptr<i_T>(in) + in_offset;
+                    i_T value;
+                    if(mode == GIGA_Upsample_Nearest)
+                    {
+                        value = i_T(in_ptr[(out_y / factor) * in_stride_H + (out_x / factor) * in_stride_W]);
+                    }
+                    else
+                    {
+                        const Upsample_tap &y_tap = y_taps[out_y];
+                        const Upsample_tap &x_tap = x_taps[out_x];
+                        const float v00 = float(in_ptr[y_tap.i0 * in_stride_H + x_tap.i0 * in_stride_W]);
+                        const float v01 = float(in_ptr[y_tap.i0 * in_stride_H + x_tap.i1 * in_stride_W]);
+                        const float v10 = float(in_ptr[y_tap.i1 * in_stride_H + x_tap.i0 * in_stride_W]);
+                        const float v11 = float(in_ptr[y_tap.i1 * in_stride_H + x_tap.i1 * in_stride_W]);
+                        const float v0 = v00 * (1.f - x_tap.w) + v01 * x_tap.w;
+                        const float v1 = v10 * (1.f - x_tap.w) + v11 * x_tap.w;
+                        value = _interpolated_to_type<i_T>(v0 * (1.f - y_tap.w) + v1 * y_tap.w);
+                    }
 
-                    *out_ptr = i_T(*in_ptr);
+                    if(addend)
+                    {
+                        const i_T addend_value = addend_ptr0[batch * addend_stride_B + channel * addend_stride_C + out_y * addend_stride_H + out_x * addend_stride_W];
+                        value = saturate_cast<i_T>(shift(c_T(value), in_reshift) + shift(c_T(addend_value), addend_reshift));
+                    }
+                    *out_ptr = value;
                 }
             }
         }
@@ -140,6 +359,11 @@ GIGA_error giga_upsample_(const GIGA_upsample_t *params, const GIGA_tensor_t *in
     if (!check_tensor_exists(in) || !check_tensor_exists(out))
         RETURN_ERROR(GIGA_Unknown_tensor);
 
+    if (params->addend && !check_tensor_exists(params->addend))
+        RETURN_ERROR(GIGA_Unknown_tensor);
+
+    run_on_memory_zone_node(out);
+
     GIGA_error ret;
     GIGA_CALL_TEMPLATED_FUNC_ON_TENSOR(_giga_upsample_impl, in->type, params, in, out)
 
@@ -11,6 +11,11 @@
 #define GIGA_CPU_UTILS_H_9c68eb97c15ee38145df875a89b2ccbd
 
 #include <giga/float16.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
 
 template<typename T>
 inline T shift(T value, int shift)
@@ -38,6 +43,111 @@ inline half shift<half>(half value, int shift)
     return value;
 }
 
+// Converts a computed value to a storage type, saturating for fixed point types
+template<typename T, typename V>
+inline T saturate_cast(V value)
+{
+    return T(std::min<V>(std::max<V>(value, V(std::numeric_limits<T>::min())), V(std::numeric_limits<T>::max())));
+}
+
+template<>
+inline float saturate_cast<float, float>(float value)
+{
+    return value;
+}
+
+template<>
+inline half saturate_cast<half, float>(float value)
+{
+    return value;
+}
+
+// Same as shift() with the shift known in advance: written as a multiplication and an arithmetic right shift so that loops using it vectorize
+template<typename T>
+struct Fixed_point_shift
+{
+    inline Fixed_point_shift(int shift) : mul(shift > 0 ? T(1) << shift : T(1)), rshift(shift < 0 ? -shift : 0)  {}
+
+    inline T operator()(T value) const
+    {
+        return (value * mul) >> rshift;
+    }
+
+    T mul;
+    int rshift;
+};
+
+template<>
+struct Fixed_point_shift<float>
+{
+    inline Fixed_point_shift(int shift)  {}
+
+    inline float operator()(float value) const
+    {
+        return value;
+    }
+};
+
+// Type in which the optimized kernels add or multiply fixed point values of type T: 8 bits values are computed in 32 bits, which
+// vectorizes better, when fixed_point_sum_fits_32_bits (or fixed_point_product_fits_32_bits) holds, other values in the compute type c_T
+template<typename T, typename c_T>
+using Fixed_point_sum_type = typename std::conditional<std::is_integral<c_T>::value && sizeof(T) == 1, int32_t, c_T>::type;
+
+// 8 bits values shifted by at most 22 bits stay below 2^30, so the sum of two of them cannot overflow 32 bits
+template<typename T>
+inline bool fixed_point_sum_fits_32_bits(int shift0, int shift1)
+{
+    return std::is_integral<T>::value && sizeof(T) == 1 && std::abs(shift0) <= 22 && std::abs(shift1) <= 22;
+}
+
+// Products of two 8 bits values stay below 2^16, shifted by at most 14 bits they cannot overflow 32 bits
+template<typename T>
+inline bool fixed_point_product_fits_32_bits(int shift)
+{
+    return std::is_integral<T>::value && sizeof(T) == 1 && std::abs(shift) <= 14;
+}
+
+// Rounded average of sum / count written in the output representation, out_shift being the difference of fp_shift between output and input
+template<typename i_T, typename a_T>
+inline i_T pool_average(const a_T sum, const uint32_t count, const int out_shift)
+{
+    const a_T num = out_shift > 0 ? sum * (a_T(1) << out_shift) : sum;
+    const a_T den = out_shift < 0 ? a_T(count) << -out_shift : a_T(count);
+    //Round half away from zero
+    const a_T q = num >= 0 ? (num + den / 2) / den : -((-num + den / 2) / den);
+    return saturate_cast<i_T>(q);
+}
+
+template<>
+inline float pool_average<float, float>(const float sum, const uint32_t count, const int out_shift)
+{
+    return sum / float(count);
+}
+
+template<>
+inline half pool_average<half, float>(const float sum, const uint32_t count, const int out_shift)
+{
+    return half(sum / float(count));
+}
+
+template<typename i_T, typename a_T>
+inline i_T pool_max(const a_T max, const int out_shift)
+{
+    return saturate_cast<i_T>(shift(max, out_shift));
+}
+
+template<>
+inline float pool_max<float, float>(const float max, const int out_shift)
+{
+    return max;
+}
+
+template<>
+inline half pool_max<half, float>(const float max, const int out_shift)
+{
+    return half(max);
+}
+
 // Simple case with a single type
 #define GIGA_TYPE_TEMPLATED_CASE(func, type, ...) \
 case type:\